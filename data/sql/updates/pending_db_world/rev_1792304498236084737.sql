@@ -0,0 +1,5 @@
+--
+DELETE FROM `command` WHERE `name` IN ('debug opcodes', 'debug opcodes reset');
+INSERT INTO `command` (`name`, `security`, `help`) VALUES
+('debug opcodes', 3, 'Syntax: .debug opcodes [$count] [total|max|avg|count|bytes]\nLists the client opcode handlers that took the most time since the last reset. Shows 10 opcodes ordered by total time by default.'),
+('debug opcodes reset', 3, 'Syntax: .debug opcodes reset\nResets the statistics shown by .debug opcodes.');
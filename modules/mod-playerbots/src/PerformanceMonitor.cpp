@@ -7,49 +7,250 @@
 
 #include "Playerbots.h"
 
-PerformanceMonitorOperation* PerformanceMonitor::start(PerformanceMetric metric, std::string const name,
-                                                       PerformanceStack* stack)
+uint32 PerformanceHistogram::GetBucket(uint64 time)
 {
-    if (!sPlayerbotAIConfig->perfMonEnabled)
-        return nullptr;
+    time = std::min(time, MAX_TIME);
+    if (time < SUB_BUCKETS)
+        return time;
 
-    std::string stackName = name;
+    uint32 shift = 63 - __builtin_clzll(time) - SUB_BUCKET_BITS;
+    return SUB_BUCKETS + shift * SUB_BUCKETS + uint32(time >> shift) - SUB_BUCKETS;
+}
+
+uint64 PerformanceHistogram::GetBucketTime(uint32 bucket)
+{
+    if (bucket < SUB_BUCKETS)
+        return bucket;
+
+    uint32 shift = (bucket - SUB_BUCKETS) / SUB_BUCKETS;
+    uint64 sub = (bucket - SUB_BUCKETS) % SUB_BUCKETS + SUB_BUCKETS;
+    return ((sub + 1) << shift) - 1;
+}
 
+// Histograms sit in the ThreadData of the thread that measures and only that thread adds to them.
+// Collect() merges them from the thread printing the report, they are never freed so that the report
+// still contains threads that finished.
+void PerformanceHistogram::Add(uint64 time)
+{
+    uint64 minT = minTime.load(std::memory_order_relaxed);
+    if (time > 0)
+    {
+        if (!minT || minT > time)
+            minTime.store(time, std::memory_order_relaxed);
+
+        if (maxTime.load(std::memory_order_relaxed) < time)
+            maxTime.store(time, std::memory_order_relaxed);
+
+        totalTime.store(totalTime.load(std::memory_order_relaxed) + time, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint32>& bucket = buckets[GetBucket(time)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void PerformanceHistogram::Clear()
+{
+    count.store(0, std::memory_order_relaxed);
+    totalTime.store(0, std::memory_order_relaxed);
+    minTime.store(0, std::memory_order_relaxed);
+    maxTime.store(0, std::memory_order_relaxed);
+    for (std::atomic<uint32>& bucket : buckets)
+        bucket.store(0, std::memory_order_relaxed);
+}
+
+void PerformanceData::Merge(PerformanceHistogram const& histogram)
+{
+    uint64 histogramCount = histogram.count.load(std::memory_order_relaxed);
+    if (!histogramCount)
+        return;
+
+    uint64 histogramMin = histogram.minTime.load(std::memory_order_relaxed);
+    if (histogramMin && (!minTime || minTime > histogramMin))
+        minTime = histogramMin;
+
+    maxTime = std::max(maxTime, histogram.maxTime.load(std::memory_order_relaxed));
+    totalTime += histogram.totalTime.load(std::memory_order_relaxed);
+    count += histogramCount;
+
+    for (uint32 i = 0; i < PerformanceHistogram::BUCKET_COUNT; ++i)
+        buckets[i] += histogram.buckets[i].load(std::memory_order_relaxed);
+}
+
+void PerformanceData::Merge(PerformanceData const& other)
+{
+    if (!other.count)
+        return;
+
+    if (other.minTime && (!minTime || minTime > other.minTime))
+        minTime = other.minTime;
+
+    maxTime = std::max(maxTime, other.maxTime);
+    totalTime += other.totalTime;
+    count += other.count;
+
+    for (uint32 i = 0; i < PerformanceHistogram::BUCKET_COUNT; ++i)
+        buckets[i] += other.buckets[i];
+}
+
+uint64 PerformanceData::GetPercentile(float percentile) const
+{
+    uint64 total = 0;
+    for (uint64 bucketCount : buckets)
+        total += bucketCount;
+
+    if (!total)
+        return 0;
+
+    uint64 rank = std::max<uint64>(1, uint64(std::ceil(total * percentile / 100.0f)));
+    uint64 seen = 0;
+    for (uint32 i = 0; i < PerformanceHistogram::BUCKET_COUNT; ++i)
+    {
+        seen += buckets[i];
+        if (seen >= rank)
+            return std::min(PerformanceHistogram::GetBucketTime(i), maxTime);
+    }
+
+    return maxTime;
+}
+
+PerformanceMonitor::ThreadData& PerformanceMonitor::GetThreadData()
+{
+    // The monitor keeps a reference so a finished thread still counts in the report
+    thread_local std::shared_ptr<ThreadData> threadData;
+    if (!threadData)
+    {
+        threadData = std::make_shared<ThreadData>();
+        threadData->resetCount = resetCount.load(std::memory_order_acquire);
+
+        std::lock_guard<std::mutex> guard(lock);
+        threads.push_back(threadData);
+    }
+
+    return *threadData;
+}
+
+uint32 PerformanceMonitor::GetId(ThreadData& thread, PerformanceMetric metric, std::string const& name,
+                                 PerformanceStack* stack)
+{
+    // Identify metric, name and stack by hash first so the stack name is only built the first time a thread sees it
+    uint64 hash = std::hash<std::string>()(name) ^ (uint64(metric) + 0x9e3779b97f4a7c15ULL);
     if (stack)
+        for (std::vector<std::string>::reverse_iterator i = stack->rbegin(); i != stack->rend(); ++i)
+            hash ^= std::hash<std::string>()(*i) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+
+    auto [begin, end] = thread.ids.equal_range(hash);
+    for (auto itr = begin; itr != end; ++itr)
     {
-        if (!stack->empty())
-        {
-            std::ostringstream out;
-            out << stackName << " [";
+        CachedId const& cached = itr->second;
+        if (cached.metric == metric && cached.name == name &&
+            (stack ? cached.stack == *stack : cached.stack.empty()))
+            return cached.id;
+    }
 
-            for (std::vector<std::string>::reverse_iterator i = stack->rbegin(); i != stack->rend(); ++i)
-                out << *i << (std::next(i) == stack->rend() ? "" : "|");
+    std::string stackName = name;
 
-            out << "]";
+    if (stack && !stack->empty())
+    {
+        std::ostringstream out;
+        out << stackName << " [";
 
-            stackName = out.str().c_str();
-        }
+        for (std::vector<std::string>::reverse_iterator i = stack->rbegin(); i != stack->rend(); ++i)
+            out << *i << (std::next(i) == stack->rend() ? "" : "|");
 
-        stack->push_back(name);
+        out << "]";
+
+        stackName = out.str().c_str();
+    }
+
+    uint32 id = Intern(metric, stackName);
+    thread.ids.emplace(hash, CachedId{metric, name, stack ? *stack : PerformanceStack(), id});
+    return id;
+}
+
+uint32 PerformanceMonitor::Intern(PerformanceMetric metric, std::string const& stackName)
+{
+    std::string key = std::to_string(metric) + ":" + stackName;
+
+    std::lock_guard<std::mutex> guard(lock);
+    auto itr = entryIds.find(key);
+    if (itr != entryIds.end())
+        return itr->second;
+
+    uint32 id = entries.size();
+    entries.push_back({metric, stackName});
+    entryIds[key] = id;
+    return id;
+}
+
+void PerformanceMonitor::Record(uint32 id, uint64 time)
+{
+    ThreadData& thread = GetThreadData();
+
+    // Reset only raises the counter, every thread clears its own histograms the next time it measures
+    uint32 currentReset = resetCount.load(std::memory_order_acquire);
+    if (thread.resetCount != currentReset)
+    {
+        for (auto& histogram : thread.histograms)
+            if (histogram)
+                histogram->Clear();
+
+        thread.resetCount = currentReset;
+    }
+
+    if (id >= thread.histograms.size() || !thread.histograms[id])
+    {
+        std::lock_guard<std::mutex> guard(thread.lock);
+        if (id >= thread.histograms.size())
+            thread.histograms.resize(id + 1);
+
+        thread.histograms[id] = std::make_unique<PerformanceHistogram>();
     }
 
+    thread.histograms[id]->Add(time);
+}
+
+std::map<PerformanceMetric, std::map<std::string, PerformanceData>> PerformanceMonitor::Collect()
+{
+    std::map<PerformanceMetric, std::map<std::string, PerformanceData>> data;
+
     std::lock_guard<std::mutex> guard(lock);
-    PerformanceData* pd = data[metric][stackName];
-    if (!pd)
+    uint32 currentReset = resetCount.load(std::memory_order_acquire);
+
+    for (auto const& thread : threads)
     {
-        pd = new PerformanceData();
-        pd->minTime = 0;
-        pd->maxTime = 0;
-        pd->totalTime = 0;
-        pd->count = 0;
-        data[metric][stackName] = pd;
+        std::lock_guard<std::mutex> threadGuard(thread->lock);
+
+        // Not measured anything since the last reset, everything it holds is from before
+        if (thread->resetCount != currentReset)
+            continue;
+
+        for (uint32 id = 0; id < thread->histograms.size() && id < entries.size(); ++id)
+            if (thread->histograms[id])
+                data[entries[id].metric][entries[id].name].Merge(*thread->histograms[id]);
     }
 
-    return new PerformanceMonitorOperation(pd, name, stack);
+    return data;
+}
+
+PerformanceMonitorOperation PerformanceMonitor::start(PerformanceMetric metric, std::string const& name,
+                                                      PerformanceStack* stack)
+{
+    if (!sPlayerbotAIConfig->perfMonEnabled)
+        return PerformanceMonitorOperation();
+
+    uint32 id = GetId(GetThreadData(), metric, name, stack);
+    PerformanceMonitorOperation operation(id, stack);
+
+    if (stack)
+        stack->push_back(name);
+
+    return operation;
 }
 
 void PerformanceMonitor::PrintStats(bool perTick, bool fullStack)
 {
+    std::map<PerformanceMetric, std::map<std::string, PerformanceData>> data = Collect();
     if (data.empty())
         return;
 
@@ -58,21 +259,20 @@ void PerformanceMonitor::PrintStats(bool perTick, bool fullStack)
         float updateAITotalTime = 0;
         for (auto& map : data[PERF_MON_TOTAL])
             if (map.first.find("PlayerbotAI::UpdateAIInternal") != std::string::npos)
-                updateAITotalTime += map.second->totalTime;
+                updateAITotalTime += map.second.totalTime;
 
         LOG_INFO(
             "playerbots",
             "--------------------------------------[TOTAL BOT]------------------------------------------------------");
         LOG_INFO("playerbots",
-                 "percentage     time  |     min ..     max (      avg  of      count) - type      : name");
+                 "percentage     time  |     min ..     max (      avg  of      count) |     p50     p99 - type      : name");
         LOG_INFO(
             "playerbots",
             "-------------------------------------------------------------------------------------------------------");
 
-        for (std::map<PerformanceMetric, std::map<std::string, PerformanceData*>>::iterator i = data.begin();
-             i != data.end(); ++i)
+        for (auto i = data.begin(); i != data.end(); ++i)
         {
-            std::map<std::string, PerformanceData*> pdMap = i->second;
+            std::map<std::string, PerformanceData> const& pdMap = i->second;
 
             std::string key;
             switch (i->first)
@@ -99,7 +299,7 @@ void PerformanceMonitor::PrintStats(bool perTick, bool fullStack)
 
             std::vector<std::string> names;
 
-            for (std::map<std::string, PerformanceData*>::iterator j = pdMap.begin(); j != pdMap.end(); ++j)
+            for (auto j = pdMap.begin(); j != pdMap.end(); ++j)
             {
                 if (key == "Total" && j->first.find("PlayerbotAI::UpdateAIInternal") == std::string::npos)
                     continue;
@@ -108,22 +308,16 @@ void PerformanceMonitor::PrintStats(bool perTick, bool fullStack)
             }
 
             std::sort(names.begin(), names.end(),
-                      [pdMap](std::string const i, std::string const j)
-                      { return pdMap.at(i)->totalTime < pdMap.at(j)->totalTime; });
+                      [&pdMap](std::string const& i, std::string const& j)
+                      { return pdMap.at(i).totalTime < pdMap.at(j).totalTime; });
 
-            uint64 typeTotalTime = 0;
-            uint64 typeMinTime = 0xffffffffu;
-            uint64 typeMaxTime = 0;
-            uint32 typeCount = 0;
+            PerformanceData typeData;
             for (auto& name : names)
             {
-                PerformanceData* pd = pdMap[name];
-                typeTotalTime += pd->totalTime;
-                typeCount += pd->count;
-                if (typeMinTime > pd->minTime)
-                    typeMinTime = pd->minTime;
-                if (typeMaxTime < pd->maxTime)
-                    typeMaxTime = pd->maxTime;
+                PerformanceData const* pd = &pdMap.at(name);
+                typeData.Merge(*pd);
+                float p50 = (float)pd->GetPercentile(50.0f) / 1000.0f;
+                float p99 = (float)pd->GetPercentile(99.0f) / 1000.0f;
                 float perc = (float)pd->totalTime / updateAITotalTime * 100.0f;
                 float time = (float)pd->totalTime / 1000000.0f;
                 float minTime = (float)pd->minTime / 1000.0f;
@@ -136,38 +330,43 @@ void PerformanceMonitor::PrintStats(bool perTick, bool fullStack)
                 if (perc >= 0.1f || avg >= 0.25f || pd->maxTime > 1000)
                 {
                     LOG_INFO("playerbots",
-                             "{:7.3f}% {:10.3f}s | {:7.1f} .. {:7.1f} ({:10.3f} of {:10d}) - {:6}    : {}", perc, time,
-                             minTime, maxTime, avg, pd->count, key.c_str(), disName.c_str());
+                             "{:7.3f}% {:10.3f}s | {:7.1f} .. {:7.1f} ({:10.3f} of {:10d}) | {:7.1f} {:7.1f} - {:6}    : {}",
+                             perc, time, minTime, maxTime, avg, pd->count, p50, p99, key.c_str(), disName.c_str());
                 }
             }
-            float tPerc = (float)typeTotalTime / (float)updateAITotalTime * 100.0f;
-            float tTime = (float)typeTotalTime / 1000000.0f;
-            float tMinTime = (float)typeMinTime / 1000.0f;
-            float tMaxTime = (float)typeMaxTime / 1000.0f;
-            float tAvg = (float)typeTotalTime / (float)typeCount / 1000.0f;
-            LOG_INFO("playerbots", "{:7.3f}% {:10.3f}s | {:7.1f} .. {:7.1f} ({:10.3f} of {:10d}) - {:6}    : {}", tPerc,
-                     tTime, tMinTime, tMaxTime, tAvg, typeCount, key.c_str(), "Total");
+            float tPerc = (float)typeData.totalTime / (float)updateAITotalTime * 100.0f;
+            float tTime = (float)typeData.totalTime / 1000000.0f;
+            float tMinTime = (float)typeData.minTime / 1000.0f;
+            float tMaxTime = (float)typeData.maxTime / 1000.0f;
+            float tAvg = (float)typeData.totalTime / (float)typeData.count / 1000.0f;
+            float tP50 = (float)typeData.GetPercentile(50.0f) / 1000.0f;
+            float tP99 = (float)typeData.GetPercentile(99.0f) / 1000.0f;
+            LOG_INFO("playerbots", "{:7.3f}% {:10.3f}s | {:7.1f} .. {:7.1f} ({:10.3f} of {:10d}) | {:7.1f} {:7.1f} - {:6}    : {}",
+                     tPerc, tTime, tMinTime, tMaxTime, tAvg, typeData.count, tP50, tP99, key.c_str(), "Total");
             LOG_INFO("playerbots", " ");
         }
     }
     else
     {
-        float fullTickCount = data[PERF_MON_TOTAL]["PlayerbotAIBase::FullTick"]->count;
-        float fullTickTotalTime = data[PERF_MON_TOTAL]["PlayerbotAIBase::FullTick"]->totalTime;
+        PerformanceData const& fullTick = data[PERF_MON_TOTAL]["PlayerbotAIBase::FullTick"];
+        if (!fullTick.count)
+            return;
+
+        float fullTickCount = fullTick.count;
+        float fullTickTotalTime = fullTick.totalTime;
 
         LOG_INFO(
             "playerbots",
             "---------------------------------------[PER TICK]------------------------------------------------------");
         LOG_INFO("playerbots",
-                 "percentage     time  |     min ..     max (      avg  of      count) - type      : name");
+                 "percentage     time  |     min ..     max (      avg  of      count) |     p50     p99 - type      : name");
         LOG_INFO(
             "playerbots",
             "-------------------------------------------------------------------------------------------------------");
 
-        for (std::map<PerformanceMetric, std::map<std::string, PerformanceData*>>::iterator i = data.begin();
-             i != data.end(); ++i)
+        for (auto i = data.begin(); i != data.end(); ++i)
         {
-            std::map<std::string, PerformanceData*> pdMap = i->second;
+            std::map<std::string, PerformanceData> const& pdMap = i->second;
 
             std::string key;
             switch (i->first)
@@ -193,28 +392,22 @@ void PerformanceMonitor::PrintStats(bool perTick, bool fullStack)
 
             std::vector<std::string> names;
 
-            for (std::map<std::string, PerformanceData*>::iterator j = pdMap.begin(); j != pdMap.end(); ++j)
+            for (auto j = pdMap.begin(); j != pdMap.end(); ++j)
             {
                 names.push_back(j->first);
             }
 
             std::sort(names.begin(), names.end(),
-                      [pdMap](std::string const i, std::string const j)
-                      { return pdMap.at(i)->totalTime < pdMap.at(j)->totalTime; });
+                      [&pdMap](std::string const& i, std::string const& j)
+                      { return pdMap.at(i).totalTime < pdMap.at(j).totalTime; });
 
-            uint64 typeTotalTime = 0;
-            uint64 typeMinTime = 0xffffffffu;
-            uint64 typeMaxTime = 0;
-            uint32 typeCount = 0;
+            PerformanceData typeData;
             for (auto& name : names)
             {
-                PerformanceData* pd = pdMap[name];
-                typeTotalTime += pd->totalTime;
-                typeCount += pd->count;
-                if (typeMinTime > pd->minTime)
-                    typeMinTime = pd->minTime;
-                if (typeMaxTime < pd->maxTime)
-                    typeMaxTime = pd->maxTime;
+                PerformanceData const* pd = &pdMap.at(name);
+                typeData.Merge(*pd);
+                float p50 = (float)pd->GetPercentile(50.0f) / 1000.0f;
+                float p99 = (float)pd->GetPercentile(99.0f) / 1000.0f;
                 float perc = (float)pd->totalTime / fullTickTotalTime * 100.0f;
                 float time = (float)pd->totalTime / fullTickCount / 1000.0f;
                 float minTime = (float)pd->minTime / 1000.0f;
@@ -227,20 +420,22 @@ void PerformanceMonitor::PrintStats(bool perTick, bool fullStack)
                 if (perc >= 0.1f || avg >= 0.25f || pd->maxTime > 1000)
                 {
                     LOG_INFO("playerbots",
-                             "{:7.3f}% {:9.3f}ms | {:7.1f} .. {:7.1f} ({:10.3f} of {:10.2f}) - {:6}    : {}", perc,
-                             time, minTime, maxTime, avg, amount, key.c_str(), disName.c_str());
+                             "{:7.3f}% {:9.3f}ms | {:7.1f} .. {:7.1f} ({:10.3f} of {:10.2f}) | {:7.1f} {:7.1f} - {:6}    : {}",
+                             perc, time, minTime, maxTime, avg, amount, p50, p99, key.c_str(), disName.c_str());
                 }
             }
             if (i->first != PERF_MON_TOTAL)
             {
-                float tPerc = (float)typeTotalTime / (float)fullTickTotalTime * 100.0f;
-                float tTime = (float)typeTotalTime / fullTickCount / 1000.0f;
-                float tMinTime = (float)typeMinTime / 1000.0f;
-                float tMaxTime = (float)typeMaxTime / 1000.0f;
-                float tAvg = (float)typeTotalTime / (float)typeCount / 1000.0f;
-                float tAmount = (float)typeCount / fullTickCount;
-                LOG_INFO("playerbots", "{:7.3f}% {:9.3f}ms | {:7.1f} .. {:7.1f} ({:10.3f} of {:10.2f}) - {:6}    : {}",
-                         tPerc, tTime, tMinTime, tMaxTime, tAvg, tAmount, key.c_str(), "Total");
+                float tPerc = (float)typeData.totalTime / (float)fullTickTotalTime * 100.0f;
+                float tTime = (float)typeData.totalTime / fullTickCount / 1000.0f;
+                float tMinTime = (float)typeData.minTime / 1000.0f;
+                float tMaxTime = (float)typeData.maxTime / 1000.0f;
+                float tAvg = (float)typeData.totalTime / (float)typeData.count / 1000.0f;
+                float tAmount = (float)typeData.count / fullTickCount;
+                float tP50 = (float)typeData.GetPercentile(50.0f) / 1000.0f;
+                float tP99 = (float)typeData.GetPercentile(99.0f) / 1000.0f;
+                LOG_INFO("playerbots", "{:7.3f}% {:9.3f}ms | {:7.1f} .. {:7.1f} ({:10.3f} of {:10.2f}) | {:7.1f} {:7.1f} - {:6}    : {}",
+                         tPerc, tTime, tMinTime, tMaxTime, tAvg, tAmount, tP50, tP99, key.c_str(), "Total");
             }
             LOG_INFO("playerbots", " ");
         }
@@ -249,55 +444,38 @@ void PerformanceMonitor::PrintStats(bool perTick, bool fullStack)
 
 void PerformanceMonitor::Reset()
 {
-    for (std::map<PerformanceMetric, std::map<std::string, PerformanceData*>>::iterator i = data.begin();
-         i != data.end(); ++i)
-    {
-        std::map<std::string, PerformanceData*> pdMap = i->second;
-        for (std::map<std::string, PerformanceData*>::iterator j = pdMap.begin(); j != pdMap.end(); ++j)
-        {
-            PerformanceData* pd = j->second;
-            std::lock_guard<std::mutex> guard(pd->lock);
-            pd->minTime = 0;
-            pd->maxTime = 0;
-            pd->totalTime = 0;
-            pd->count = 0;
-        }
-    }
+    resetCount.fetch_add(1, std::memory_order_acq_rel);
 }
 
-PerformanceMonitorOperation::PerformanceMonitorOperation(PerformanceData* data, std::string const name,
-                                                         PerformanceStack* stack)
-    : data(data), name(name), stack(stack)
+PerformanceMonitorOperation::PerformanceMonitorOperation(uint32 id, PerformanceStack* stack)
+    : active(true), id(id), stack(stack), stackDepth(stack ? stack->size() : 0), started(std::chrono::steady_clock::now())
 {
-    started = (std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now()))
-                  .time_since_epoch();
 }
 
-void PerformanceMonitorOperation::finish()
+PerformanceMonitorOperation& PerformanceMonitorOperation::operator=(PerformanceMonitorOperation&& other) noexcept
 {
-    std::chrono::microseconds finished =
-        (std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now()))
-            .time_since_epoch();
-    uint64 elapsed = (finished - started).count();
-
-    std::lock_guard<std::mutex> guard(data->lock);
-    if (elapsed > 0)
-    {
-        if (!data->minTime || data->minTime > elapsed)
-            data->minTime = elapsed;
+    active = other.active;
+    id = other.id;
+    stack = other.stack;
+    stackDepth = other.stackDepth;
+    started = other.started;
+    other.active = false;
+    return *this;
+}
 
-        if (!data->maxTime || data->maxTime < elapsed)
-            data->maxTime = elapsed;
+void PerformanceMonitorOperation::finish()
+{
+    if (!active)
+        return;
 
-        data->totalTime += elapsed;
-    }
+    active = false;
 
-    ++data->count;
+    uint64 elapsed =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started).count();
 
-    if (stack)
-    {
-        stack->erase(std::remove(stack->begin(), stack->end(), name), stack->end());
-    }
+    sPerformanceMonitor->Record(id, elapsed);
 
-    delete this;
+    // Operations nest, dropping everything from our own name on also drops what an unfinished inner one left
+    if (stack && stack->size() > stackDepth)
+        stack->resize(stackDepth);
 }
@@ -6,25 +6,20 @@
 #ifndef _PLAYERBOT_PERFORMANCEMONITOR_H
 #define _PLAYERBOT_PERFORMANCEMONITOR_H
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <ctime>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include "Common.h"
 
 typedef std::vector<std::string> PerformanceStack;
 
-struct PerformanceData
-{
-    uint64 minTime;
-    uint64 maxTime;
-    uint64 totalTime;
-    uint32 count;
-    std::mutex lock;
-};
-
 enum PerformanceMetric
 {
     PERF_MON_TRIGGER,
@@ -34,17 +29,63 @@ enum PerformanceMetric
     PERF_MON_TOTAL
 };
 
+// Log-linear latency histogram in microseconds: 8 buckets per power of two, about 12% relative error.
+// Written by a single thread only, the atomics let the report read it while that thread keeps measuring.
+struct PerformanceHistogram
+{
+    static constexpr uint32 SUB_BUCKET_BITS = 3;
+    static constexpr uint32 SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr uint64 MAX_TIME = (uint64(1) << 27) - 1;  // ~134 seconds, longer operations are clamped
+    static constexpr uint32 BUCKET_COUNT = SUB_BUCKETS + (27 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+    static uint32 GetBucket(uint64 time);
+    static uint64 GetBucketTime(uint32 bucket);  // highest time that falls into the bucket
+
+    void Add(uint64 time);
+    void Clear();
+
+    std::atomic<uint64> count{0};
+    std::atomic<uint64> totalTime{0};
+    std::atomic<uint64> minTime{0};
+    std::atomic<uint64> maxTime{0};
+    std::array<std::atomic<uint32>, BUCKET_COUNT> buckets{};
+};
+
+// Histograms of all threads merged for one report
+struct PerformanceData
+{
+    uint64 minTime = 0;
+    uint64 maxTime = 0;
+    uint64 totalTime = 0;
+    uint64 count = 0;
+    std::array<uint64, PerformanceHistogram::BUCKET_COUNT> buckets{};
+
+    void Merge(PerformanceHistogram const& histogram);
+    void Merge(PerformanceData const& other);
+    uint64 GetPercentile(float percentile) const;
+};
+
+// One running measurement, kept on the stack of the caller. Only finish() records it.
 class PerformanceMonitorOperation
 {
 public:
-    PerformanceMonitorOperation(PerformanceData* data, std::string const name, PerformanceStack* stack);
+    PerformanceMonitorOperation() = default;  // the monitor is disabled, finish() does nothing
+    PerformanceMonitorOperation(uint32 id, PerformanceStack* stack);
+
+    PerformanceMonitorOperation(PerformanceMonitorOperation&& other) noexcept { *this = std::move(other); }
+    PerformanceMonitorOperation& operator=(PerformanceMonitorOperation&& other) noexcept;
+
+    PerformanceMonitorOperation(PerformanceMonitorOperation const&) = delete;
+    PerformanceMonitorOperation& operator=(PerformanceMonitorOperation const&) = delete;
+
     void finish();
 
 private:
-    PerformanceData* data;
-    std::string const name;
-    PerformanceStack* stack;
-    std::chrono::microseconds started;
+    bool active = false;
+    uint32 id = 0;
+    PerformanceStack* stack = nullptr;
+    size_t stackDepth = 0;  // size of the stack before the operation pushed its name
+    std::chrono::steady_clock::time_point started;
 };
 
 class PerformanceMonitor
@@ -59,14 +100,49 @@ public:
     }
 
 public:
-    PerformanceMonitorOperation* start(PerformanceMetric metric, std::string const name,
-                                       PerformanceStack* stack = nullptr);
+    PerformanceMonitorOperation start(PerformanceMetric metric, std::string const& name,
+                                      PerformanceStack* stack = nullptr);
     void PrintStats(bool perTick = false, bool fullStack = false);
     void Reset();
 
+    // Metric, name and stack an id was interned for, compared in full since different keys may share a hash
+    struct CachedId
+    {
+        PerformanceMetric metric;
+        std::string name;
+        PerformanceStack stack;
+        uint32 id;
+    };
+
+    // Histograms of one thread, indexed by the interned id of metric and stack name
+    struct ThreadData
+    {
+        std::vector<std::unique_ptr<PerformanceHistogram>> histograms;
+        std::unordered_multimap<uint64, CachedId> ids;  // hash of metric, name and stack -> interned id
+        uint32 resetCount = 0;
+        std::mutex lock;                         // taken by the owner only when adding histograms
+    };
+
 private:
-    std::map<PerformanceMetric, std::map<std::string, PerformanceData*> > data;
-    std::mutex lock;
+    friend class PerformanceMonitorOperation;
+
+    struct Entry
+    {
+        PerformanceMetric metric;
+        std::string name;
+    };
+
+    uint32 GetId(ThreadData& thread, PerformanceMetric metric, std::string const& name, PerformanceStack* stack);
+    uint32 Intern(PerformanceMetric metric, std::string const& stackName);
+    void Record(uint32 id, uint64 time);
+    ThreadData& GetThreadData();
+    std::map<PerformanceMetric, std::map<std::string, PerformanceData>> Collect();
+
+    std::vector<Entry> entries;
+    std::unordered_map<std::string, uint32> entryIds;
+    std::vector<std::shared_ptr<ThreadData>> threads;
+    std::atomic<uint32> resetCount{0};
+    std::mutex lock;  // guards entries, entryIds and threads, never taken while measuring once warmed up
 };
 
 #define sPerformanceMonitor PerformanceMonitor::instance()
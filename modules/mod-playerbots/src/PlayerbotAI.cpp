@@ -43,6 +43,7 @@
 #include "PlayerbotAIConfig.h"
 #include "PlayerbotDbStore.h"
 #include "PlayerbotMgr.h"
+#include "PlayerbotTickScheduler.h"
 #include "Playerbots.h"
 #include "PointMovementGenerator.h"
 #include "PositionValue.h"
@@ -265,6 +266,18 @@ void PlayerbotAI::UpdateAI(uint32 elapsed, bool minimal)
     if (!CanUpdateAI())
         return;
 
+    // Once the map spent its bot budget for this tick, bots nobody is watching wait for a later one
+    bool highPriority = IsRealPlayer() || HasRealPlayerMaster() || bot->IsInCombat() || bot->InBattleground();
+    if (!sPlayerbotTickScheduler->Admit(bot->GetMap(), highPriority, deferredTicks))
+    {
+        ++deferredTicks;
+        YieldThread(GetReactDelay());
+        return;
+    }
+
+    deferredTicks = 0;
+    PlayerbotTickScheduler::TickTimer tickTimer;
+
     // Handle the current spell
     Spell* currentSpell = bot->GetCurrentSpell(CURRENT_GENERIC_SPELL);
     if (!currentSpell)
@@ -442,7 +455,7 @@ void PlayerbotAI::UpdateAIInternal([[maybe_unused]] uint32 elapsed, bool minimal
         return;
 
     std::string const mapString = WorldPosition(bot).isOverworld() ? std::to_string(bot->GetMapId()) : "I";
-    PerformanceMonitorOperation* pmo =
+    PerformanceMonitorOperation pmo =
         sPerformanceMonitor->start(PERF_MON_TOTAL, "PlayerbotAI::UpdateAIInternal " + mapString);
     ExternalEventHelper helper(aiObjectContext);
 
@@ -510,8 +523,7 @@ void PlayerbotAI::UpdateAIInternal([[maybe_unused]] uint32 elapsed, bool minimal
 
     DoNextAction(minimal);
 
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 }
 
 void PlayerbotAI::HandleCommands()
@@ -643,6 +643,7 @@ protected:
     BotCheatMask cheatMask = BotCheatMask::none;
     Position jumpDestination = Position();
     uint32 nextTransportCheck = 0;
+    uint32 deferredTicks = 0;
 };
 
 #endif
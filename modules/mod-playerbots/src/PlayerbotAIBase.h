@@ -7,6 +7,7 @@
 #define _PLAYERBOT_PLAYERBOTAIBASE_H
 
 #include "Define.h"
+#include "PerformanceMonitor.h"
 #include "PlayerbotAIConfig.h"
 
 class PlayerbotAIBase
@@ -25,7 +26,7 @@ public:
 
 protected:
     uint32 nextAICheckDelay;
-    class PerformanceMonitorOperation* totalPmo = nullptr;
+    PerformanceMonitorOperation totalPmo;
 
 private:
     bool _isBotAI;
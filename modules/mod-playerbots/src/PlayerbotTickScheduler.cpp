@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#include "PlayerbotTickScheduler.h"
+
+#include "GameTime.h"
+#include "Log.h"
+#include "Metric.h"
+#include "PlayerbotAIConfig.h"
+
+namespace
+{
+    // Budget of the map the current thread is updating, a map is only ever updated by one thread at a time
+    struct MapTickBudget
+    {
+        Map const* map = nullptr;
+        Milliseconds tick = Milliseconds::zero();
+        std::chrono::microseconds used = std::chrono::microseconds::zero();
+        bool exhausted = false;
+    };
+
+    thread_local MapTickBudget t_budget;
+}
+
+PlayerbotTickScheduler* PlayerbotTickScheduler::instance()
+{
+    static PlayerbotTickScheduler instance;
+    return &instance;
+}
+
+bool PlayerbotTickScheduler::Admit(Map const* map, bool highPriority, uint32 deferredTicks)
+{
+    Milliseconds tick = GameTime::GetGameTimeMS();
+    if (t_budget.map != map || t_budget.tick != tick)
+        t_budget = {map, tick, std::chrono::microseconds::zero(), false};
+
+    uint32 budget = sPlayerbotAIConfig->botTickBudget;
+    if (!budget || highPriority || t_budget.used < std::chrono::milliseconds(budget))
+    {
+        m_admitted.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    if (!t_budget.exhausted)
+    {
+        t_budget.exhausted = true;
+        m_exhaustedMaps.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (deferredTicks >= sPlayerbotAIConfig->botTickMaxDeferrals)
+    {
+        m_admitted.fetch_add(1, std::memory_order_relaxed);
+        m_forced.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    m_deferred.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+PlayerbotTickScheduler::TickTimer::~TickTimer()
+{
+    t_budget.used += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _start);
+}
+
+void PlayerbotTickScheduler::Update(uint32 diff)
+{
+    m_timeSinceLastReport += diff;
+    if (m_timeSinceLastReport < 60 * IN_MILLISECONDS)
+        return;
+
+    m_timeSinceLastReport = 0;
+
+    Statistics stats = GetStatistics();
+    uint64 admitted = stats.admitted - m_lastReported.admitted;
+    uint64 deferred = stats.deferred - m_lastReported.deferred;
+    uint64 forced = stats.forced - m_lastReported.forced;
+    uint64 exhaustedMaps = stats.exhaustedMaps - m_lastReported.exhaustedMaps;
+    m_lastReported = stats;
+
+    METRIC_VALUE("playerbot_ticks_admitted", admitted);
+    METRIC_VALUE("playerbot_ticks_deferred", deferred);
+    METRIC_VALUE("playerbot_ticks_forced", forced);
+    METRIC_VALUE("playerbot_budget_exhausted_maps", exhaustedMaps);
+
+    if (deferred)
+        LOG_DEBUG("playerbots", "Bot tick scheduler: {} bot updates ran, {} deferred, {} forced over budget, {} map ticks out of budget in the last minute",
+                  admitted, deferred, forced, exhaustedMaps);
+}
+
+PlayerbotTickScheduler::Statistics PlayerbotTickScheduler::GetStatistics() const
+{
+    Statistics stats;
+    stats.admitted = m_admitted.load(std::memory_order_relaxed);
+    stats.deferred = m_deferred.load(std::memory_order_relaxed);
+    stats.forced = m_forced.load(std::memory_order_relaxed);
+    stats.exhaustedMaps = m_exhaustedMaps.load(std::memory_order_relaxed);
+    return stats;
+}
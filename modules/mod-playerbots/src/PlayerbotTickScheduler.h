@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2016+ AzerothCore <www.azerothcore.org>, released under GNU AGPL v3 license, you may redistribute it
+ * and/or modify it under version 3 of the License, or (at your option), any later version.
+ */
+
+#ifndef _PLAYERBOT_TICK_SCHEDULER_H
+#define _PLAYERBOT_TICK_SCHEDULER_H
+
+#include "Common.h"
+
+#include <atomic>
+#include <chrono>
+
+class Map;
+
+/**
+ * @brief Caps the time bot AI may spend per map and world tick
+ *
+ * Bots are updated from Player::Update, i.e. on the MapUpdater worker that runs their map.
+ * Every map gets its own budget per world tick so a map crowded with bots does not hold back
+ * the whole MapUpdater batch. Once a map spent its budget, low priority bots (no real player
+ * involved, out of combat: idle, RPG, travel, grind) skip their AI evaluation and retry on a
+ * later tick. A bot deferred too many times in a row runs regardless so it cannot starve.
+ *
+ * High priority bots always run, their time still counts against the budget.
+ */
+class PlayerbotTickScheduler
+{
+public:
+    static PlayerbotTickScheduler* instance();
+
+    /**
+     * @brief Decide whether a bot on the given map runs its AI this tick
+     *
+     * @param map Map the bot is updated on, its budget is tracked per updating thread
+     * @param highPriority Bot serves a real player or is fighting
+     * @param deferredTicks How many ticks in a row this bot was already deferred
+     */
+    bool Admit(Map const* map, bool highPriority, uint32 deferredTicks);
+
+    /**
+     * @brief Measures one admitted bot AI update and charges it to the current map budget
+     */
+    class TickTimer
+    {
+    public:
+        TickTimer() : _start(std::chrono::steady_clock::now()) {}
+        ~TickTimer();
+
+    private:
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    /**
+     * @brief Reports the deferral statistics (called from the world thread)
+     */
+    void Update(uint32 diff);
+
+    struct Statistics
+    {
+        uint64 admitted = 0;
+        uint64 deferred = 0;
+        uint64 forced = 0;          // deferred too often, ran over budget
+        uint64 exhaustedMaps = 0;   // map ticks that ran out of budget
+    };
+
+    Statistics GetStatistics() const;
+
+private:
+    PlayerbotTickScheduler() = default;
+
+    std::atomic<uint64> m_admitted{0};
+    std::atomic<uint64> m_deferred{0};
+    std::atomic<uint64> m_forced{0};
+    std::atomic<uint64> m_exhaustedMaps{0};
+
+    Statistics m_lastReported;
+    uint32 m_timeSinceLastReport = 0;
+};
+
+#define sPlayerbotTickScheduler PlayerbotTickScheduler::instance()
+
+#endif
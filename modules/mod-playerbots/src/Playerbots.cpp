@@ -25,6 +25,7 @@
 #include "Metric.h"
 #include "PlayerScript.h"
 #include "PlayerbotAIConfig.h"
+#include "PlayerbotTickScheduler.h"
 #include "PlayerbotWorldThreadProcessor.h"
 #include "RandomPlayerbotMgr.h"
 #include "ScriptMgr.h"
@@ -343,6 +344,7 @@ public:
     void OnUpdate(uint32 diff) override
     {
         sPlayerbotWorldProcessor->Update(diff);
+        sPlayerbotTickScheduler->Update(diff);
         sRandomPlayerbotMgr->UpdateAI(diff);  // World thread only
     }
 };
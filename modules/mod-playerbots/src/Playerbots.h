@@ -30,17 +30,18 @@ int strcmpi(char const* s1, char const* s2);
 #define GET_PLAYERBOT_AI(object) sPlayerbotsMgr->GetPlayerbotAI(object)
 #define GET_PLAYERBOT_MGR(object) sPlayerbotsMgr->GetPlayerbotMgr(object)
 
-#define AI_VALUE(type, name) context->GetValue<type>(name)->Get()
+#define AI_VALUE_ID(name) NAMED_OBJECT_ID(UntypedValue, name)
+#define AI_VALUE(type, name) context->GetValue<type>(AI_VALUE_ID(name))->Get()
 #define AI_VALUE2(type, name, param) context->GetValue<type>(name, param)->Get()
 
-#define AI_VALUE_LAZY(type, name) context->GetValue<type>(name)->LazyGet()
+#define AI_VALUE_LAZY(type, name) context->GetValue<type>(AI_VALUE_ID(name))->LazyGet()
 #define AI_VALUE2_LAZY(type, name, param) context->GetValue<type>(name, param)->LazyGet()
 
-#define AI_VALUE_REF(type, name) context->GetValue<type>(name)->RefGet()
+#define AI_VALUE_REF(type, name) context->GetValue<type>(AI_VALUE_ID(name))->RefGet()
 
-#define SET_AI_VALUE(type, name, value) context->GetValue<type>(name)->Set(value)
+#define SET_AI_VALUE(type, name, value) context->GetValue<type>(AI_VALUE_ID(name))->Set(value)
 #define SET_AI_VALUE2(type, name, param, value) context->GetValue<type>(name, param)->Set(value)
-#define RESET_AI_VALUE(type, name) context->GetValue<type>(name)->Reset()
+#define RESET_AI_VALUE(type, name) context->GetValue<type>(AI_VALUE_ID(name))->Reset()
 #define RESET_AI_VALUE2(type, name, param) context->GetValue<type>(name, param)->Reset()
 
 #define PAI_VALUE(type, name) sPlayerbotsMgr->GetPlayerbotAI(player)->GetAiObjectContext()->GetValue<type>(name)->Get()
@@ -356,8 +356,7 @@ void RandomPlayerbotMgr::LogPlayerLocation()
 
 void RandomPlayerbotMgr::UpdateAIInternal(uint32 elapsed, bool /*minimal*/)
 {
-    if (totalPmo)
-        totalPmo->finish();
+    totalPmo.finish();
 
     totalPmo = sPerformanceMonitor->start(PERF_MON_TOTAL, "RandomPlayerbotMgr::FullTick");
 
@@ -402,7 +401,7 @@ void RandomPlayerbotMgr::UpdateAIInternal(uint32 elapsed, bool /*minimal*/)
     uint32 updateIntervalTurboBoost = _isBotInitializing ? 1 : sPlayerbotAIConfig->randomBotUpdateInterval;
     SetNextCheckDelay(updateIntervalTurboBoost * (onlineBotFocus + 25) * 10);
 
-    PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(
+    PerformanceMonitorOperation pmo = sPerformanceMonitor->start(
         PERF_MON_TOTAL,
         onlineBotCount < maxAllowedBotCount ? "RandomPlayerbotMgr::Login" : "RandomPlayerbotMgr::UpdateAIInternal");
 
@@ -528,8 +527,7 @@ void RandomPlayerbotMgr::UpdateAIInternal(uint32 elapsed, bool /*minimal*/)
         }
     }
 
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     if (sPlayerbotAIConfig->hasLog("player_location.csv"))
     {
@@ -1704,7 +1702,7 @@ void RandomPlayerbotMgr::RandomTeleport(Player* bot, std::vector<WorldLocation>&
         return;
     }
 
-    PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "RandomTeleportByLocations");
+    PerformanceMonitorOperation pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "RandomTeleportByLocations");
 
     std::shuffle(std::begin(tlocs), std::end(tlocs), RandomEngine::Instance());
     for (uint32 i = 0; i < tlocs.size(); i++)
@@ -1776,14 +1774,12 @@ void RandomPlayerbotMgr::RandomTeleport(Player* bot, std::vector<WorldLocation>&
         bot->TeleportTo(loc.GetMapId(), x, y, z, 0);
         bot->SendMovementFlagUpdate();
 
-        if (pmo)
-            pmo->finish();
+        pmo.finish();
 
         return;
     }
 
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     // LOG_ERROR("playerbots", "Cannot teleport bot {} - no locations available ({} locations)", bot->GetName().c_str(),
     //           tlocs.size());
@@ -2297,7 +2293,7 @@ void RandomPlayerbotMgr::RandomTeleport(Player* bot)
     if (bot->InBattleground())
         return;
 
-    PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "RandomTeleport");
+    PerformanceMonitorOperation pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "RandomTeleport");
     std::vector<WorldLocation> locs;
 
     std::list<Unit*> targets;
@@ -2325,8 +2321,7 @@ void RandomPlayerbotMgr::RandomTeleport(Player* bot)
         RandomTeleportForLevel(bot);
     }
 
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     Refresh(bot);
 }
@@ -2359,7 +2354,7 @@ void RandomPlayerbotMgr::IncreaseLevel(Player* bot)
     if (maxLevel > sWorld->getIntConfig(CONFIG_MAX_PLAYER_LEVEL))
         maxLevel = sWorld->getIntConfig(CONFIG_MAX_PLAYER_LEVEL);
 
-    PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "IncreaseLevel");
+    PerformanceMonitorOperation pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "IncreaseLevel");
     uint32 lastLevel = GetValue(bot, "level");
     uint8 level = bot->GetLevel() + 1;
     if (level > maxLevel)
@@ -2372,8 +2367,7 @@ void RandomPlayerbotMgr::IncreaseLevel(Player* bot)
         factory.Randomize(true);
     }
 
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 }
 
 void RandomPlayerbotMgr::RandomizeFirst(Player* bot)
@@ -2398,7 +2392,7 @@ void RandomPlayerbotMgr::RandomizeFirst(Player* bot)
         minLevel = std::max(minLevel, sWorld->getIntConfig(CONFIG_START_HEROIC_PLAYER_LEVEL));
     }
 
-    PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "RandomizeFirst");
+    PerformanceMonitorOperation pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "RandomizeFirst");
 
     uint32 level;
 
@@ -2465,8 +2459,7 @@ void RandomPlayerbotMgr::RandomizeFirst(Player* bot)
     if (bot->GetGroup())
         botAI->LeaveOrDisbandGroup();
 
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     RandomTeleportForLevel(bot);
 }
@@ -2477,7 +2470,7 @@ void RandomPlayerbotMgr::RandomizeMin(Player* bot)
     if (!botAI)
         return;
 
-    PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "RandomizeMin");
+    PerformanceMonitorOperation pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "RandomizeMin");
     uint32 level = sPlayerbotAIConfig->randomBotMinLevel;
     SetValue(bot, "level", level);
     PlayerbotFactory factory(bot, level);
@@ -2506,8 +2499,7 @@ void RandomPlayerbotMgr::RandomizeMin(Player* bot)
     if (bot->GetGroup())
         botAI->LeaveOrDisbandGroup();
 
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 }
 
 void RandomPlayerbotMgr::Clear(Player* bot)
@@ -2566,7 +2558,7 @@ void RandomPlayerbotMgr::Refresh(Player* bot)
 
     LOG_DEBUG("playerbots", "Refreshing bot {} <{}>", bot->GetGUID().ToString().c_str(), bot->GetName().c_str());
 
-    PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "Refresh");
+    PerformanceMonitorOperation pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "Refresh");
 
     botAI->Reset();
 
@@ -2588,8 +2580,7 @@ void RandomPlayerbotMgr::Refresh(Player* bot)
     if (bot->GetGroup())
         botAI->LeaveOrDisbandGroup();
 
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 }
 
 bool RandomPlayerbotMgr::IsRandomBot(Player* bot)
@@ -317,7 +317,9 @@ void TravelNode::removeLinkTo(TravelNode* node, bool removePaths)
         if (removePaths)
             paths.erase(node);
 
-        links.erase(node);
+        if (links.erase(node))
+            linksChanged();
+
         routes.erase(node);
     }
     else
@@ -331,6 +333,7 @@ void TravelNode::removeLinkTo(TravelNode* node, bool removePaths)
         links.clear();
         paths.clear();
         routes.clear();
+        linksChanged();
     }
 }
 
@@ -1108,6 +1111,7 @@ TravelNode* TravelNodeMap::addNode(WorldPosition pos, std::string const prefered
     newNode = new TravelNode(pos, finalName, isImportant);
 
     m_nodes.push_back(newNode);
+    TravelNode::linksChanged();
 
     return newNode;
 }
@@ -1126,6 +1130,7 @@ void TravelNodeMap::removeNode(TravelNode* node)
     }
 
     m_nodes.erase(std::remove(m_nodes.begin(), m_nodes.end(), nullptr), m_nodes.end());
+    TravelNode::linksChanged();
 }
 
 void TravelNodeMap::fullLinkNode(TravelNode* startNode, Unit* bot)
@@ -1193,6 +1198,114 @@ TravelNode* TravelNodeMap::getNode(WorldPosition pos, [[maybe_unused]] std::vect
     return nullptr;
 }
 
+TravelNodeGraph::TravelNodeGraph(std::vector<TravelNode*> const& nodes, uint32 version)
+    : version(version), nodes(nodes)
+{
+    indices.reserve(nodes.size());
+    for (uint32 i = 0; i < nodes.size(); ++i)
+        indices[nodes[i]] = i;
+
+    mapIds.reserve(nodes.size());
+    walking.reserve(nodes.size());
+    offsets.reserve(nodes.size() + 1);
+
+    for (TravelNode* node : nodes)
+    {
+        offsets.push_back(edges.size());
+        mapIds.push_back(node->getMapId());
+        walking.push_back(node->isWalking());
+
+        for (auto const& link : *node->getLinks())
+        {
+            auto index = indices.find(link.first);
+            if (index != indices.end())
+                edges.push_back({index->second, link.second});
+        }
+    }
+
+    offsets.push_back(edges.size());
+}
+
+uint32 TravelNodeGraph::getIndex(TravelNode* node) const
+{
+    auto index = indices.find(node);
+    return index != indices.end() ? index->second : NO_NODE;
+}
+
+std::shared_ptr<TravelNodeGraph const> TravelNodeMap::getGraph()
+{
+    std::lock_guard<std::mutex> guard(m_graphMtx);
+
+    uint32 version = TravelNode::getLinkVersion();
+    if (!m_graph || m_graph->getVersion() != version)
+        m_graph = std::make_shared<TravelNodeGraph const>(m_nodes, version);
+
+    return m_graph;
+}
+
+namespace
+{
+    // A* bookkeeping, sized to the graph once per thread and reused by every search on it.
+    // A node only holds valid data when its stamp matches the current search.
+    struct TravelRouteSearch
+    {
+        struct OpenNode
+        {
+            float f;
+            uint32 index;
+
+            bool operator<(OpenNode const& other) const { return f > other.f; }
+        };
+
+        std::vector<uint32> stamps;
+        std::vector<float> g, h;
+        std::vector<uint32> parents, gold;
+        std::vector<uint8> closed;
+        std::vector<OpenNode> open;
+        uint32 stamp = 0;
+
+        void reset(uint32 size)
+        {
+            if (stamps.size() < size)
+            {
+                stamps.resize(size, 0);
+                g.resize(size);
+                h.resize(size);
+                parents.resize(size);
+                gold.resize(size);
+                closed.resize(size);
+            }
+
+            if (++stamp == 0)
+            {
+                std::fill(stamps.begin(), stamps.end(), 0);
+                stamp = 1;
+            }
+
+            open.clear();
+        }
+
+        bool isVisited(uint32 index) const { return stamps[index] == stamp; }
+
+        void visit(uint32 index, float heuristic)
+        {
+            stamps[index] = stamp;
+            h[index] = heuristic;
+            parents[index] = TravelNodeGraph::NO_NODE;
+            gold[index] = 0;
+            closed[index] = false;
+        }
+
+        void push(uint32 index)
+        {
+            open.push_back({g[index] + h[index], index});
+            std::push_heap(open.begin(), open.end());
+        }
+    };
+
+    thread_local TravelRouteSearch routeSearch;
+}
+
 TravelNodeRoute TravelNodeMap::getRoute(TravelNode* start, TravelNode* goal, Player* bot)
 {
     float botSpeed = bot ? bot->GetSpeed(MOVE_RUN) : 7.0f;
@@ -1200,18 +1313,24 @@ TravelNodeRoute TravelNodeMap::getRoute(TravelNode* start, TravelNode* goal, Pla
     if (start == goal)
         return TravelNodeRoute();
 
-    // Basic A* algoritm
-    std::unordered_map<TravelNode*, TravelNodeStub> m_stubs;
+    std::shared_ptr<TravelNodeGraph const> graph = getGraph();
+
+    uint32 startIndex = graph->getIndex(start);
+    uint32 goalIndex = graph->getIndex(goal);
 
-    TravelNodeStub* startStub = &m_stubs.insert(std::make_pair(start, TravelNodeStub(start))).first->second;
+    if (startIndex == TravelNodeGraph::NO_NODE || goalIndex == TravelNodeGraph::NO_NODE)
+        return TravelNodeRoute();
+
+    // Basic A* algoritm
+    // The hearthstone portal of the bot is not part of the graph, it gets the index right after the last node.
+    uint32 const portalIndex = graph->size();
+    PortalNode* portNode = nullptr;
 
-    TravelNodeStub* currentNode = nullptr;
-    TravelNodeStub* childNode = nullptr;
-    float f = 0.f;
-    float g = 0.f;
-    float h = 0.f;
+    TravelRouteSearch& search = routeSearch;
+    search.reset(graph->size() + 1);
 
-    std::vector<TravelNodeStub*> open, closed;
+    search.visit(startIndex, 0.0f);
+    search.g[startIndex] = 0.0f;
 
     if (bot)
     {
@@ -1219,24 +1338,24 @@ TravelNodeRoute TravelNodeMap::getRoute(TravelNode* start, TravelNode* goal, Pla
         if (botAI)
         {
             if (botAI->HasCheat(BotCheatMask::gold))
-                startStub->currentGold = 10000000;
+                search.gold[startIndex] = 10000000;
             else
             {
                 AiObjectContext* context = botAI->GetAiObjectContext();
-                startStub->currentGold = AI_VALUE2(uint32, "free money for", (uint32)NeedMoneyFor::travel);
+                search.gold[startIndex] = AI_VALUE2(uint32, "free money for", (uint32)NeedMoneyFor::travel);
             }
         }
         else
-            startStub->currentGold = bot->GetMoney();
+            search.gold[startIndex] = bot->GetMoney();
 
-        if (!bot->HasSpellCooldown(8690) && bot->IsAlive())
+        if (botAI && !bot->HasSpellCooldown(8690) && bot->IsAlive())
         {
             AiObjectContext* context = botAI->GetAiObjectContext();
 
             TravelNode* homeNode = sTravelNodeMap->getNode(AI_VALUE(WorldPosition, "home bind"), nullptr, 10.0f);
             if (homeNode)
             {
-                PortalNode* portNode = (PortalNode*)sTravelNodeMap->teleportNodes[bot->GetGUID()][8690];
+                portNode = (PortalNode*)sTravelNodeMap->teleportNodes[bot->GetGUID()][8690];
                 {
                     portNode = new PortalNode(start);
 
@@ -1245,97 +1364,87 @@ TravelNodeRoute TravelNodeMap::getRoute(TravelNode* start, TravelNode* goal, Pla
 
                 portNode->SetPortal(start, homeNode, 8690);
 
-                childNode = &m_stubs.insert(std::make_pair(portNode, TravelNodeStub(portNode))).first->second;
-
-                childNode->m_g = 10 * MINUTE;
-                childNode->m_h = childNode->dataNode->fDist(goal) / botSpeed;
-                childNode->m_f = childNode->m_g + childNode->m_h;
-                // childNode->parent = startStub;
-
-                open.push_back(childNode);
-                std::push_heap(open.begin(), open.end(),
-                               [](TravelNodeStub* i, TravelNodeStub* j) { return i->m_f < j->m_f; });
-                childNode->open = true;
+                search.visit(portalIndex, portNode->fDist(goal) / botSpeed);
+                search.g[portalIndex] = 10 * MINUTE;
+                search.push(portalIndex);
             }
         }
     }
 
-    if (open.size() == 0 && !start->hasRouteTo(goal))
+    if (search.open.empty() && !start->hasRouteTo(goal))
         return TravelNodeRoute();
 
-    std::make_heap(open.begin(), open.end(), [](TravelNodeStub* i, TravelNodeStub* j) { return i->m_f < j->m_f; });
-
-    open.push_back(startStub);
-    std::push_heap(open.begin(), open.end(), [](TravelNodeStub* i, TravelNodeStub* j) { return i->m_f < j->m_f; });
-    startStub->open = true;
+    search.push(startIndex);
 
-    while (!open.empty())
+    auto relax = [&](uint32 index, uint32 childIndex, TravelNodePath* path)
     {
-        std::sort(open.begin(), open.end(), [](TravelNodeStub* i, TravelNodeStub* j) { return i->m_f < j->m_f; });
+        float linkCost = path->getCost(bot, search.gold[index]);
 
-        currentNode = open.front();  // pop n node from open for which f is minimal
+        if (linkCost <= 0)
+            return;
 
-        std::pop_heap(open.begin(), open.end(), [](TravelNodeStub* i, TravelNodeStub* j) { return i->m_f < j->m_f; });
-        open.pop_back();
-        currentNode->open = false;
+        float g = search.g[index] + linkCost;  // distance from start + distance between the two nodes
 
-        currentNode->close = true;
-        closed.push_back(currentNode);
-
-        if (currentNode->dataNode == goal ||
-            (currentNode->dataNode->getMapId() != start->getMapId() && currentNode->dataNode->isWalking()))
+        if (search.isVisited(childIndex))
         {
-            TravelNodeStub* parent = currentNode->parent;
+            if (search.g[childIndex] <= g)  // n' is already in open or closed with a lower cost g(n')
+                return;                     // consider next successor
+        }
+        else
+            search.visit(childIndex, graph->getNode(childIndex)->fDist(goal) / botSpeed);
 
-            std::vector<TravelNode*> path;
-            path.push_back(currentNode->dataNode);
+        search.g[childIndex] = g;
+        search.parents[childIndex] = index;
+        search.gold[childIndex] = (bot && !bot->isTaxiCheater()) ? search.gold[index] - path->getPrice() : search.gold[index];
+        search.closed[childIndex] = false;
 
-            while (parent != nullptr)
-            {
-                path.push_back(parent->dataNode);
-                parent = parent->parent;
-            }
+        // The old entry of a re-queued node stays in the heap and is skipped once popped.
+        search.push(childIndex);
+    };
 
-            reverse(path.begin(), path.end());
+    while (!search.open.empty())
+    {
+        std::pop_heap(search.open.begin(), search.open.end());  // pop n node from open for which f is minimal
+        TravelRouteSearch::OpenNode current = search.open.back();
+        search.open.pop_back();
 
-            return TravelNodeRoute(path);
-        }
+        uint32 index = current.index;
+        if (search.closed[index] || current.f != search.g[index] + search.h[index])
+            continue;
 
-        for (auto const& link : *currentNode->dataNode->getLinks())  // for each successor n' of n
-        {
-            TravelNode* linkNode = link.first;
-            float linkCost = link.second->getCost(bot, currentNode->currentGold);
+        search.closed[index] = true;
 
-            if (linkCost <= 0)
-                continue;
+        bool isPortal = index == portalIndex;
+        TravelNode* node = isPortal ? portNode : graph->getNode(index);
+        uint32 mapId = isPortal ? node->getMapId() : graph->getMapId(index);
+        bool walking = isPortal ? node->isWalking() : graph->isWalking(index);
 
-            childNode = &m_stubs.insert(std::make_pair(linkNode, TravelNodeStub(linkNode))).first->second;
-            g = currentNode->m_g + linkCost;  // stance from start + distance between the two nodes
-            if ((childNode->open || childNode->close) &&
-                childNode->m_g <= g)  // n' is already in opend or closed with a lower cost g(n')
-                continue;             // consider next successor
+        if (index == goalIndex || (mapId != graph->getMapId(startIndex) && walking))
+        {
+            std::vector<TravelNode*> path;
 
-            h = childNode->dataNode->fDist(goal) / botSpeed;
-            f = g + h;  // compute f(n')
-            childNode->m_f = f;
-            childNode->m_g = g;
-            childNode->m_h = h;
-            childNode->parent = currentNode;
+            for (uint32 step = index; step != TravelNodeGraph::NO_NODE; step = search.parents[step])
+                path.push_back(step == portalIndex ? portNode : graph->getNode(step));
 
-            if (bot && !bot->isTaxiCheater())
-                childNode->currentGold = currentNode->currentGold - link.second->getPrice();
+            reverse(path.begin(), path.end());
 
-            if (childNode->close)
-                childNode->close = false;
+            return TravelNodeRoute(path);
+        }
 
-            if (!childNode->open)
+        if (isPortal)
+        {
+            for (auto const& link : *portNode->getLinks())
             {
-                open.push_back(childNode);
-                std::push_heap(open.begin(), open.end(),
-                               [](TravelNodeStub* i, TravelNodeStub* j) { return i->m_f < j->m_f; });
-                childNode->open = true;
+                uint32 childIndex = graph->getIndex(link.first);
+                if (childIndex != TravelNodeGraph::NO_NODE)
+                    relax(index, childIndex, link.second);
             }
+
+            continue;
         }
+
+        for (TravelNodeGraph::Edge const* edge = graph->edgesBegin(index); edge != graph->edgesEnd(index); ++edge)  // for each successor n' of n
+            relax(index, edge->to, edge->path);
     }
 
     return TravelNodeRoute();
@@ -1447,7 +1556,10 @@ TravelPath TravelNodeMap::getFullPath(WorldPosition startPos, WorldPosition endP
     TravelNodeRoute route = sTravelNodeMap->getRoute(startPos, endPos, beginPath, bot);
 
     if (route.isEmpty())
+    {
+        sTravelNodeMap->m_nMapMtx.unlock_shared();
         return movePath;
+    }
 
     if (sPlayerbotAIConfig->hasLog("bot_pathfinding.csv"))
     {
@@ -1503,7 +1615,7 @@ TravelNode* TravelNodeMap::addZoneLinkNode(TravelNode* startNode)
         //TravelNode* endNode = path.first; //not used, line marked for removal.
 
         std::string zoneName = startNode->getPosition()->getAreaName(true, true);
-        for (auto& pos : path.second.getPath())
+        for (auto pos : path.second.getPath())
         {
             std::string const newZoneName = pos.getAreaName(true, true);
             if (zoneName != newZoneName)
@@ -2415,9 +2527,10 @@ void TravelNodeMap::loadNodeStore()
             {
                 Field* fields = result->Fetch();
 
+                // The store was saved from a deduplicated map, skip the duplicate search per node.
                 TravelNode* node = addNode(WorldPosition(fields[2].Get<uint32>(), fields[3].Get<float>(),
                                                          fields[4].Get<float>(), fields[5].Get<float>()),
-                                           fields[1].Get<std::string>(), true);
+                                           fields[1].Get<std::string>(), true, false);
 
                 if (fields[6].Get<bool>())
                     node->setLinked(true);
@@ -2488,11 +2601,8 @@ void TravelNodeMap::loadNodeStore()
 
                 TravelNodePath* path = startNode->getPathTo(endNode);
 
-                std::vector<WorldPosition> ppath = path->getPath();
-                ppath.push_back(WorldPosition(fields[3].Get<uint32>(), fields[4].Get<float>(), fields[5].Get<float>(),
-                                              fields[6].Get<float>()));
-
-                path->setPath(ppath);
+                path->addPoint(WorldPosition(fields[3].Get<uint32>(), fields[4].Get<float>(), fields[5].Get<float>(),
+                                             fields[6].Get<float>()));
 
                 if (path->getCalculated())
                     path->setComplete(true);
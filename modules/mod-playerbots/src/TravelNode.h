@@ -6,6 +6,10 @@
 #ifndef _PLAYERBOT_TRAVELNODE_H
 #define _PLAYERBOT_TRAVELNODE_H
 
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <shared_mutex>
 
 #include "TravelMgr.h"
@@ -102,7 +106,7 @@ public:
 
     // Getters
     bool getComplete() { return complete || pathType != TravelNodePathType::walk; }
-    std::vector<WorldPosition> getPath() { return path; }
+    std::vector<WorldPosition> const& getPath() { return path; }
 
     TravelNodePathType getPathType() { return pathType; }
     uint32 getPathObject() { return pathObject; }
@@ -122,6 +126,7 @@ public:
     void setComplete(bool complete1) { complete = complete1; }
 
     void setPath(std::vector<WorldPosition> path1) { path = path1; }
+    void addPoint(WorldPosition point) { path.push_back(point); }
 
     void setPathAndCost(std::vector<WorldPosition> path1, float speed)
     {
@@ -267,7 +272,10 @@ public:
         {
             paths[node] = path;
             if (isLink)
+            {
                 links[node] = &paths[node];
+                linksChanged();
+            }
 
             return &paths[node];
         }
@@ -287,7 +295,10 @@ public:
             if (!hasPathTo(node))
                 setPathTo(node, TravelNodePath(distance));
             else
+            {
                 links[node] = &paths[node];
+                linksChanged();
+            }
         }
     }
 
@@ -318,6 +329,10 @@ public:
 
     void print(bool printFailed = true);
 
+    // Bumped whenever a node in the map gains or loses a link, the route graph is rebuilt when it is out of date.
+    static uint32 getLinkVersion() { return linkVersion.load(std::memory_order_acquire); }
+    static void linksChanged() { linkVersion.fetch_add(1, std::memory_order_acq_rel); }
+
 protected:
     // Logical name of the node
     std::string nodeName;
@@ -342,6 +357,8 @@ protected:
     // bool transport = false;
     // Entry of transport.
     // uint32 transportId = 0;
+
+    inline static std::atomic<uint32> linkVersion{0};
 };
 
 class PortalNode : public TravelNode
@@ -356,7 +373,9 @@ public:
         paths.clear();
         links.clear();
         TravelNodePath path(0.1f, 0.1f, (uint8)TravelNodePathType::teleportSpell, portalSpell, true);
-        setPathTo(endNode, path);
+        // Portal nodes are per bot and never part of the route graph, link them without invalidating it.
+        paths[endNode] = path;
+        links[endNode] = &paths[endNode];
     };
 };
 
@@ -409,7 +428,7 @@ public:
     void clear() { fullPath.clear(); }
 
     bool empty() { return fullPath.empty(); }
-    std::vector<PathNodePoint> getPath() { return fullPath; }
+    std::vector<PathNodePoint> const& getPath() { return fullPath; }
     WorldPosition getFront() { return fullPath.front().point; }
     WorldPosition getBack() { return fullPath.back().point; }
 
@@ -445,7 +464,7 @@ public:
     bool hasNode(TravelNode* node) { return findNode(node) != nodes.end(); }
     float getTotalDistance();
 
-    std::vector<TravelNode*> getNodes() { return nodes; }
+    std::vector<TravelNode*> const& getNodes() { return nodes; }
 
     TravelPath buildPath(std::vector<WorldPosition> pathToStart = {}, std::vector<WorldPosition> pathToEnd = {},
                          Unit* bot = nullptr);
@@ -460,17 +479,40 @@ private:
     std::vector<TravelNode*> nodes;
 };
 
-// A node container to aid A* calculations with nodes.
-class TravelNodeStub
+// Read only snapshot of all node links the route search runs on.
+// Nodes are numbered densely, the links of node i are edges[offsets[i]] up to edges[offsets[i + 1]].
+class TravelNodeGraph
 {
 public:
-    TravelNodeStub(TravelNode* dataNode1) { dataNode = dataNode1; }
+    static constexpr uint32 NO_NODE = std::numeric_limits<uint32>::max();
+
+    struct Edge
+    {
+        uint32 to;
+        TravelNodePath* path;
+    };
+
+    TravelNodeGraph(std::vector<TravelNode*> const& nodes, uint32 version);
+
+    uint32 getVersion() const { return version; }
+    uint32 size() const { return nodes.size(); }
+    uint32 getIndex(TravelNode* node) const;
 
-    TravelNode* dataNode;
-    float m_f = 0.0, m_g = 0.0, m_h = 0.0;
-    bool open = false, close = false;
-    TravelNodeStub* parent = nullptr;
-    uint32 currentGold = 0;
+    TravelNode* getNode(uint32 index) const { return nodes[index]; }
+    uint32 getMapId(uint32 index) const { return mapIds[index]; }
+    bool isWalking(uint32 index) const { return walking[index]; }
+
+    Edge const* edgesBegin(uint32 index) const { return edges.data() + offsets[index]; }
+    Edge const* edgesEnd(uint32 index) const { return edges.data() + offsets[index + 1]; }
+
+private:
+    uint32 version;
+    std::vector<TravelNode*> nodes;
+    std::vector<uint32> mapIds;
+    std::vector<uint8> walking;
+    std::vector<uint32> offsets;
+    std::vector<Edge> edges;
+    std::unordered_map<TravelNode*, uint32> indices;
 };
 
 // The container of all nodes.
@@ -538,6 +580,9 @@ public:
         return rNodes[urand(0, rNodes.size() - 1)];
     }
 
+    // Current route graph, rebuilt first if links changed since the last search.
+    std::shared_ptr<TravelNodeGraph const> getGraph();
+
     // Finds the best nodePath between two nodes
     TravelNodeRoute getRoute(TravelNode* start, TravelNode* goal, Player* bot = nullptr);
 
@@ -588,6 +633,9 @@ public:
 private:
     std::vector<TravelNode*> m_nodes;
 
+    std::shared_ptr<TravelNodeGraph const> m_graph;
+    std::mutex m_graphMtx;
+
     std::vector<std::pair<uint32, WorldPosition>> mapOffsets;
 
     bool hasToSave = false;
@@ -235,7 +235,7 @@ void PlayerbotFactory::Randomize(bool incremental)
     // LOG_DEBUG("playerbots", "Preparing to {} randomize...", (incremental ? "incremental" : "full"));
     Prepare();
     LOG_DEBUG("playerbots", "Resetting player...");
-    PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Reset");
+    PerformanceMonitorOperation pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Reset");
     if (!sPlayerbotAIConfig->equipmentPersistence || level < sPlayerbotAIConfig->equipmentPersistenceLevel)
     {
         bot->resetTalents(true);
@@ -258,29 +258,25 @@ void PlayerbotFactory::Randomize(bool incremental)
     bot->InitStatsForLevel(true);
     CancelAuras();
     // bot->SaveToDB(false, false);
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     // pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Immersive");
     // LOG_INFO("playerbots", "Initializing immersive...");
     // InitImmersive();
-    // if (pmo)
-    //     pmo->finish();
+    // pmo.finish();
 
     if (sPlayerbotAIConfig->randomBotPreQuests)
     {
         pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Quests");
         InitInstanceQuests();
         InitAttunementQuests();
-        if (pmo)
-            pmo->finish();
+        pmo.finish();
     }
     else
     {
         pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Quests");
         InitAttunementQuests();
-        if (pmo)
-            pmo->finish();
+        pmo.finish();
     }
 
     pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Spells1");
@@ -288,14 +284,12 @@ void PlayerbotFactory::Randomize(bool incremental)
     bot->LearnDefaultSkills();
     InitClassSpells();
     InitAvailableSpells();
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     LOG_DEBUG("playerbots", "Initializing skills (step 1)...");
     pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Skills1");
     InitSkills();
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Talents");
     LOG_DEBUG("playerbots", "Initializing talents...");
@@ -311,39 +305,33 @@ void PlayerbotFactory::Randomize(bool incremental)
         // botAI->DoSpecificAction("auto talents");
         botAI->ResetStrategies(false);  // fix wrong stored strategy
     }
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Spells2");
     LOG_DEBUG("playerbots", "Initializing spells (step 2)...");
     InitAvailableSpells();
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Reputation");
     LOG_DEBUG("playerbots", "Initializing reputation...");
     InitReputation();
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     LOG_DEBUG("playerbots", "Initializing special spells...");
     pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Spells3");
     InitSpecialSpells();
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Mounts");
     LOG_DEBUG("playerbots", "Initializing mounts...");
     InitMounts();
     // bot->SaveToDB(false, false);
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     // pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Skills2");
     // LOG_INFO("playerbots", "Initializing skills (step 2)...");
     // UpdateTradeSkills();
-    // if (pmo)
-    //     pmo->finish();
+    // pmo.finish();
 
     pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Equip");
     LOG_DEBUG("playerbots", "Initializing equipmemt...");
@@ -354,60 +342,51 @@ void PlayerbotFactory::Randomize(bool incremental)
             InitEquipment(incremental, incremental ? false : sPlayerbotAIConfig->twoRoundsGearInit);
     }
     // bot->SaveToDB(false, false);
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     // if (bot->GetLevel() >= sPlayerbotAIConfig->minEnchantingBotLevel)
     // {
     //     pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Enchant");
     //     LOG_INFO("playerbots", "Initializing enchant templates...");
     //     LoadEnchantContainer();
-    //     if (pmo)
-    //         pmo->finish();
+    //     pmo.finish();
     // }
 
     pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Bags");
     LOG_DEBUG("playerbots", "Initializing bags...");
     InitBags();
     // bot->SaveToDB(false, false);
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Ammo");
     LOG_DEBUG("playerbots", "Initializing ammo...");
     InitAmmo();
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Food");
     LOG_DEBUG("playerbots", "Initializing food...");
     InitFood();
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Potions");
     LOG_DEBUG("playerbots", "Initializing potions...");
     InitPotions();
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Reagents");
     LOG_DEBUG("playerbots", "Initializing reagents...");
     InitReagents();
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Keys");
     LOG_DEBUG("playerbots", "Initializing keys...");
     InitKeyring();
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     // pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_EqSets");
     // LOG_DEBUG("playerbots", "Initializing second equipment set...");
     //    InitSecondEquipmentSet();
-    // if (pmo)
-    //     pmo->finish();
+    // pmo.finish();
 
     if (bot->GetLevel() >= sPlayerbotAIConfig->minEnchantingBotLevel)
     {
@@ -417,21 +396,18 @@ void PlayerbotFactory::Randomize(bool incremental)
     // pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_EnchantTemplate");
     // LOG_INFO("playerbots", "Initializing enchant templates...");
     // ApplyEnchantTemplate();
-    // if (pmo)
-    //     pmo->finish();
+    // pmo.finish();
     // }
 
     pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Inventory");
     LOG_DEBUG("playerbots", "Initializing inventory...");
     // InitInventory();
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Consumable");
     LOG_DEBUG("playerbots", "Initializing consumables...");
     InitConsumables();
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     LOG_DEBUG("playerbots", "Initializing glyphs...");
     InitGlyphs();
@@ -445,16 +421,14 @@ void PlayerbotFactory::Randomize(bool incremental)
         InitGuild();
     }
     // bot->SaveToDB(false, false);
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 
     if (bot->GetLevel() >= 70)
     {
         pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Arenas");
         // LOG_INFO("playerbots", "Initializing arena teams...");
         InitArenaTeam();
-        if (pmo)
-            pmo->finish();
+        pmo.finish();
     }
 
     if (!incremental)
@@ -470,8 +444,7 @@ void PlayerbotFactory::Randomize(bool incremental)
         InitPet();
         // bot->SaveToDB(false, false);
         InitPetTalents();
-        if (pmo)
-            pmo->finish();
+        pmo.finish();
     }
 
     pmo = sPerformanceMonitor->start(PERF_MON_RNDBOT, "PlayerbotFactory_Save");
@@ -481,8 +454,7 @@ void PlayerbotFactory::Randomize(bool incremental)
     bot->SetPower(POWER_MANA, bot->GetMaxPower(POWER_MANA));
     bot->SaveToDB(false, false);
     LOG_DEBUG("playerbots", "Initialization Done.");
-    if (pmo)
-        pmo->finish();
+    pmo.finish();
 }
 
 void PlayerbotFactory::Refresh()
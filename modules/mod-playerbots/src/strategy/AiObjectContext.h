@@ -40,6 +40,7 @@ public:
     virtual Trigger* GetTrigger(std::string const name);
     virtual Action* GetAction(std::string const name);
     virtual UntypedValue* GetUntypedValue(std::string const name);
+    UntypedValue* GetUntypedValue(NamedObjectKey key) { return valueContexts.GetContextObject(key, botAI); }
 
     template <class T>
     Value<T>* GetValue(std::string const name)
@@ -47,6 +48,12 @@ public:
         return dynamic_cast<Value<T>*>(GetUntypedValue(name));
     }
 
+    template <class T>
+    Value<T>* GetValue(NamedObjectKey key)
+    {
+        return dynamic_cast<Value<T>*>(GetUntypedValue(key));
+    }
+
     template <class T>
     Value<T>* GetValue(std::string const name, std::string const param)
     {
@@ -7,7 +7,10 @@
 #define _PLAYERBOT_NAMEDOBJECTCONEXT_H
 
 #include <list>
+#include <mutex>
 #include <set>
+#include <shared_mutex>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -17,6 +20,150 @@
 
 class PlayerbotAI;
 
+typedef uint32 NamedObjectId;
+
+// A name split into the id of its base name and the qualifier after "::", which points into the original name
+struct NamedObjectKey
+{
+    NamedObjectId Id;
+    std::string_view Qualifier;
+};
+
+/**
+ * Dense integer ids for the base names of one kind of context object (strategies, actions, triggers, values).
+ * Qualifiers ("name::qualifier") are not interned, they are chosen at runtime and would grow the table without limit.
+ * Lookups go through a per thread cache first so bot updates running in parallel do not contend on the shared table.
+ */
+template <class T>
+class NamedObjectIds
+{
+public:
+    static constexpr NamedObjectId INVALID_ID = NamedObjectId(-1);
+
+    static NamedObjectKey InternKey(std::string_view name)
+    {
+        size_t found = name.find("::");
+        if (found == std::string_view::npos)
+            return {Intern(name), {}};
+
+        return {Intern(name.substr(0, found)), name.substr(found + 2)};
+    }
+
+    // Does not create new ids, the id is INVALID_ID for unknown base names
+    static NamedObjectKey FindKey(std::string_view name)
+    {
+        size_t found = name.find("::");
+        if (found == std::string_view::npos)
+            return {Find(name), {}};
+
+        return {Find(name.substr(0, found)), name.substr(found + 2)};
+    }
+
+    // Base names only, see InternKey() for qualified ones
+    static NamedObjectId Intern(std::string_view name)
+    {
+        NamedObjectId id = FindCached(name);
+        if (id != INVALID_ID)
+            return id;
+
+        {
+            std::unique_lock<std::shared_mutex> lock(_lock);
+            id = InternLocked(name);
+        }
+
+        _threadIds.emplace(std::string(name), id);
+        return id;
+    }
+
+    // Does not create new ids, used for names coming from outside the code (chat commands, saved values)
+    static NamedObjectId Find(std::string_view name)
+    {
+        NamedObjectId id = FindCached(name);
+        if (id != INVALID_ID)
+            return id;
+
+        {
+            std::shared_lock<std::shared_mutex> lock(_lock);
+            auto itr = _ids.find(name);
+            if (itr == _ids.end())
+                return INVALID_ID;
+
+            id = itr->second;
+        }
+
+        _threadIds.emplace(std::string(name), id);
+        return id;
+    }
+
+    static std::string GetName(NamedObjectId id)
+    {
+        std::shared_lock<std::shared_mutex> lock(_lock);
+        return _names[id];
+    }
+
+    struct NameHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view name) const { return std::hash<std::string_view>()(name); }
+    };
+
+private:
+    typedef std::unordered_map<std::string, NamedObjectId, NameHash, std::equal_to<>> IdMap;
+
+    static NamedObjectId FindCached(std::string_view name)
+    {
+        auto itr = _threadIds.find(name);
+        return itr != _threadIds.end() ? itr->second : INVALID_ID;
+    }
+
+    static NamedObjectId InternLocked(std::string_view name)
+    {
+        auto itr = _ids.find(name);
+        if (itr != _ids.end())
+            return itr->second;
+
+        NamedObjectId id = NamedObjectId(_names.size());
+        _names.emplace_back(name);
+        _ids.emplace(std::string(name), id);
+        return id;
+    }
+
+    inline static std::shared_mutex _lock;
+    inline static IdMap _ids;
+    inline static std::vector<std::string> _names;
+    inline static thread_local IdMap _threadIds;
+};
+
+/**
+ * Resolves the name used at one call site to its key. String literals are split and interned once per site and thread,
+ * anything else (std::string, char const*) goes through the id cache and must outlive the use of the key.
+ */
+template <class T>
+class NamedObjectSite
+{
+public:
+    template <size_t N>
+    NamedObjectKey Resolve(char const (&name)[N])
+    {
+        if (_name != name)
+        {
+            _key = NamedObjectIds<T>::InternKey(name);
+            _name = name;
+        }
+
+        return _key;
+    }
+
+    NamedObjectKey Resolve(std::string_view name) { return NamedObjectIds<T>::InternKey(name); }
+
+private:
+    char const* _name = nullptr;
+    NamedObjectKey _key = {NamedObjectIds<T>::INVALID_ID, {}};
+};
+
+#define NAMED_OBJECT_ID(type, name) \
+    ([]() -> NamedObjectSite<type>& { static thread_local NamedObjectSite<type> site; return site; }().Resolve(name))
+
 class Qualified
 {
 public:
@@ -137,6 +284,7 @@ class SharedNamedObjectContextList
 public:
     using ObjectCreator = std::function<T*(PlayerbotAI* ai)>;
     std::unordered_map<std::string, ObjectCreator> creators;
+    std::vector<ObjectCreator const*> creatorsById;
     std::vector<NamedObjectContext<T>*> contexts;
 
     ~SharedNamedObjectContextList()
@@ -149,7 +297,15 @@ public:
     {
         contexts.push_back(context);
         for (auto const& iter : context->creators)
-            creators[iter.first] = iter.second;
+        {
+            ObjectCreator& creator = creators[iter.first] = iter.second;
+
+            NamedObjectId id = NamedObjectIds<T>::Intern(iter.first);
+            if (id >= creatorsById.size())
+                creatorsById.resize(id + 1, nullptr);
+
+            creatorsById[id] = &creator;
+        }
     }
 };
 
@@ -159,57 +315,80 @@ class NamedObjectContextList
 public:
     using ObjectCreator = std::function<T*(PlayerbotAI* ai)>;
     const std::unordered_map<std::string, ObjectCreator>& creators;
+    const std::vector<ObjectCreator const*>& creatorsById;
     const std::vector<NamedObjectContext<T>*>& contexts;
-    std::unordered_map<std::string, T*> created;
+    std::vector<T*> created; // indexed by NamedObjectId
+    // Qualified objects by base id and qualifier, only the ones this bot used
+    std::unordered_map<NamedObjectId, std::unordered_map<std::string, T*, typename NamedObjectIds<T>::NameHash, std::equal_to<>>> qualified;
 
     NamedObjectContextList(const SharedNamedObjectContextList<T>& shared)
-        : creators(shared.creators), contexts(shared.contexts)
+        : creators(shared.creators), creatorsById(shared.creatorsById), contexts(shared.contexts)
     {
     }
 
     ~NamedObjectContextList()
     {
-        for (typename std::unordered_map<std::string, T*>::const_iterator i = created.begin(); i != created.end(); i++)
-        {
-            if (i->second)
-                delete i->second;
-        }
+        for (T* object : created)
+            delete object;
 
         created.clear();
+
+        for (auto const& [id, objects] : qualified)
+            for (auto const& [qualifier, object] : objects)
+                delete object;
+
+        qualified.clear();
     }
 
-    T* create(std::string name, PlayerbotAI* botAI)
+    T* create(NamedObjectKey key, PlayerbotAI* botAI)
     {
-        size_t found = name.find("::");
-        std::string qualifier;
-        if (found != std::string::npos)
-        {
-            qualifier = name.substr(found + 2);
-            name = name.substr(0, found);
-        }
-
-        if (creators.find(name) == creators.end())
+        if (key.Id >= creatorsById.size() || !creatorsById[key.Id])
             return nullptr;
 
-        const ObjectCreator& creator = creators.at(name);
-
-        T* object = creator(botAI);
+        T* object = (*creatorsById[key.Id])(botAI);
         Qualified* q = dynamic_cast<Qualified*>(object);
-        if (q && found != std::string::npos)
-            q->Qualify(qualifier);
+        if (q && !key.Qualifier.empty())
+            q->Qualify(std::string(key.Qualifier));
 
         return object;
     }
 
-    T* GetContextObject(const std::string& name, PlayerbotAI* botAI)
+    T* GetContextObject(NamedObjectKey key, PlayerbotAI* botAI)
     {
-        if (created.find(name) == created.end())
+        if (key.Id == NamedObjectIds<T>::INVALID_ID)
+            return nullptr;
+
+        if (!key.Qualifier.empty())
         {
-            if (T* object = create(name, botAI))
-                return created[name] = object;
+            auto& objects = qualified[key.Id];
+            auto itr = objects.find(key.Qualifier);
+            if (itr != objects.end())
+                return itr->second;
+
+            T* object = create(key, botAI);
+            if (!object)
+                return nullptr;
+
+            return objects[std::string(key.Qualifier)] = object;
         }
 
-        return created[name];
+        if (key.Id < created.size() && created[key.Id])
+            return created[key.Id];
+
+        T* object = create(key, botAI);
+        if (!object)
+            return nullptr;
+
+        if (key.Id >= created.size())
+            created.resize(key.Id + 1, nullptr);
+
+        return created[key.Id] = object;
+    }
+
+    // Unknown base names do not get an id, they come from chat commands and saved values
+    T* GetContextObject(const std::string& name, PlayerbotAI* botAI)
+    {
+        return GetContextObject(NamedObjectIds<T>::FindKey(name), botAI);
     }
 
     std::set<std::string> GetSiblings(const std::string& name)
@@ -247,8 +426,18 @@ public:
     std::set<std::string> GetCreated()
     {
         std::set<std::string> result;
-        for (typename std::unordered_map<std::string, T*>::const_iterator i = created.begin(); i != created.end(); i++)
-            result.insert(i->first);
+        for (NamedObjectId id = 0; id < created.size(); ++id)
+        {
+            if (created[id])
+                result.insert(NamedObjectIds<T>::GetName(id));
+        }
+
+        for (auto const& [id, objects] : qualified)
+        {
+            std::string const name = NamedObjectIds<T>::GetName(id);
+            for (auto const& [qualifier, object] : objects)
+                result.insert(name + "::" + qualifier);
+        }
 
         return result;
     }
@@ -123,11 +123,10 @@ Unit* UnitCalculatedValue::Get()
 {
     if (checkInterval < 2)
     {
-        PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(
+        PerformanceMonitorOperation pmo = sPerformanceMonitor->start(
             PERF_MON_VALUE, this->getName(), this->context ? &this->context->performanceStack : nullptr);
         value = Calculate();
-        if (pmo)
-            pmo->finish();
+        pmo.finish();
     }
     else
     {
@@ -135,11 +134,10 @@ Unit* UnitCalculatedValue::Get()
         if (!lastCheckTime || now - lastCheckTime >= checkInterval)
         {
             lastCheckTime = now;
-            PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(
+            PerformanceMonitorOperation pmo = sPerformanceMonitor->start(
                 PERF_MON_VALUE, this->getName(), this->context ? &this->context->performanceStack : nullptr);
             value = Calculate();
-            if (pmo)
-                pmo->finish();
+            pmo.finish();
         }
     }
     // Prevent crashing by InWorld check
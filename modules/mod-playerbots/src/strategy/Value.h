@@ -72,11 +72,10 @@ public:
     {
         if (checkInterval < 2)
         {
-            // PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(PERF_MON_VALUE, this->getName(),
+            // PerformanceMonitorOperation pmo = sPerformanceMonitor->start(PERF_MON_VALUE, this->getName(),
             // this->context ? &this->context->performanceStack : nullptr);
             value = Calculate();
-            // if (pmo)
-            //     pmo->finish();
+            // pmo.finish();
         }
         else
         {
@@ -84,11 +83,10 @@ public:
             if (!lastCheckTime || now - lastCheckTime >= checkInterval)
             {
                 lastCheckTime = now;
-                // PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(PERF_MON_VALUE, this->getName(),
+                // PerformanceMonitorOperation pmo = sPerformanceMonitor->start(PERF_MON_VALUE, this->getName(),
                 // this->context ? &this->context->performanceStack : nullptr);
                 value = Calculate();
-                // if (pmo)
-                //     pmo->finish();
+                // pmo.finish();
             }
         }
         return value;
@@ -105,11 +103,10 @@ public:
     {
         if (checkInterval < 2)
         {
-            // PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(PERF_MON_VALUE, this->getName(),
+            // PerformanceMonitorOperation pmo = sPerformanceMonitor->start(PERF_MON_VALUE, this->getName(),
             // this->context ? &this->context->performanceStack : nullptr);
             value = Calculate();
-            // if (pmo)
-            //     pmo->finish();
+            // pmo.finish();
         }
         else
         {
@@ -117,11 +114,10 @@ public:
             if (!lastCheckTime || now - lastCheckTime >= checkInterval)
             {
                 lastCheckTime = now;
-                // PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(PERF_MON_VALUE, this->getName(),
+                // PerformanceMonitorOperation pmo = sPerformanceMonitor->start(PERF_MON_VALUE, this->getName(),
                 // this->context ? &this->context->performanceStack : nullptr);
                 value = Calculate();
-                // if (pmo)
-                //     pmo->finish();
+                // pmo.finish();
             }
         }
         return value;
@@ -154,11 +150,10 @@ public:
         {
             this->lastCheckTime = now;
 
-            PerformanceMonitorOperation* pmo = sPerformanceMonitor->start(
+            PerformanceMonitorOperation pmo = sPerformanceMonitor->start(
                 PERF_MON_VALUE, this->getName(), this->context ? &this->context->performanceStack : nullptr);
             this->value = this->Calculate();
-            if (pmo)
-                pmo->finish();
+            pmo.finish();
         }
 
         return this->value;
@@ -20,9 +20,47 @@
 #include "Errors.h"
 #include "Log.h"
 #include "MapDefines.h"
+#include "Metric.h"
+#include <atomic>
 
 namespace MMAP
 {
+    namespace
+    {
+        std::atomic<uint32> NavMeshGeneration{0};
+
+        MetricGauge& NavMeshQueryGauge()
+        {
+            static MetricGauge& gauge = sMetric->GetRegistry().GetGauge("mmap_navmesh_queries", "dtNavMeshQuery objects owned by all threads");
+            return gauge;
+        }
+
+        // dtNavMeshQuery is not thread safe, so every thread that searches paths keeps one query per map
+        // the query only points at the shared navmesh, creating an instance does not allocate a new one
+        struct NavMeshQueryPool
+        {
+            struct Entry
+            {
+                dtNavMeshQuery* Query = nullptr;
+                uint32 Generation = 0;
+            };
+
+            ~NavMeshQueryPool()
+            {
+                for (auto& [mapId, entry] : Queries)
+                {
+                    dtFreeNavMeshQuery(entry.Query);
+                }
+
+                NavMeshQueryGauge().Add(-double(Queries.size()));
+            }
+
+            std::unordered_map<uint32, Entry> Queries;
+        };
+
+        thread_local NavMeshQueryPool ThreadNavMeshQueries;
+    }
+
     // ######################## MMapMgr ########################
     MMapMgr::~MMapMgr()
     {
@@ -46,6 +84,37 @@ namespace MMAP
         thread_safe_environment = false;
     }
 
+    void MMapMgr::InvalidatePaths(MMapData* mmap, dtTileRef tileRef, bool tileAdded)
+    {
+        if (!mmap->pathCache)
+        {
+            return;
+        }
+
+        // a removed tile cuts the corridors through it
+        std::vector<uint32> tileIndexes = { mmap->navMesh->decodePolyIdTile(tileRef) };
+
+        // a new tile may open a shorter way for corridors that had to go around it
+        if (tileAdded)
+        {
+            dtMeshHeader const* header = mmap->navMesh->getTileByRef(tileRef)->header;
+            for (int32 x = header->x - 1; x <= header->x + 1; ++x)
+            {
+                for (int32 y = header->y - 1; y <= header->y + 1; ++y)
+                {
+                    dtMeshTile const* neighbours[4];
+                    int32 count = mmap->navMesh->getTilesAt(x, y, neighbours, 4);
+                    for (int32 i = 0; i < count; ++i)
+                    {
+                        tileIndexes.push_back(mmap->navMesh->decodePolyIdTile(mmap->navMesh->getTileRef(neighbours[i])));
+                    }
+                }
+            }
+        }
+
+        mmap->pathCache->Invalidate(tileIndexes);
+    }
+
     MMapDataSet::const_iterator MMapMgr::GetMMapData(uint32 mapId) const
     {
         // return the iterator if found or end() if not found/NULL
@@ -112,7 +181,12 @@ namespace MMAP
         LOG_DEBUG("maps", "MMAP:loadMapData: Loaded {:03}.mmap", mapId);
 
         // store inside our map list
-        MMapData* mmap_data = new MMapData(mesh);
+        MMapData* mmap_data = new MMapData(mesh, ++NavMeshGeneration);
+        if (uint32 pathCacheSize = sConfigMgr->GetOption<uint32>("MoveMaps.PathCacheSize", 512))
+        {
+            mmap_data->pathCache = std::make_unique<PathCache>(*mesh, pathCacheSize);
+        }
+
         itr->second = mmap_data;
         return true;
     }
@@ -123,6 +197,11 @@ namespace MMAP
     }
 
     bool MMapMgr::loadMap(uint32 mapId, int32 x, int32 y)
+    {
+        return loadMap(mapId, x, y, MMapTileData());
+    }
+
+    bool MMapMgr::loadMap(uint32 mapId, int32 x, int32 y, MMapTileData tile)
     {
         // make sure the mmap is loaded and ready to load tiles
         if (!loadMapData(mapId))
@@ -134,6 +213,8 @@ namespace MMAP
         MMapData* mmap = loadedMMaps[mapId];
         ASSERT(mmap->navMesh);
 
+        std::unique_lock<std::shared_mutex> guard(mmap->navMeshLock);
+
         // check if we already have this tile loaded
         uint32 packedGridPos = packTileID(x, y);
         if (mmap->loadedTileRefs.find(packedGridPos) != mmap->loadedTileRefs.end())
@@ -144,7 +225,31 @@ namespace MMAP
         }
 
         // load this tile :: mmaps/MMMXXYY.mmtile
-        std::string fileName = Acore::StringFormat(TILE_FILE_NAME_FORMAT, sConfigMgr->GetOption<std::string>("DataDir", "."), mapId, x, y);
+        if (!tile.Data && !ReadTile(sConfigMgr->GetOption<std::string>("DataDir", "."), mapId, x, y, tile))
+        {
+            return false;
+        }
+
+        dtTileRef tileRef = 0;
+
+        // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
+        if (dtStatusSucceed(mmap->navMesh->addTile(tile.Data.get(), tile.Size, DT_TILE_FREE_DATA, 0, &tileRef)))
+        {
+            dtMeshHeader* header = (dtMeshHeader*)tile.Data.release();
+            mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
+            ++loadedTiles;
+            InvalidatePaths(mmap, tileRef, true);
+            LOG_DEBUG("maps", "MMAP:loadMap: Loaded mmtile {:03}[{:02},{:02}] into {:03}[{:02},{:02}]", mapId, x, y, mapId, header->x, header->y);
+            return true;
+        }
+
+        LOG_ERROR("maps", "MMAP:loadMap: Could not load {:03}{:02}{:02}.mmtile into navmesh", mapId, x, y);
+        return false;
+    }
+
+    bool MMapMgr::ReadTile(std::string const& dataDir, uint32 mapId, int32 x, int32 y, MMapTileData& tile)
+    {
+        std::string fileName = Acore::StringFormat(TILE_FILE_NAME_FORMAT, dataDir, mapId, x, y);
         FILE* file = fopen(fileName.c_str(), "rb");
         if (!file)
         {
@@ -169,34 +274,20 @@ namespace MMAP
             return false;
         }
 
-        unsigned char* data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
-        ASSERT(data);
+        tile.Data.reset((unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM));
+        ASSERT(tile.Data);
 
-        std::size_t result = fread(data, fileHeader.size, 1, file);
+        std::size_t result = fread(tile.Data.get(), fileHeader.size, 1, file);
+        fclose(file);
         if (!result)
         {
             LOG_ERROR("maps", "MMAP:loadMap: Bad header or data in mmap {:03}{:02}{:02}.mmtile", mapId, x, y);
-            fclose(file);
+            tile.Data.reset();
             return false;
         }
 
-        fclose(file);
-
-        dtTileRef tileRef = 0;
-
-        // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef)))
-        {
-            mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
-            ++loadedTiles;
-            dtMeshHeader* header = (dtMeshHeader*)data;
-            LOG_DEBUG("maps", "MMAP:loadMap: Loaded mmtile {:03}[{:02},{:02}] into {:03}[{:02},{:02}]", mapId, x, y, mapId, header->x, header->y);
-            return true;
-        }
-
-        LOG_ERROR("maps", "MMAP:loadMap: Could not load {:03}{:02}{:02}.mmtile into navmesh", mapId, x, y);
-        dtFree(data);
-        return false;
+        tile.Size = int32(fileHeader.size);
+        return true;
     }
 
     bool MMapMgr::unloadMap(uint32 mapId, int32 x, int32 y)
@@ -211,6 +302,7 @@ namespace MMAP
         }
 
         MMapData* mmap = itr->second;
+        std::unique_lock<std::shared_mutex> guard(mmap->navMeshLock);
 
         // check if we have this tile loaded
         uint32 packedGridPos = packTileID(x, y);
@@ -235,6 +327,7 @@ namespace MMAP
 
         mmap->loadedTileRefs.erase(packedGridPos);
         --loadedTiles;
+        InvalidatePaths(mmap, tileRef, false);
         LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded mmtile {:03}[{:02},{:02}] from {:03}", mapId, x, y, mapId);
         return true;
     }
@@ -251,6 +344,7 @@ namespace MMAP
 
         // unload all tiles from given map
         MMapData* mmap = itr->second;
+        mmap->navMeshLock.lock();
         for (auto& i : mmap->loadedTileRefs)
         {
             uint32 x = (i.first >> 16);
@@ -267,6 +361,7 @@ namespace MMAP
             }
         }
 
+        mmap->navMeshLock.unlock();
         delete mmap;
         itr->second = nullptr;
         LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded {:03}.mmap", mapId);
@@ -274,45 +369,40 @@ namespace MMAP
         return true;
     }
 
-    bool MMapMgr::unloadMapInstance(uint32 mapId, uint32 instanceId)
+    dtNavMesh const* MMapMgr::GetNavMesh(uint32 mapId)
     {
-        // check if we have this map loaded
         MMapDataSet::const_iterator itr = GetMMapData(mapId);
         if (itr == loadedMMaps.end())
         {
-            // file may not exist, therefore not loaded
-            LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded navmesh map {:03}", mapId);
-            return false;
+            return nullptr;
         }
 
-        MMapData* mmap = itr->second;
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
+        return itr->second->navMesh;
+    }
+
+    PathCache* MMapMgr::GetPathCache(uint32 mapId)
+    {
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
         {
-            LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded dtNavMeshQuery mapId {:03} instanceId {}", mapId, instanceId);
-            return false;
+            return nullptr;
         }
 
-        dtNavMeshQuery* query = mmap->navMeshQueries[instanceId];
-
-        dtFreeNavMeshQuery(query);
-        mmap->navMeshQueries.erase(instanceId);
-        LOG_DEBUG("maps", "MMAP:unloadMapInstance: Unloaded mapId {:03} instanceId {}", mapId, instanceId);
-
-        return true;
+        return itr->second->pathCache.get();
     }
 
-    dtNavMesh const* MMapMgr::GetNavMesh(uint32 mapId)
+    std::shared_lock<std::shared_mutex> MMapMgr::LockNavMesh(uint32 mapId)
     {
         MMapDataSet::const_iterator itr = GetMMapData(mapId);
         if (itr == loadedMMaps.end())
         {
-            return nullptr;
+            return {};
         }
 
-        return itr->second->navMesh;
+        return std::shared_lock<std::shared_mutex>(itr->second->navMeshLock);
     }
 
-    dtNavMeshQuery const* MMapMgr::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
+    dtNavMeshQuery const* MMapMgr::GetNavMeshQuery(uint32 mapId)
     {
         MMapDataSet::const_iterator itr = GetMMapData(mapId);
         if (itr == loadedMMaps.end())
@@ -321,27 +411,31 @@ namespace MMAP
         }
 
         MMapData* mmap = itr->second;
-        if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
+        auto [entry, inserted] = ThreadNavMeshQueries.Queries.try_emplace(mapId);
+        NavMeshQueryPool::Entry& pooled = entry->second;
+        if (inserted)
         {
-            // check again after acquiring mutex
-            if (mmap->navMeshQueries.find(instanceId) == mmap->navMeshQueries.end())
-            {
-                // allocate mesh query
-                dtNavMeshQuery* query = dtAllocNavMeshQuery();
-                ASSERT(query);
+            // allocate mesh query
+            pooled.Query = dtAllocNavMeshQuery();
+            ASSERT(pooled.Query);
+            NavMeshQueryGauge().Add(1);
+        }
 
-                if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
-                {
-                    dtFreeNavMeshQuery(query);
-                    LOG_ERROR("maps", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId {:03} instanceId {}", mapId, instanceId);
-                    return nullptr;
-                }
+        if (pooled.Generation == mmap->generation)
+        {
+            return pooled.Query;
+        }
 
-                LOG_DEBUG("maps", "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId {:03} instanceId {}", mapId, instanceId);
-                mmap->navMeshQueries.insert(std::pair<uint32, dtNavMeshQuery*>(instanceId, query));
-            }
+        // first use on this thread or the map was unloaded and loaded again since, init() only keeps the navmesh pointer and sizes the node pools
+        if (dtStatusFailed(pooled.Query->init(mmap->navMesh, 1024)))
+        {
+            pooled.Generation = 0;
+            LOG_ERROR("maps", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId {:03}", mapId);
+            return nullptr;
         }
 
-        return mmap->navMeshQueries[instanceId];
+        pooled.Generation = mmap->generation;
+        LOG_DEBUG("maps", "MMAP:GetNavMeshQuery: initialized dtNavMeshQuery for mapId {:03}", mapId);
+        return pooled.Query;
     }
 }
@@ -22,6 +22,11 @@
 #include "DetourAlloc.h"
 #include "DetourExtended.h"
 #include "DetourNavMesh.h"
+#include "PathCache.h"
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -43,34 +48,42 @@ namespace MMAP
     static char const* const TILE_FILE_NAME_FORMAT = "{}/mmaps/{:03}{:02}{:02}.mmtile";
 
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
-    typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
 
     // dummy struct to hold map's mmap data
     struct MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) { }
+        MMapData(dtNavMesh* mesh, uint32 meshGeneration) : navMesh(mesh), generation(meshGeneration) { }
 
         ~MMapData()
         {
-            for (auto& navMeshQuerie : navMeshQueries)
-            {
-                dtFreeNavMeshQuery(navMeshQuerie.second);
-            }
-
             if (navMesh)
             {
                 dtFreeNavMesh(navMesh);
             }
         }
 
-        // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
-        NavMeshQuerySet navMeshQueries; // instanceId to query
         dtNavMesh* navMesh;
         MMapTileSet loadedTileRefs; // maps [map grid coords] to [dtTile]
+        // the parent map and all its instances share the navmesh, tiles are only added or removed while this is held exclusively
+        std::shared_mutex navMeshLock;
+        uint32 generation;          // lets thread local queries notice that the navmesh was recreated
+        std::unique_ptr<PathCache> pathCache;   // nullptr if MoveMaps.PathCacheSize is 0
     };
 
     typedef std::unordered_map<uint32, MMapData*> MMapDataSet;
 
+    struct MMapTileDataDeleter
+    {
+        void operator()(unsigned char* data) const { dtFree(data); }
+    };
+
+    // raw mmtile contents read ahead of time, ownership passes to the navmesh once the tile is added
+    struct MMapTileData
+    {
+        std::unique_ptr<unsigned char, MMapTileDataDeleter> Data;
+        int32 Size = 0;
+    };
+
     // singleton class
     // holds all all access to mmap loading unloading and meshes
     class MMapMgr
@@ -81,24 +94,35 @@ namespace MMAP
 
         void InitializeThreadUnsafe(const std::vector<uint32>& mapIds);
         bool loadMap(uint32 mapId, int32 x, int32 y);
+        // adds a tile read by ReadTile(), so only the navmesh update happens on the calling thread
+        bool loadMap(uint32 mapId, int32 x, int32 y, MMapTileData tile);
         bool unloadMap(uint32 mapId, int32 x, int32 y);
         bool unloadMap(uint32 mapId);
-        bool unloadMapInstance(uint32 mapId, uint32 instanceId);
 
-        // the returned [dtNavMeshQuery const*] is NOT threadsafe
-        dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
+        // the returned query belongs to the calling thread, every thread gets its own one per map
+        // it must only be used while the lock returned by LockNavMesh() is held
+        dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId);
         dtNavMesh const* GetNavMesh(uint32 mapId);
+        // nullptr if the map has no mmaps or caching is disabled, only valid while the lock returned by LockNavMesh() is held
+        PathCache* GetPathCache(uint32 mapId);
+        // shared lock over the tiles of the navmesh, does not own anything if the map has no mmaps
+        // grid creation adds tiles under the exclusive lock, so release it before anything that may create a grid
+        [[nodiscard]] std::shared_lock<std::shared_mutex> LockNavMesh(uint32 mapId);
 
         [[nodiscard]] uint32 getLoadedTilesCount() const { return loadedTiles; }
         [[nodiscard]] uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
 
+        // reads and validates a tile file, does not touch any manager state and is safe to call from any thread
+        static bool ReadTile(std::string const& dataDir, uint32 mapId, int32 x, int32 y, MMapTileData& tile);
+
     private:
         bool loadMapData(uint32 mapId);
         uint32 packTileID(int32 x, int32 y);
         [[nodiscard]] MMapDataSet::const_iterator GetMMapData(uint32 mapId) const;
+        static void InvalidatePaths(MMapData* mmap, dtTileRef tileRef, bool tileAdded);
 
         MMapDataSet loadedMMaps;
-        uint32 loadedTiles{0};
+        std::atomic<uint32> loadedTiles{0};
         bool thread_safe_environment{true};
     };
 }
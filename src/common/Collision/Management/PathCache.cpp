@@ -0,0 +1,134 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PathCache.h"
+#include "Metric.h"
+#include <algorithm>
+
+namespace MMAP
+{
+    PathCache::PathCache(dtNavMesh const& navMesh, std::size_t capacity) : _navMesh(navMesh), _capacity(capacity),
+        _hits(sMetric->GetRegistry().GetCounter("path_cache_requests_total", "Path corridor cache lookups", { METRIC_TAG("result", "hit") })),
+        _misses(sMetric->GetRegistry().GetCounter("path_cache_requests_total", "Path corridor cache lookups", { METRIC_TAG("result", "miss") })),
+        _invalidations(sMetric->GetRegistry().GetCounter("path_cache_invalidations_total", "Cached path corridors dropped because a navmesh tile on or next to them was loaded or unloaded"))
+    {
+    }
+
+    std::size_t PathCache::KeyHash::operator()(Key const& key) const
+    {
+        std::size_t hash = std::hash<dtPolyRef>()(key.StartPoly);
+        hash = hash * 31 + std::hash<dtPolyRef>()(key.EndPoly);
+        return hash * 31 + ((std::size_t(key.IncludeFlags) << 16) | key.ExcludeFlags);
+    }
+
+    uint32 PathCache::Find(Key const& key, dtPolyRef* path, uint32 maxPath)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        auto itr = _index.find(key);
+        if (itr == _index.end() || itr->second->Corridor.size() > maxPath)
+        {
+            _misses.Increment();
+            return 0;
+        }
+
+        _entries.splice(_entries.begin(), _entries, itr->second);
+
+        std::vector<dtPolyRef> const& corridor = itr->second->Corridor;
+        std::copy(corridor.begin(), corridor.end(), path);
+        _hits.Increment();
+        return uint32(corridor.size());
+    }
+
+    void PathCache::Store(Key const& key, dtPolyRef const* path, uint32 length)
+    {
+        if (!_capacity || !length)
+            return;
+
+        std::lock_guard<std::mutex> guard(_lock);
+        auto itr = _index.find(key);
+        if (itr != _index.end())
+        {
+            SetCorridor(*itr->second, path, length);
+            _entries.splice(_entries.begin(), _entries, itr->second);
+            return;
+        }
+
+        if (_entries.size() >= _capacity)
+        {
+            _index.erase(_entries.back().CacheKey);
+            _entries.pop_back();
+        }
+
+        _entries.push_front({ key, { }, { } });
+        SetCorridor(_entries.front(), path, length);
+        _index.emplace(key, _entries.begin());
+    }
+
+    void PathCache::SetCorridor(Entry& entry, dtPolyRef const* path, uint32 length) const
+    {
+        entry.Corridor.assign(path, path + length);
+        entry.Tiles.clear();
+        for (uint32 i = 0; i < length; ++i)
+        {
+            entry.Tiles.push_back(_navMesh.decodePolyIdTile(path[i]));
+        }
+
+        std::sort(entry.Tiles.begin(), entry.Tiles.end());
+        entry.Tiles.erase(std::unique(entry.Tiles.begin(), entry.Tiles.end()), entry.Tiles.end());
+    }
+
+    void PathCache::Invalidate(std::vector<uint32> const& tileIndexes)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        uint64 dropped = 0;
+        for (auto itr = _entries.begin(); itr != _entries.end();)
+        {
+            std::vector<uint32> const& tiles = itr->Tiles;
+            bool const crossesTile = std::any_of(tileIndexes.begin(), tileIndexes.end(), [&tiles](uint32 tileIndex)
+            {
+                return std::binary_search(tiles.begin(), tiles.end(), tileIndex);
+            });
+
+            if (!crossesTile)
+            {
+                ++itr;
+                continue;
+            }
+
+            _index.erase(itr->CacheKey);
+            itr = _entries.erase(itr);
+            ++dropped;
+        }
+
+        if (dropped)
+            _invalidations.Increment(dropped);
+    }
+
+    void PathCache::Clear()
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _invalidations.Increment(_entries.size());
+        _entries.clear();
+        _index.clear();
+    }
+
+    std::size_t PathCache::GetSize() const
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        return _entries.size();
+    }
+}
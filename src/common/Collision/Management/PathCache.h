@@ -0,0 +1,93 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _MMAP_PATH_CACHE_H
+#define _MMAP_PATH_CACHE_H
+
+#include "Define.h"
+#include "DetourNavMesh.h"
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class MetricCounter;
+
+namespace MMAP
+{
+    /**
+     * Polygon corridors found by dtNavMeshQuery::findPath on one navmesh, most recently used first.
+     *
+     * Only the corridor between the start and end polygon is kept: the smoothed points depend on the
+     * exact positions inside those polygons and are still built by the caller. Every corridor remembers
+     * the tiles it crosses, so when MMapMgr adds or removes a tile only the corridors through that tile
+     * or next to it are dropped.
+     */
+    class AC_COMMON_API PathCache
+    {
+    public:
+        struct Key
+        {
+            dtPolyRef StartPoly;
+            dtPolyRef EndPoly;
+            uint16 IncludeFlags;
+            uint16 ExcludeFlags;
+
+            bool operator==(Key const& other) const = default;
+        };
+
+        PathCache(dtNavMesh const& navMesh, std::size_t capacity);
+
+        // Copies the corridor into path and returns its length, 0 if it is not cached or longer than maxPath
+        uint32 Find(Key const& key, dtPolyRef* path, uint32 maxPath);
+        void Store(Key const& key, dtPolyRef const* path, uint32 length);
+        // Drops every corridor that crosses one of the tiles, given by their index in the navmesh
+        void Invalidate(std::vector<uint32> const& tileIndexes);
+        void Clear();
+
+        [[nodiscard]] std::size_t GetSize() const;
+
+    private:
+        struct KeyHash
+        {
+            std::size_t operator()(Key const& key) const;
+        };
+
+        struct Entry
+        {
+            Key CacheKey;
+            std::vector<dtPolyRef> Corridor;
+            std::vector<uint32> Tiles;          // sorted tile indexes of the corridor polygons
+        };
+
+        typedef std::list<Entry> EntryList;
+
+        void SetCorridor(Entry& entry, dtPolyRef const* path, uint32 length) const;
+
+        dtNavMesh const& _navMesh;
+        std::size_t const _capacity;
+        mutable std::mutex _lock;
+        EntryList _entries;
+        std::unordered_map<Key, EntryList::iterator, KeyHash> _index;
+
+        MetricCounter& _hits;
+        MetricCounter& _misses;
+        MetricCounter& _invalidations;
+    };
+}
+
+#endif
@@ -22,14 +22,14 @@
 #include "Errors.h"
 #include "IoContext.h"
 #include "LogMessage.h"
-#include "LogOperation.h"
+#include "LogRing.h"
 #include "Logger.h"
-#include "Strand.h"
 #include "StringConvert.h"
 #include "Timer.h"
 #include "Tokenize.h"
 #include <chrono>
 #include <memory>
+#include <optional>
 
 Log::Log() : AppenderId(0), highestLogLevel(LOG_LEVEL_FATAL)
 {
@@ -40,6 +40,7 @@ Log::Log() : AppenderId(0), highestLogLevel(LOG_LEVEL_FATAL)
 
 Log::~Log()
 {
+    _ringWriter.reset();
     Close();
 }
 
@@ -233,24 +234,24 @@ void Log::RegisterAppender(uint8 index, AppenderCreatorFn appenderCreateFn)
 
 void Log::_outMessage(std::string const& filter, LogLevel level, std::string_view message)
 {
-    write(std::make_unique<LogMessage>(level, filter, message));
+    if (_ringWriter)
+        _ringWriter->Write(level, filter, message);
+    else
+        write(std::make_unique<LogMessage>(level, filter, message));
 }
 
 void Log::_outCommand(std::string_view message, std::string_view param1)
 {
-    write(std::make_unique<LogMessage>(LOG_LEVEL_INFO, "commands.gm", message, param1));
+    if (_ringWriter)
+        _ringWriter->Write(LOG_LEVEL_INFO, "commands.gm", message, param1);
+    else
+        write(std::make_unique<LogMessage>(LOG_LEVEL_INFO, "commands.gm", message, param1));
 }
 
 void Log::write(std::unique_ptr<LogMessage>&& msg) const
 {
-    Logger const* logger = GetLoggerByType(msg->type);
-
-    if (_ioContext)
-    {
-        std::shared_ptr<LogOperation> logOperation = std::make_shared<LogOperation>(logger, std::move(msg));
-        Acore::Asio::post(*_ioContext, Acore::Asio::bind_executor(*_strand, [logOperation]() { logOperation->call(); }));
-    }
-    else
+    // The configuration may have changed while an asynchronous message was buffered
+    if (Logger const* logger = GetLoggerByType(msg->type))
         logger->write(msg.get());
 }
 
@@ -367,25 +368,34 @@ Log* Log::instance()
     return &instance;
 }
 
-void Log::Initialize(Acore::Asio::IoContext* ioContext)
+void Log::Initialize(bool async /*= false*/)
 {
-    if (ioContext)
+    LoadFromConfig();
+
+    if (async)
     {
-        _ioContext = ioContext;
-        _strand = std::make_unique<Acore::Asio::Strand>(*ioContext);
+        std::size_t bufferSize = sConfigMgr->GetOption<uint32>("Log.Async.BufferSize", 262144);
+        _ringWriter = std::make_unique<LogRingWriter>(bufferSize, [this](std::unique_ptr<LogMessage>&& msg) { write(std::move(msg)); });
     }
-
-    LoadFromConfig();
 }
 
 void Log::SetSynchronous()
 {
-    _strand.reset();
-    _ioContext = nullptr;
+    _ringWriter.reset();
+}
+
+uint64 Log::GetDroppedMessages() const
+{
+    return _ringWriter ? _ringWriter->GetDroppedMessages() : 0;
 }
 
 void Log::LoadFromConfig()
 {
+    // The writer thread must not use loggers or appenders while they are recreated
+    std::optional<LogRingWriter::SinkLock> sinkLock;
+    if (_ringWriter)
+        sinkLock.emplace(*_ringWriter);
+
     Close();
 
     highestLogLevel = LOG_LEVEL_FATAL;
@@ -28,12 +28,12 @@
 
 class Appender;
 class Logger;
+class LogRingWriter;
 struct LogMessage;
 
 namespace Acore::Asio
 {
     class IoContext;
-    class Strand;
 }
 
 #define LOGGER_ROOT "root"
@@ -61,7 +61,8 @@ private:
 public:
     static Log* instance();
 
-    void Initialize(Acore::Asio::IoContext* ioContext = nullptr);
+    // Asynchronous logging hands messages to a writer thread through per thread buffers (Log.Async.BufferSize)
+    void Initialize(bool async = false);
     void SetSynchronous();  // Not threadsafe - should only be called from main() after all threads are joined
     void LoadFromConfig();
     void Close();
@@ -74,6 +75,21 @@ public:
         _outMessage(filter, level, Acore::StringFormat(fmt, std::forward<Args>(args)...));
     }
 
+    void outFormattedMessage(std::string const& filter, LogLevel const level, std::string_view message)
+    {
+        _outMessage(filter, level, message);
+    }
+
+    /// Formats into a buffer owned by the calling thread, the result is valid until the next call on that thread
+    template<typename... Args>
+    static std::string_view FormatToBuffer(Acore::FormatString<Args...> fmt, Args&&... args)
+    {
+        fmt::memory_buffer& buffer = GetFormatBuffer();
+        buffer.clear();
+        fmt::format_to(std::back_inserter(buffer), fmt, std::forward<Args>(args)...);
+        return { buffer.data(), buffer.size() };
+    }
+
     template<typename... Args>
     void outCommand(uint32 account, Acore::FormatString<Args...> fmt, Args&&... args)
     {
@@ -96,8 +112,17 @@ public:
     [[nodiscard]] std::string const& GetLogsDir() const { return m_logsDir; }
     [[nodiscard]] std::string const& GetLogsTimestamp() const { return m_logsTimestamp; }
 
+    // Messages lost because the buffer of their thread was full, only asynchronous logging drops messages
+    [[nodiscard]] uint64 GetDroppedMessages() const;
+
 private:
     static std::string GetTimestampStr();
+    static fmt::memory_buffer& GetFormatBuffer()
+    {
+        thread_local fmt::memory_buffer buffer;
+        return buffer;
+    }
+
     void write(std::unique_ptr<LogMessage>&& msg) const;
 
     [[nodiscard]] Logger const* GetLoggerByType(std::string const& type) const;
@@ -120,8 +145,7 @@ private:
     std::string m_logsDir;
     std::string m_logsTimestamp;
 
-    Acore::Asio::IoContext* _ioContext;
-    std::unique_ptr<Acore::Asio::Strand> _strand;
+    std::unique_ptr<LogRingWriter> _ringWriter;
 };
 
 #define sLog Log::instance()
@@ -130,7 +154,7 @@ private:
     { \
         try \
         { \
-            sLog->outMessage(filterType__, level__, fmt::format(__VA_ARGS__)); \
+            sLog->outFormattedMessage(filterType__, level__, Log::FormatToBuffer(__VA_ARGS__)); \
         } \
         catch (std::exception const& e) \
         { \
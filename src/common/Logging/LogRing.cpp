@@ -0,0 +1,319 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LogRing.h"
+#include "LogMessage.h"
+#include "StringFormat.h"
+#include "Timer.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace
+{
+    // Records start at multiples of RECORD_ALIGNMENT, so a header always fits in front of the wrap point
+    constexpr std::size_t RECORD_ALIGNMENT = 32;
+
+    struct RecordHeader
+    {
+        uint32 Size;            // including header and padding, a record without any text only skips to the wrap point
+        uint8 Level;
+        uint8 Skip;
+        uint16 TypeLength;
+        uint32 TextLength;
+        uint32 Param1Length;
+        int64 Time;
+    };
+
+    static_assert(sizeof(RecordHeader) <= RECORD_ALIGNMENT);
+
+    constexpr std::size_t Align(std::size_t size)
+    {
+        return (size + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+    }
+
+    std::atomic<uint32> NextWriterId{1};
+
+    // Thread local handle of the ring a thread uses with one writer, released when the thread exits
+    struct ThreadRing
+    {
+        uint32 WriterId = 0;
+        std::shared_ptr<LogRing> Ring;
+
+        ~ThreadRing();
+    };
+
+    thread_local ThreadRing t_ring;
+    thread_local bool t_ringDestroyed = false;
+
+    // Set while this thread holds the sink lock of a writer, e.g. inside an appender
+    thread_local bool t_sinkLockHeld = false;
+
+    ThreadRing::~ThreadRing()
+    {
+        if (Ring)
+            Ring->Abandoned = true;
+
+        t_ringDestroyed = true;
+    }
+}
+
+LogRing::LogRing(std::size_t capacity) : _capacity(std::bit_ceil(std::max(capacity, RECORD_ALIGNMENT * 64)))
+{
+    _buffer = std::make_unique<char[]>(_capacity);
+}
+
+bool LogRing::Push(LogLevel level, std::string_view type, std::string_view text, std::string_view param1, Seconds time)
+{
+    // A single message may take a quarter of the ring, longer texts are cut
+    std::size_t const maxSize = _capacity / 4;
+    type = type.substr(0, std::min<std::size_t>(type.size(), 0xFFFF));
+    param1 = param1.substr(0, std::min(param1.size(), maxSize / 2));
+    std::size_t const fixedSize = sizeof(RecordHeader) + type.size() + param1.size();
+    text = text.substr(0, std::min(text.size(), maxSize - std::min(maxSize, fixedSize)));
+
+    std::size_t const size = Align(fixedSize + text.size());
+    uint64 head = _head.load(std::memory_order_relaxed);
+    uint64 const tail = _tail.load(std::memory_order_acquire);
+
+    std::size_t offset = std::size_t(head & (_capacity - 1));
+    std::size_t const untilWrap = _capacity - offset;
+    std::size_t const needed = size <= untilWrap ? size : untilWrap + size;
+
+    if (_capacity - std::size_t(head - tail) < needed)
+    {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (size > untilWrap)
+    {
+        RecordHeader skip{};
+        skip.Size = uint32(untilWrap);
+        skip.Skip = 1;
+        std::memcpy(&_buffer[offset], &skip, sizeof(skip));
+        head += untilWrap;
+        offset = 0;
+    }
+
+    RecordHeader header{};
+    header.Size = uint32(size);
+    header.Level = uint8(level);
+    header.TypeLength = uint16(type.size());
+    header.TextLength = uint32(text.size());
+    header.Param1Length = uint32(param1.size());
+    header.Time = time.count();
+
+    char* data = &_buffer[offset];
+    std::memcpy(data, &header, sizeof(header));
+    data += sizeof(header);
+    data = std::copy(type.begin(), type.end(), data);
+    data = std::copy(text.begin(), text.end(), data);
+    std::copy(param1.begin(), param1.end(), data);
+
+    _head.store(head + size, std::memory_order_release);
+    return true;
+}
+
+std::size_t LogRing::Consume(std::function<void(Record const&)> const& callback)
+{
+    uint64 tail = _tail.load(std::memory_order_relaxed);
+    uint64 const head = _head.load(std::memory_order_acquire);
+    std::size_t count = 0;
+
+    while (tail != head)
+    {
+        char const* data = &_buffer[std::size_t(tail & (_capacity - 1))];
+        RecordHeader header;
+        std::memcpy(&header, data, sizeof(header));
+        tail += header.Size;
+
+        if (header.Skip)
+            continue;
+
+        data += sizeof(header);
+        Record record;
+        record.Level = LogLevel(header.Level);
+        record.Type = std::string_view(data, header.TypeLength);
+        data += header.TypeLength;
+        record.Text = std::string_view(data, header.TextLength);
+        data += header.TextLength;
+        record.Param1 = std::string_view(data, header.Param1Length);
+        record.Time = Seconds(header.Time);
+
+        callback(record);
+        ++count;
+    }
+
+    _tail.store(tail, std::memory_order_release);
+    return count;
+}
+
+LogRingWriter::LogRingWriter(std::size_t ringSize, Sink sink) : _ringSize(ringSize), _sink(std::move(sink)), _id(NextWriterId++)
+{
+    _thread = std::thread(&LogRingWriter::Run, this);
+}
+
+LogRingWriter::~LogRingWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(_wakeLock);
+        _stop = true;
+    }
+
+    _wake.notify_one();
+    _thread.join();
+}
+
+void LogRingWriter::Write(LogLevel level, std::string_view type, std::string_view text, std::string_view param1 /*= {}*/)
+{
+    // Logged from a thread local destructor after the ring of the thread is gone
+    if (t_ringDestroyed)
+    {
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    LogRing* ring = GetThreadRing();
+    if (!ring->Push(level, type, text, param1, GetEpochTime()))
+    {
+        // Errors are written right away behind what is still buffered, unless this thread already holds the sink lock
+        if (level <= LOG_LEVEL_ERROR && !t_sinkLockHeld && std::this_thread::get_id() != _thread.get_id())
+            WriteDirect(level, type, text, param1);
+        else
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Make sure the reason for a crash is on disk before it happens
+    if (level == LOG_LEVEL_FATAL && !t_sinkLockHeld && std::this_thread::get_id() != _thread.get_id())
+        Flush();
+}
+
+void LogRingWriter::Flush()
+{
+    std::unique_lock<std::mutex> lock(_wakeLock);
+    uint64 const request = ++_flushRequested;
+    _wake.notify_one();
+    _flushed.wait(lock, [&] { return _flushCompleted >= request || _stop; });
+}
+
+void LogRingWriter::WriteDirect(LogLevel level, std::string_view type, std::string_view text, std::string_view param1)
+{
+    WriteBuffered();
+
+    SinkLock lock(*this);
+    _sink(std::make_unique<LogMessage>(level, std::string(type), text, param1));
+}
+
+LogRingWriter::SinkLock::SinkLock(LogRingWriter& writer) : _lock(writer._sinkLock), _wasHeld(t_sinkLockHeld)
+{
+    t_sinkLockHeld = true;
+}
+
+LogRingWriter::SinkLock::~SinkLock()
+{
+    t_sinkLockHeld = _wasHeld;
+}
+
+LogRing* LogRingWriter::GetThreadRing()
+{
+    if (t_ring.WriterId != _id)
+    {
+        if (t_ring.Ring)
+            t_ring.Ring->Abandoned = true;
+
+        t_ring.WriterId = _id;
+        t_ring.Ring = std::make_shared<LogRing>(_ringSize);
+
+        std::lock_guard<std::mutex> lock(_ringsLock);
+        _rings.push_back(t_ring.Ring);
+    }
+
+    return t_ring.Ring.get();
+}
+
+void LogRingWriter::Run()
+{
+    for (;;)
+    {
+        uint64 flushRequested;
+        bool stop;
+        {
+            std::lock_guard<std::mutex> lock(_wakeLock);
+            flushRequested = _flushRequested;
+            stop = _stop;
+        }
+
+        std::size_t written = WriteBuffered();
+
+        {
+            std::unique_lock<std::mutex> lock(_wakeLock);
+            _flushCompleted = flushRequested;
+            _flushed.notify_all();
+
+            // Checked before writing, so messages logged while stopping are not lost
+            if (stop)
+                return;
+
+            if (!written)
+                _wake.wait_for(lock, 10ms, [&] { return _stop || _flushRequested != _flushCompleted; });
+        }
+    }
+}
+
+std::size_t LogRingWriter::WriteBuffered()
+{
+    std::vector<std::shared_ptr<LogRing>> rings;
+    {
+        std::lock_guard<std::mutex> lock(_ringsLock);
+        rings = _rings;
+    }
+
+    std::size_t written = 0;
+    {
+        SinkLock lock(*this);
+        for (std::shared_ptr<LogRing> const& ring : rings)
+        {
+            written += ring->Consume([&](LogRing::Record const& record)
+            {
+                auto message = std::make_unique<LogMessage>(record.Level, std::string(record.Type), record.Text, record.Param1);
+                message->mtime = record.Time;
+                _sink(std::move(message));
+            });
+        }
+
+        uint64 const dropped = _dropped.load(std::memory_order_relaxed);
+        if (dropped != _reportedDropped)
+        {
+            _sink(std::make_unique<LogMessage>(LOG_LEVEL_WARN, "server", fmt::format("Log: {} messages were dropped because the log buffer of their thread was full", dropped - _reportedDropped)));
+            _reportedDropped = dropped;
+        }
+    }
+
+    // Threads that exited and left nothing behind
+    bool const abandoned = std::any_of(rings.begin(), rings.end(), [](std::shared_ptr<LogRing> const& ring) { return ring->Abandoned.load(); });
+    if (abandoned)
+    {
+        std::lock_guard<std::mutex> lock(_ringsLock);
+        std::erase_if(_rings, [](std::shared_ptr<LogRing> const& ring)
+        {
+            return ring->Abandoned && ring->IsEmpty();
+        });
+    }
+
+    return written;
+}
@@ -0,0 +1,138 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGRING_H
+#define LOGRING_H
+
+#include "Define.h"
+#include "Duration.h"
+#include "LogCommon.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+struct LogMessage;
+
+/**
+    Fixed size buffer of log messages written by exactly one thread and read by exactly one other.
+
+    Messages are copied in as they are, without any allocation. When there is no room left the message is
+    dropped and counted instead of blocking the writing thread.
+*/
+class AC_COMMON_API LogRing
+{
+public:
+    struct Record
+    {
+        LogLevel Level;
+        std::string_view Type;
+        std::string_view Text;
+        std::string_view Param1;
+        Seconds Time;
+    };
+
+    // capacity is rounded up to a power of two
+    explicit LogRing(std::size_t capacity);
+
+    bool Push(LogLevel level, std::string_view type, std::string_view text, std::string_view param1, Seconds time);
+
+    // The record views are only valid during the callback
+    std::size_t Consume(std::function<void(Record const&)> const& callback);
+
+    [[nodiscard]] bool IsEmpty() const { return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64 GetDropped() const { return _dropped.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::size_t GetCapacity() const { return _capacity; }
+
+    // Set by the writing thread on exit, the ring is released once it was read empty
+    std::atomic<bool> Abandoned{false};
+
+private:
+    std::unique_ptr<char[]> _buffer;
+    std::size_t _capacity;
+    alignas(64) std::atomic<uint64> _head{0};     // written by the producer
+    alignas(64) std::atomic<uint64> _tail{0};     // written by the consumer
+    std::atomic<uint64> _dropped{0};
+};
+
+/**
+    Asynchronous log backend: every thread that logs gets its own LogRing, a single thread reads all of them
+    and is the only one that hands messages to the loggers and appenders.
+*/
+class AC_COMMON_API LogRingWriter
+{
+public:
+    typedef std::function<void(std::unique_ptr<LogMessage>&&)> Sink;
+
+    LogRingWriter(std::size_t ringSize, Sink sink);
+    ~LogRingWriter();   // writes everything still buffered
+
+    void Write(LogLevel level, std::string_view type, std::string_view text, std::string_view param1 = {});
+
+    // Blocks until every message written before the call reached the sink
+    void Flush();
+
+    // Held while messages are handed to the sink, take it before changing loggers or appenders.
+    // Errors that find the ring full are dropped while the same thread holds it, instead of deadlocking.
+    class SinkLock
+    {
+    public:
+        explicit SinkLock(LogRingWriter& writer);
+        ~SinkLock();
+
+        SinkLock(SinkLock const&) = delete;
+        SinkLock& operator=(SinkLock const&) = delete;
+
+    private:
+        std::lock_guard<std::mutex> _lock;
+        bool const _wasHeld;
+    };
+
+    [[nodiscard]] uint64 GetDroppedMessages() const { return _dropped.load(std::memory_order_relaxed); }
+
+private:
+    LogRing* GetThreadRing();
+    void Run();
+    std::size_t WriteBuffered();
+    void WriteDirect(LogLevel level, std::string_view type, std::string_view text, std::string_view param1);
+
+    std::size_t const _ringSize;
+    Sink const _sink;
+    uint32 const _id;
+
+    std::mutex _ringsLock;
+    std::vector<std::shared_ptr<LogRing>> _rings;
+
+    std::mutex _sinkLock;
+    std::atomic<uint64> _dropped{0};
+    uint64 _reportedDropped = 0;
+
+    std::mutex _wakeLock;
+    std::condition_variable _wake;
+    std::condition_variable _flushed;
+    uint64 _flushRequested = 0;
+    uint64 _flushCompleted = 0;
+    bool _stop = false;
+
+    std::thread _thread;
+};
+
+#endif
@@ -18,6 +18,7 @@
 #include "Metric.h"
 #include "Config.h"
 #include "Log.h"
+#include "MetricEndpoint.h"
 #include "SteadyTimer.h"
 #include "Strand.h"
 #include "Tokenize.h"
@@ -45,6 +46,7 @@ void Metric::Initialize(std::string const& realmName, Acore::Asio::IoContext& io
     _batchTimer = std::make_unique<boost::asio::steady_timer>(ioContext);
     _overallStatusTimer = std::make_unique<boost::asio::steady_timer>(ioContext);
     _overallStatusLogger = overallStatusLogger;
+    _ioContext = &ioContext;
     LoadFromConfigs();
 }
 
@@ -95,6 +97,8 @@ void Metric::LoadFromConfigs()
         _thresholds[thresholdName] = thresholdValue;
     }
 
+    LoadEndpointConfig();
+
     // Schedule a send at this point only if the config changed from Disabled to Enabled.
     // Cancel any scheduled operation if the config changed from Enabled to Disabled.
     if (_enabled && !previousValue)
@@ -147,6 +151,31 @@ void Metric::LoadFromConfigs()
     }
 }
 
+void Metric::LoadEndpointConfig()
+{
+    bool enabled = sConfigMgr->GetOption<bool>("Metric.Prometheus.Enable", false);
+    std::string bindIp = sConfigMgr->GetOption<std::string>("Metric.Prometheus.BindIP", "127.0.0.1");
+    uint16 port = uint16(sConfigMgr->GetOption<int32>("Metric.Prometheus.Port", 9105));
+    std::string address = enabled ? bindIp + ':' + std::to_string(port) : "";
+
+    // Only restart the listener if the address changed on reload
+    if (!_ioContext || address == _endpointAddress)
+        return;
+
+    // Runs on the thread reloading the config, the acceptor is closed on the io context
+    if (_endpoint)
+        _endpoint->Close();
+
+    _endpoint.reset();
+    _endpointAddress = address;
+    if (!enabled)
+        return;
+
+    _endpoint = std::make_shared<MetricEndpoint>(*_ioContext, [this]() { return _registry.Render(); });
+    if (!_endpoint->Start(bindIp, port))
+        _endpoint.reset();
+}
+
 void Metric::Update()
 {
     if (_overallStatusTimerTriggered)
@@ -308,6 +337,10 @@ void Metric::Unload()
 
     _batchTimer->cancel();
     _overallStatusTimer->cancel();
+    if (_endpoint)
+        _endpoint->Close();
+
+    _endpoint.reset();
 }
 
 void Metric::ScheduleOverallStatusLog()
@@ -21,6 +21,7 @@
 #include "Define.h"
 #include "Duration.h"
 #include "MPSCQueue.h"
+#include "MetricRegistry.h"
 #include <boost/asio/steady_timer.hpp>
 #include <functional>
 #include <memory> // NOTE: this import is NEEDED (even though some IDEs report it as unused)
@@ -33,14 +34,14 @@ namespace Acore::Asio
     class IoContext;
 }
 
+class MetricEndpoint;
+
 enum MetricDataType
 {
     METRIC_DATA_VALUE,
     METRIC_DATA_EVENT
 };
 
-typedef std::pair<std::string, std::string> MetricTag;
-
 struct MetricData
 {
     std::string Category;
@@ -78,11 +79,16 @@ private:
     std::function<void()> _overallStatusLogger;
     std::string _realmName;
     std::unordered_map<std::string, int64> _thresholds;
+    Acore::Asio::IoContext* _ioContext = nullptr;
+    MetricRegistry _registry;
+    std::shared_ptr<MetricEndpoint> _endpoint;
+    std::string _endpointAddress;
 
     bool Connect();
     void SendBatch();
     void ScheduleSend();
     void ScheduleOverallStatusLog();
+    void LoadEndpointConfig();
 
     static std::string FormatInfluxDBValue(bool value);
 
@@ -129,6 +135,9 @@ public:
 
     void Unload();
     bool IsEnabled() const { return _enabled; }
+
+    /// Aggregated metrics, recorded regardless of Metric.Enable and served by the Prometheus endpoint
+    MetricRegistry& GetRegistry() { return _registry; }
 };
 
 #define sMetric Metric::instance()
@@ -160,6 +169,17 @@ MetricStopWatch<LoggerType> MakeMetricStopWatch(LoggerType&& loggerFunc)
     return { std::forward<LoggerType>(loggerFunc) };
 }
 
+class MetricHistogramTimer
+{
+public:
+    explicit MetricHistogramTimer(MetricHistogram& histogram) : _histogram(histogram), _startTime(std::chrono::steady_clock::now()) { }
+    ~MetricHistogramTimer() { _histogram.Observe(std::chrono::steady_clock::now() - _startTime); }
+
+private:
+    MetricHistogram& _histogram;
+    TimePoint _startTime;
+};
+
 #define METRIC_TAG(name, value) { name, value }
 
 #define METRIC_DO_CONCAT(a, b) a##b
@@ -173,6 +193,8 @@ MetricStopWatch<LoggerType> MakeMetricStopWatch(LoggerType&& loggerFunc)
 #define METRIC_DETAILED_EVENT(category, title, description) ((void)0)
 #define METRIC_DETAILED_TIMER(category, ...) ((void)0)
 #define METRIC_DETAILED_NO_THRESHOLD_TIMER(category, ...) ((void)0)
+#define METRIC_HISTOGRAM_TIMER(histogram) ((void)0)
+#define METRIC_HISTOGRAM_OBSERVE(histogram, value) ((void)0)
 #else
 #if AC_PLATFORM != AC_PLATFORM_WINDOWS
 #define METRIC_EVENT(category, title, description)                  \
@@ -208,6 +230,9 @@ MetricStopWatch<LoggerType> MakeMetricStopWatch(LoggerType&& loggerFunc)
         {                                                                                                        \
             sMetric->LogValue(category, std::chrono::steady_clock::now() - start, { __VA_ARGS__ });              \
         });
+#define METRIC_HISTOGRAM_TIMER(histogram)                                                                     \
+        MetricHistogramTimer METRIC_UNIQUE_NAME(__ac_metric_histogram_timer)(histogram);
+#define METRIC_HISTOGRAM_OBSERVE(histogram, value) (histogram).Observe(value)
 #if defined WITH_DETAILED_METRICS
 #define METRIC_DETAILED_TIMER(category, ...)                                                                  \
         MetricStopWatch METRIC_UNIQUE_NAME(__ac_metric_stop_watch) = MakeMetricStopWatch([&](TimePoint start) \
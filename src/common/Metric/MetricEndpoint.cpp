@@ -0,0 +1,164 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MetricEndpoint.h"
+#include "IoContext.h"
+#include "IpAddress.h"
+#include "Log.h"
+#include "StringFormat.h"
+#include <boost/asio/post.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+namespace
+{
+    constexpr std::size_t MAX_REQUEST_SIZE = 8192;
+    // An idle or slow scraper must not keep its socket open
+    constexpr std::chrono::seconds REQUEST_TIMEOUT = std::chrono::seconds(10);
+
+    class MetricEndpointConnection : public std::enable_shared_from_this<MetricEndpointConnection>
+    {
+    public:
+        MetricEndpointConnection(boost::asio::ip::tcp::socket&& socket, std::function<std::string()> const& render) :
+            _socket(std::move(socket)), _timeout(_socket.get_executor()), _request(MAX_REQUEST_SIZE), _render(render) { }
+
+        void Start()
+        {
+            auto self = shared_from_this();
+            _timeout.expires_after(REQUEST_TIMEOUT);
+            _timeout.async_wait([self](boost::system::error_code const& error)
+            {
+                if (!error)
+                    self->Shutdown();
+            });
+
+            boost::asio::async_read_until(_socket, _request, "\r\n\r\n", [self](boost::system::error_code const& error, std::size_t /*length*/)
+            {
+                if (!error)
+                    self->Respond();
+                else
+                    self->_timeout.cancel();
+            });
+        }
+
+    private:
+        void Respond()
+        {
+            std::istream request(&_request);
+            std::string method, path;
+            request >> method >> path;
+
+            std::string body;
+            std::string status = "200 OK";
+            if (method != "GET")
+                status = "405 Method Not Allowed";
+            else if (path != "/metrics")
+                status = "404 Not Found";
+            else
+                body = _render();
+
+            _response = Acore::StringFormat("HTTP/1.1 {}\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\nContent-Length: {}\r\nConnection: close\r\n\r\n{}",
+                status, body.size(), body);
+
+            auto self = shared_from_this();
+            boost::asio::async_write(_socket, boost::asio::buffer(_response), [self](boost::system::error_code const& /*error*/, std::size_t /*length*/)
+            {
+                self->_timeout.cancel();
+                self->Shutdown();
+            });
+        }
+
+        void Shutdown()
+        {
+            boost::system::error_code ignored;
+            _socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+            _socket.close(ignored);
+        }
+
+        // Both run on the strand of the connection
+        boost::asio::ip::tcp::socket _socket;
+        boost::asio::steady_timer _timeout;
+        boost::asio::streambuf _request;
+        std::string _response;
+        std::function<std::string()> _render;
+    };
+}
+
+MetricEndpoint::MetricEndpoint(Acore::Asio::IoContext& ioContext, std::function<std::string()> render) :
+    _acceptor(boost::asio::make_strand(ioContext.get_executor())), _render(std::move(render))
+{
+}
+
+bool MetricEndpoint::Start(std::string const& bindIp, uint16 port)
+{
+    boost::system::error_code error;
+    boost::asio::ip::tcp::endpoint endpoint(Acore::Net::make_address(bindIp, error), port);
+    if (error)
+    {
+        LOG_ERROR("metric", "Metric.Prometheus.BindIP '{}' is not a valid address: {}", bindIp, error.message());
+        return false;
+    }
+
+    _acceptor.open(endpoint.protocol(), error);
+    if (!error)
+        _acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true), error);
+    if (!error)
+        _acceptor.bind(endpoint, error);
+    if (!error)
+        _acceptor.listen(boost::asio::socket_base::max_listen_connections, error);
+
+    if (error)
+    {
+        LOG_ERROR("metric", "Could not listen for metric scrapes on {}:{}: {}", bindIp, port, error.message());
+        boost::system::error_code ignored;
+        _acceptor.close(ignored);
+        return false;
+    }
+
+    LOG_INFO("metric", "Serving metrics on http://{}:{}/metrics", bindIp, port);
+    AsyncAccept();
+    return true;
+}
+
+void MetricEndpoint::Close()
+{
+    boost::asio::post(_acceptor.get_executor(), [self = shared_from_this()]()
+    {
+        boost::system::error_code ignored;
+        self->_acceptor.close(ignored);
+    });
+}
+
+void MetricEndpoint::AsyncAccept()
+{
+    // Every connection gets its own strand, its timeout and socket handlers never run at the same time
+    _acceptor.async_accept(boost::asio::make_strand(Acore::Asio::get_io_context(_acceptor)),
+        [self = shared_from_this()](boost::system::error_code const& error, boost::asio::ip::tcp::socket socket)
+    {
+        if (error == boost::asio::error::operation_aborted)
+            return;
+
+        if (!error)
+            std::make_shared<MetricEndpointConnection>(std::move(socket), self->_render)->Start();
+
+        if (self->_acceptor.is_open())
+            self->AsyncAccept();
+    });
+}
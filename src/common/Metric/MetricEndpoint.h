@@ -0,0 +1,55 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef METRIC_ENDPOINT_H__
+#define METRIC_ENDPOINT_H__
+
+#include "Define.h"
+#include <boost/asio/ip/tcp.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace Acore::Asio
+{
+    class IoContext;
+}
+
+/**
+    Minimal HTTP listener answering GET /metrics with the text returned by the render callback,
+    meant to be scraped by Prometheus on a local or trusted address.
+
+    Everything runs on the io context, a scrape never blocks the threads that record metrics.
+    Must be owned by a shared_ptr, pending accepts keep the endpoint alive until Close() ran.
+*/
+class AC_COMMON_API MetricEndpoint : public std::enable_shared_from_this<MetricEndpoint>
+{
+public:
+    MetricEndpoint(Acore::Asio::IoContext& ioContext, std::function<std::string()> render);
+
+    bool Start(std::string const& bindIp, uint16 port);
+    // Closes the acceptor on the io context, safe to call from any thread
+    void Close();
+
+private:
+    void AsyncAccept();
+
+    boost::asio::ip::tcp::acceptor _acceptor;
+    std::function<std::string()> _render;
+};
+
+#endif // METRIC_ENDPOINT_H__
@@ -0,0 +1,230 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MetricRegistry.h"
+#include "Errors.h"
+#include "StringFormat.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    std::string EscapeLabelValue(std::string const& value)
+    {
+        std::string escaped;
+        escaped.reserve(value.size());
+        for (char c : value)
+        {
+            switch (c)
+            {
+                case '\\': escaped += "\\\\"; break;
+                case '"': escaped += "\\\""; break;
+                case '\n': escaped += "\\n"; break;
+                default: escaped += c; break;
+            }
+        }
+
+        return escaped;
+    }
+
+    std::string FormatValue(double value)
+    {
+        if (std::isinf(value))
+            return value > 0 ? "+Inf" : "-Inf";
+
+        return Acore::StringFormat("{}", value);
+    }
+
+    // extra is appended after the regular labels, histograms use it for the bucket bound
+    void AppendSample(std::string& out, std::string const& name, std::vector<MetricTag> const& labels, std::string_view value, MetricTag const* extra = nullptr)
+    {
+        out += name;
+        if (!labels.empty() || extra)
+        {
+            out += '{';
+            bool first = true;
+            auto appendLabel = [&](MetricTag const& label)
+            {
+                if (!first)
+                    out += ',';
+
+                out += Acore::StringFormat("{}=\"{}\"", label.first, EscapeLabelValue(label.second));
+                first = false;
+            };
+
+            for (MetricTag const& label : labels)
+                appendLabel(label);
+
+            if (extra)
+                appendLabel(*extra);
+
+            out += '}';
+        }
+
+        out += ' ';
+        out += value;
+        out += '\n';
+    }
+}
+
+MetricHistogram::MetricHistogram(std::vector<double> bounds) : _bounds(std::move(bounds)),
+    _buckets(std::make_unique<std::atomic<uint64>[]>(_bounds.size() + 1))
+{
+    ASSERT(std::is_sorted(_bounds.begin(), _bounds.end()), "Histogram bounds must be ascending");
+
+    for (std::size_t i = 0; i <= _bounds.size(); ++i)
+        _buckets[i].store(0, std::memory_order_relaxed);
+}
+
+void MetricHistogram::Observe(double value)
+{
+    std::size_t bucket = std::lower_bound(_bounds.begin(), _bounds.end(), value) - _bounds.begin();
+    _buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+    _sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+void MetricHistogram::Set(std::vector<uint64> const& buckets, double sum)
+{
+    ASSERT(buckets.size() == _bounds.size() + 1, "Histogram bucket count must match its bounds");
+
+    uint64 count = 0;
+    for (std::size_t i = 0; i < buckets.size(); ++i)
+    {
+        _buckets[i].store(buckets[i], std::memory_order_relaxed);
+        count += buckets[i];
+    }
+
+    _count.store(count, std::memory_order_relaxed);
+    _sum.store(sum, std::memory_order_relaxed);
+}
+
+std::vector<double> const& MetricHistogram::LatencyBounds()
+{
+    static std::vector<double> const bounds = { 0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0 };
+    return bounds;
+}
+
+MetricRegistry::Family& MetricRegistry::GetFamily(std::string const& name, FamilyType type, std::string const& help)
+{
+    auto [itr, inserted] = _families.try_emplace(name);
+    if (inserted)
+    {
+        itr->second.Type = type;
+        itr->second.Help = help;
+    }
+
+    ASSERT(itr->second.Type == type, "Metric {} was registered with another type", name);
+    return itr->second;
+}
+
+MetricCounter& MetricRegistry::GetCounter(std::string const& name, std::string const& help, std::vector<MetricTag> labels /*= {}*/)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    std::unique_ptr<MetricCounter>& counter = GetFamily(name, FamilyType::Counter, help).Counters[std::move(labels)];
+    if (!counter)
+        counter = std::make_unique<MetricCounter>();
+
+    return *counter;
+}
+
+MetricGauge& MetricRegistry::GetGauge(std::string const& name, std::string const& help, std::vector<MetricTag> labels /*= {}*/)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    std::unique_ptr<MetricGauge>& gauge = GetFamily(name, FamilyType::Gauge, help).Gauges[std::move(labels)];
+    if (!gauge)
+        gauge = std::make_unique<MetricGauge>();
+
+    return *gauge;
+}
+
+MetricHistogram& MetricRegistry::GetHistogram(std::string const& name, std::string const& help, std::vector<MetricTag> labels /*= {}*/,
+    std::vector<double> const& bounds /*= MetricHistogram::LatencyBounds()*/)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    Family& family = GetFamily(name, FamilyType::Histogram, help);
+    if (family.Histograms.empty())
+        family.Bounds = bounds;
+
+    std::unique_ptr<MetricHistogram>& histogram = family.Histograms[std::move(labels)];
+    if (!histogram)
+        histogram = std::make_unique<MetricHistogram>(family.Bounds);
+
+    return *histogram;
+}
+
+void MetricRegistry::AddCollector(Collector collector)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _collectors.push_back(std::move(collector));
+}
+
+std::string MetricRegistry::Render()
+{
+    std::vector<Collector> collectors;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        collectors = _collectors;
+    }
+
+    // Collectors look up their metrics, so they run without the lock
+    for (Collector const& collector : collectors)
+        collector(*this);
+
+    std::string out;
+    std::lock_guard<std::mutex> lock(_lock);
+
+    for (auto const& [name, family] : _families)
+    {
+        out += Acore::StringFormat("# HELP {} {}\n", name, family.Help);
+
+        switch (family.Type)
+        {
+            case FamilyType::Counter:
+                out += Acore::StringFormat("# TYPE {} counter\n", name);
+                for (auto const& [labels, counter] : family.Counters)
+                    AppendSample(out, name, labels, std::to_string(counter->GetValue()));
+                break;
+            case FamilyType::Gauge:
+                out += Acore::StringFormat("# TYPE {} gauge\n", name);
+                for (auto const& [labels, gauge] : family.Gauges)
+                    AppendSample(out, name, labels, FormatValue(gauge->GetValue()));
+                break;
+            case FamilyType::Histogram:
+                out += Acore::StringFormat("# TYPE {} histogram\n", name);
+                for (auto const& [labels, histogram] : family.Histograms)
+                {
+                    // Buckets are read one by one while other threads record, so the cumulative
+                    // counts are summed here and the total count is taken from them to stay consistent
+                    uint64 cumulative = 0;
+                    std::vector<double> const& bounds = histogram->GetBounds();
+                    for (std::size_t i = 0; i <= bounds.size(); ++i)
+                    {
+                        cumulative += histogram->GetBucketCount(i);
+                        MetricTag le("le", i < bounds.size() ? FormatValue(bounds[i]) : "+Inf");
+                        AppendSample(out, name + "_bucket", labels, std::to_string(cumulative), &le);
+                    }
+
+                    AppendSample(out, name + "_sum", labels, FormatValue(histogram->GetSum()));
+                    AppendSample(out, name + "_count", labels, std::to_string(cumulative));
+                }
+                break;
+        }
+    }
+
+    return out;
+}
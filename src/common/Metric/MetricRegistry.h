@@ -0,0 +1,135 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef METRIC_REGISTRY_H__
+#define METRIC_REGISTRY_H__
+
+#include "Define.h"
+#include "Duration.h"
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+typedef std::pair<std::string, std::string> MetricTag;
+
+/// Monotonic counter, safe to increment from any thread
+class AC_COMMON_API MetricCounter
+{
+public:
+    void Increment(uint64 value = 1) { _value.fetch_add(value, std::memory_order_relaxed); }
+    // For counters mirrored from another source by a collector, value must never decrease
+    void Set(uint64 value) { _value.store(value, std::memory_order_relaxed); }
+    [[nodiscard]] uint64 GetValue() const { return _value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64> _value{0};
+};
+
+/// Value that may go up and down, safe to set from any thread
+class AC_COMMON_API MetricGauge
+{
+public:
+    void Set(double value) { _value.store(value, std::memory_order_relaxed); }
+    void Add(double value) { _value.fetch_add(value, std::memory_order_relaxed); }
+    [[nodiscard]] double GetValue() const { return _value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> _value{0.0};
+};
+
+/// Distribution of observed values in fixed buckets, durations are recorded in seconds
+class AC_COMMON_API MetricHistogram
+{
+public:
+    // bounds are the inclusive upper limits of the buckets in ascending order, values above the last one go to +Inf
+    explicit MetricHistogram(std::vector<double> bounds);
+
+    void Observe(double value);
+    void Observe(std::chrono::nanoseconds duration) { Observe(std::chrono::duration<double>(duration).count()); }
+    // For histograms mirrored from another source by a collector, one count per bucket including +Inf, counts must never decrease
+    void Set(std::vector<uint64> const& buckets, double sum);
+
+    [[nodiscard]] std::vector<double> const& GetBounds() const { return _bounds; }
+    // Not cumulative, the last bucket counts the values above all bounds
+    [[nodiscard]] uint64 GetBucketCount(std::size_t bucket) const { return _buckets[bucket].load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64 GetCount() const { return _count.load(std::memory_order_relaxed); }
+    [[nodiscard]] double GetSum() const { return _sum.load(std::memory_order_relaxed); }
+
+    // 100us to 10s, for update and query times
+    static std::vector<double> const& LatencyBounds();
+
+private:
+    std::vector<double> const _bounds;
+    std::unique_ptr<std::atomic<uint64>[]> _buckets;
+    std::atomic<uint64> _count{0};
+    std::atomic<double> _sum{0.0};
+};
+
+/**
+    Aggregated metrics kept in process and rendered in the Prometheus text format on request.
+
+    Lookups take a lock and should be done once, the returned references stay valid for the lifetime
+    of the registry. Recording a value only touches atomics of that metric.
+*/
+class AC_COMMON_API MetricRegistry
+{
+public:
+    typedef std::function<void(MetricRegistry&)> Collector;
+
+    MetricCounter& GetCounter(std::string const& name, std::string const& help, std::vector<MetricTag> labels = {});
+    MetricGauge& GetGauge(std::string const& name, std::string const& help, std::vector<MetricTag> labels = {});
+    // bounds are only used by the first lookup of a name, every label set of a histogram shares them
+    MetricHistogram& GetHistogram(std::string const& name, std::string const& help, std::vector<MetricTag> labels = {},
+        std::vector<double> const& bounds = MetricHistogram::LatencyBounds());
+
+    // Runs before every Render(), for values that are aggregated elsewhere and only copied on request
+    void AddCollector(Collector collector);
+
+    // Runs the collectors first
+    [[nodiscard]] std::string Render();
+
+private:
+    enum class FamilyType
+    {
+        Counter,
+        Gauge,
+        Histogram
+    };
+
+    struct Family
+    {
+        FamilyType Type;
+        std::string Help;
+        std::vector<double> Bounds;
+        std::map<std::vector<MetricTag>, std::unique_ptr<MetricCounter>> Counters;
+        std::map<std::vector<MetricTag>, std::unique_ptr<MetricGauge>> Gauges;
+        std::map<std::vector<MetricTag>, std::unique_ptr<MetricHistogram>> Histograms;
+    };
+
+    Family& GetFamily(std::string const& name, FamilyType type, std::string const& help);
+
+    mutable std::mutex _lock;
+    std::map<std::string, Family> _families;
+    std::vector<Collector> _collectors;
+};
+
+#endif // METRIC_REGISTRY_H__
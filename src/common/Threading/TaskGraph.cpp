@@ -0,0 +1,136 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TaskGraph.h"
+#include "Errors.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+Acore::TaskGraph::TaskId Acore::TaskGraph::Add(std::string name, std::function<void()> task, std::initializer_list<TaskId> dependencies)
+{
+    TaskId id = _tasks.size();
+
+    for (TaskId dependency : dependencies)
+    {
+        ASSERT(dependency < id, "Task {} depends on a task that was not added before it", name);
+        _tasks[dependency].Dependents.push_back(id);
+    }
+
+    _tasks.push_back({ std::move(name), std::move(task), dependencies, {} });
+    return id;
+}
+
+void Acore::TaskGraph::Run(std::size_t threadCount)
+{
+    std::size_t const count = _tasks.size();
+
+    _timings.assign(count, {});
+    for (TaskId id = 0; id < count; ++id)
+        _timings[id].Name = _tasks[id].Name;
+
+    std::vector<std::size_t> pendingDependencies(count);
+    std::priority_queue<TaskId, std::vector<TaskId>, std::greater<TaskId>> ready;
+    for (TaskId id = 0; id < count; ++id)
+    {
+        pendingDependencies[id] = _tasks[id].Dependencies.size();
+        if (!pendingDependencies[id])
+            ready.push(id);
+    }
+
+    std::mutex lock;
+    std::condition_variable taskAvailable;
+    std::size_t finished = 0;
+    auto const start = std::chrono::steady_clock::now();
+
+    auto worker = [&]()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        for (;;)
+        {
+            taskAvailable.wait(guard, [&] { return !ready.empty() || finished == count; });
+            if (ready.empty())
+                return;
+
+            TaskId id = ready.top();
+            ready.pop();
+
+            guard.unlock();
+            auto const taskStart = std::chrono::steady_clock::now();
+            _tasks[id].Function();
+            auto const taskEnd = std::chrono::steady_clock::now();
+            guard.lock();
+
+            _timings[id].Start = std::chrono::duration_cast<Microseconds>(taskStart - start);
+            _timings[id].Duration = std::chrono::duration_cast<Microseconds>(taskEnd - taskStart);
+
+            ++finished;
+            for (TaskId dependent : _tasks[id].Dependents)
+                if (!--pendingDependencies[dependent])
+                    ready.push(dependent);
+
+            taskAvailable.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < std::min(threadCount, count); ++i)
+        threads.emplace_back(worker);
+
+    worker();
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    _totalTime = std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - start);
+    ComputeCriticalPath();
+}
+
+void Acore::TaskGraph::ComputeCriticalPath()
+{
+    std::size_t const count = _tasks.size();
+    if (!count)
+        return;
+
+    // Dependencies always have lower ids, so a single pass in id order sees every chain
+    std::vector<Microseconds> chainTime(count);
+    std::vector<TaskId> chainPrevious(count, count);
+    TaskId last = 0;
+
+    for (TaskId id = 0; id < count; ++id)
+    {
+        Microseconds longestDependency = Microseconds::zero();
+        for (TaskId dependency : _tasks[id].Dependencies)
+        {
+            if (chainPrevious[id] == count || chainTime[dependency] > longestDependency)
+            {
+                longestDependency = chainTime[dependency];
+                chainPrevious[id] = dependency;
+            }
+        }
+
+        chainTime[id] = longestDependency + _timings[id].Duration;
+        if (chainTime[id] > chainTime[last])
+            last = id;
+    }
+
+    _criticalPathTime = chainTime[last];
+    for (TaskId id = last; id != count; id = chainPrevious[id])
+        _timings[id].CriticalPath = true;
+}
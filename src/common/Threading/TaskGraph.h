@@ -0,0 +1,78 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_TASK_GRAPH_H
+#define ACORE_TASK_GRAPH_H
+
+#include "Define.h"
+#include "Duration.h"
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace Acore
+{
+    /**
+     * Runs a set of one-shot tasks that declare which other tasks they need.
+     *
+     * A task may only depend on tasks added before it, so the graph can not contain cycles and the
+     * order of Add() is always a valid serial order. Run(1) executes the tasks in exactly that order,
+     * more threads start every task as soon as all its dependencies finished, lowest id first.
+     */
+    class AC_COMMON_API TaskGraph
+    {
+    public:
+        typedef std::size_t TaskId;
+
+        struct TaskTiming
+        {
+            std::string Name;
+            Microseconds Start;     // relative to the start of Run()
+            Microseconds Duration;
+            bool CriticalPath;      // part of the dependency chain that bounds the total time
+        };
+
+        TaskId Add(std::string name, std::function<void()> task, std::initializer_list<TaskId> dependencies = {});
+
+        // Blocks until every task ran, the calling thread is one of the threadCount workers
+        void Run(std::size_t threadCount);
+
+        // Only valid after Run()
+        [[nodiscard]] std::vector<TaskTiming> const& GetTimings() const { return _timings; }
+        [[nodiscard]] Microseconds GetTotalTime() const { return _totalTime; }
+        [[nodiscard]] Microseconds GetCriticalPathTime() const { return _criticalPathTime; }
+
+    private:
+        struct Task
+        {
+            std::string Name;
+            std::function<void()> Function;
+            std::vector<TaskId> Dependencies;
+            std::vector<TaskId> Dependents;
+        };
+
+        void ComputeCriticalPath();
+
+        std::vector<Task> _tasks;
+        std::vector<TaskTiming> _timings;
+        Microseconds _totalTime = Microseconds::zero();
+        Microseconds _criticalPathTime = Microseconds::zero();
+    };
+}
+
+#endif
@@ -0,0 +1,247 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BufferPool.h"
+#include <algorithm>
+#include <mutex>
+#include <new>
+
+namespace
+{
+    using Acore::BufferPool;
+
+    // Bytes a single thread may keep cached per size class, the shared depot holds four times that
+    constexpr std::size_t THREAD_CACHE_BYTES = 0x80000;
+    constexpr std::size_t DEPOT_CACHE_BYTES = THREAD_CACHE_BYTES * 4;
+    constexpr std::size_t TRANSFER_BATCH = 32;
+
+    constexpr std::size_t GetThreadCacheLimit(std::size_t sizeClass)
+    {
+        return std::clamp<std::size_t>(THREAD_CACHE_BYTES / BufferPool::GetBlockSize(sizeClass), 8, 256);
+    }
+
+    constexpr std::size_t GetDepotLimit(std::size_t sizeClass)
+    {
+        return std::clamp<std::size_t>(DEPOT_CACHE_BYTES / BufferPool::GetBlockSize(sizeClass), 32, 1024);
+    }
+
+    struct Counters
+    {
+        std::atomic<uint64> Allocations{0};
+        std::atomic<uint64> Reused{0};
+        std::atomic<uint64> Deallocations{0};
+        std::atomic<uint64> Released{0};
+
+        void AddTo(BufferPool::SizeClassStats& stats) const
+        {
+            stats.Allocations += Allocations.load(std::memory_order_relaxed);
+            stats.Reused += Reused.load(std::memory_order_relaxed);
+            stats.Deallocations += Deallocations.load(std::memory_order_relaxed);
+            stats.Released += Released.load(std::memory_order_relaxed);
+        }
+    };
+
+    typedef std::array<Counters, BufferPool::SIZE_CLASS_COUNT + 1> ThreadStats;
+
+    // Counters of running threads, what exited threads counted and what was counted after a thread cache was gone
+    std::mutex StatsLock;
+    std::vector<ThreadStats const*> LiveStats;
+    std::array<BufferPool::SizeClassStats, BufferPool::SIZE_CLASS_COUNT + 1> RetiredStats;
+    ThreadStats OrphanStats;
+
+    struct Depot
+    {
+        std::mutex Lock;
+        std::vector<void*> Blocks;
+    };
+
+    std::array<Depot, BufferPool::SIZE_CLASS_COUNT> Depots;
+
+    struct ThreadCache;
+
+    void Count(ThreadCache* cache, std::size_t sizeClass, std::atomic<uint64> Counters::* counter);
+
+    void ReleaseBlock(void* block, std::size_t sizeClass, ThreadCache* cache)
+    {
+        ::operator delete(block);
+        Count(cache, sizeClass, &Counters::Released);
+    }
+
+    struct ThreadCache
+    {
+        std::array<std::vector<void*>, BufferPool::SIZE_CLASS_COUNT> Blocks;
+        ThreadStats Stats;
+
+        ThreadCache()
+        {
+            std::lock_guard<std::mutex> lock(StatsLock);
+            LiveStats.push_back(&Stats);
+        }
+
+        ~ThreadCache()
+        {
+            for (std::size_t sizeClass = 0; sizeClass < BufferPool::SIZE_CLASS_COUNT; ++sizeClass)
+            {
+                std::vector<void*>& blocks = Blocks[sizeClass];
+                Depot& depot = Depots[sizeClass];
+                {
+                    std::lock_guard<std::mutex> lock(depot.Lock);
+                    while (!blocks.empty() && depot.Blocks.size() < GetDepotLimit(sizeClass))
+                    {
+                        depot.Blocks.push_back(blocks.back());
+                        blocks.pop_back();
+                    }
+                }
+
+                for (void* block : blocks)
+                    ReleaseBlock(block, sizeClass, this);
+            }
+
+            std::lock_guard<std::mutex> lock(StatsLock);
+            std::erase(LiveStats, &Stats);
+            for (std::size_t sizeClass = 0; sizeClass <= BufferPool::SIZE_CLASS_COUNT; ++sizeClass)
+                Stats[sizeClass].AddTo(RetiredStats[sizeClass]);
+        }
+    };
+
+    void Count(ThreadCache* cache, std::size_t sizeClass, std::atomic<uint64> Counters::* counter)
+    {
+        if (cache)
+        {
+            // Written only by the thread of this cache, GetStats() reads them through LiveStats under
+            // StatsLock until ~ThreadCache adds them to RetiredStats
+            std::atomic<uint64>& value = cache->Stats[sizeClass].*counter;
+            value.store(value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+        else
+            (OrphanStats[sizeClass].*counter).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // The cache is reached through a plain pointer so buffers freed during thread (or static) teardown,
+    // after the cache itself is gone, still find their way back to the heap.
+    thread_local ThreadCache* t_cache = nullptr;
+    thread_local bool t_cacheDestroyed = false;
+
+    struct ThreadCacheHolder
+    {
+        ~ThreadCacheHolder()
+        {
+            delete t_cache;
+            t_cache = nullptr;
+            t_cacheDestroyed = true;
+        }
+    };
+
+    ThreadCache* GetThreadCache()
+    {
+        if (!t_cache && !t_cacheDestroyed)
+        {
+            thread_local ThreadCacheHolder holder;
+            t_cache = new ThreadCache();
+        }
+
+        return t_cache;
+    }
+}
+
+void* Acore::BufferPool::Allocate(std::size_t bytes)
+{
+    ThreadCache* cache = GetThreadCache();
+    if (bytes > MAX_BLOCK_SIZE)
+    {
+        Count(cache, SIZE_CLASS_COUNT, &Counters::Allocations);
+        return ::operator new(bytes);
+    }
+
+    std::size_t sizeClass = GetSizeClass(bytes);
+    Count(cache, sizeClass, &Counters::Allocations);
+
+    if (cache)
+    {
+        std::vector<void*>& blocks = cache->Blocks[sizeClass];
+        if (blocks.empty())
+        {
+            Depot& depot = Depots[sizeClass];
+            std::lock_guard<std::mutex> lock(depot.Lock);
+            std::size_t count = std::min(depot.Blocks.size(), TRANSFER_BATCH);
+            blocks.insert(blocks.end(), depot.Blocks.end() - count, depot.Blocks.end());
+            depot.Blocks.resize(depot.Blocks.size() - count);
+        }
+
+        if (!blocks.empty())
+        {
+            void* block = blocks.back();
+            blocks.pop_back();
+            Count(cache, sizeClass, &Counters::Reused);
+            return block;
+        }
+    }
+
+    return ::operator new(GetBlockSize(sizeClass));
+}
+
+void Acore::BufferPool::Deallocate(void* block, std::size_t bytes)
+{
+    if (!block)
+        return;
+
+    ThreadCache* cache = GetThreadCache();
+    if (bytes > MAX_BLOCK_SIZE)
+    {
+        Count(cache, SIZE_CLASS_COUNT, &Counters::Deallocations);
+        ::operator delete(block);
+        return;
+    }
+
+    std::size_t sizeClass = GetSizeClass(bytes);
+    Count(cache, sizeClass, &Counters::Deallocations);
+
+    if (!cache)
+    {
+        ReleaseBlock(block, sizeClass, cache);
+        return;
+    }
+
+    std::vector<void*>& blocks = cache->Blocks[sizeClass];
+    if (blocks.size() >= GetThreadCacheLimit(sizeClass))
+    {
+        // Hand a batch over to the depot so threads that mostly allocate can pick it up
+        Depot& depot = Depots[sizeClass];
+        std::lock_guard<std::mutex> lock(depot.Lock);
+        std::size_t count = std::min({ blocks.size(), TRANSFER_BATCH, GetDepotLimit(sizeClass) - std::min(depot.Blocks.size(), GetDepotLimit(sizeClass)) });
+        depot.Blocks.insert(depot.Blocks.end(), blocks.end() - count, blocks.end());
+        blocks.resize(blocks.size() - count);
+    }
+
+    if (blocks.size() < GetThreadCacheLimit(sizeClass))
+        blocks.push_back(block);
+    else
+        ReleaseBlock(block, sizeClass, cache);
+}
+
+Acore::BufferPool::SizeClassStats Acore::BufferPool::GetStats(std::size_t sizeClass)
+{
+    sizeClass = std::min(sizeClass, SIZE_CLASS_COUNT);
+
+    std::lock_guard<std::mutex> lock(StatsLock);
+    SizeClassStats stats = RetiredStats[sizeClass];
+    OrphanStats[sizeClass].AddTo(stats);
+    for (ThreadStats const* threadStats : LiveStats)
+        (*threadStats)[sizeClass].AddTo(stats);
+
+    return stats;
+}
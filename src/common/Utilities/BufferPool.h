@@ -0,0 +1,89 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_BUFFER_POOL_H
+#define ACORE_BUFFER_POOL_H
+
+#include "Define.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace Acore
+{
+    /**
+     * Size classed pool for network buffer storage (ByteBuffer, MessageBuffer).
+     *
+     * Blocks are powers of two between MIN_BLOCK_SIZE and MAX_BLOCK_SIZE, larger requests go straight to the heap.
+     * Every thread keeps a small cache per size class, blocks freed on another thread (a packet built by a map
+     * thread and released by a network thread) flow back through a shared depot.
+     */
+    class AC_COMMON_API BufferPool
+    {
+    public:
+        static constexpr std::size_t MIN_BLOCK_SIZE = 0x100;
+        static constexpr std::size_t MAX_BLOCK_SIZE = 0x10000;
+        static constexpr std::size_t SIZE_CLASS_COUNT = 9;
+
+        struct SizeClassStats
+        {
+            uint64 Allocations = 0;     // requests served for this size class
+            uint64 Reused = 0;          // ... of which were recycled blocks
+            uint64 Deallocations = 0;
+            uint64 Released = 0;        // blocks returned to the heap because every cache was full
+        };
+
+        static void* Allocate(std::size_t bytes);
+        static void Deallocate(void* block, std::size_t bytes);
+
+        static constexpr std::size_t GetSizeClass(std::size_t bytes)
+        {
+            std::size_t sizeClass = 0;
+            while ((MIN_BLOCK_SIZE << sizeClass) < bytes)
+                ++sizeClass;
+
+            return sizeClass;
+        }
+
+        static constexpr std::size_t GetBlockSize(std::size_t sizeClass) { return MIN_BLOCK_SIZE << sizeClass; }
+
+        // Index SIZE_CLASS_COUNT holds the requests larger than MAX_BLOCK_SIZE. Every thread counts on its own,
+        // this sums them up under a lock and is meant for periodic reporting only
+        static SizeClassStats GetStats(std::size_t sizeClass);
+    };
+
+    template<class T>
+    class PooledAllocator
+    {
+    public:
+        typedef T value_type;
+
+        PooledAllocator() noexcept = default;
+        template<class U> PooledAllocator(PooledAllocator<U> const& /*other*/) noexcept { }
+
+        T* allocate(std::size_t count) { return static_cast<T*>(BufferPool::Allocate(count * sizeof(T))); }
+        void deallocate(T* block, std::size_t count) noexcept { BufferPool::Deallocate(block, count * sizeof(T)); }
+
+        template<class U> bool operator==(PooledAllocator<U> const& /*other*/) const noexcept { return true; }
+        template<class U> bool operator!=(PooledAllocator<U> const& /*other*/) const noexcept { return false; }
+    };
+
+    typedef std::vector<uint8, PooledAllocator<uint8>> PooledByteStorage;
+}
+
+#endif
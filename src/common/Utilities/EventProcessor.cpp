@@ -17,6 +17,16 @@
 
 #include "EventProcessor.h"
 #include "Errors.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+
+struct EventProcessor::TimerWheel
+{
+    std::array<uint64, WHEEL_LEVELS> Occupied{};    // can keep the bit of a slot emptied by a removal until it is visited
+    std::array<std::array<BasicEvent*, WHEEL_SIZE>, WHEEL_LEVELS> Slots{};
+    BasicEvent* Overflow{nullptr};                  // due after the range covered by the last level, unsorted
+};
 
 void BasicEvent::ScheduleAbort()
 {
@@ -32,6 +42,13 @@ void BasicEvent::SetAborted()
     m_abortState = AbortState::STATE_ABORTED;
 }
 
+EventProcessor::EventProcessor() = default;
+
+EventProcessor::EventProcessor(EventProcessor const& other) : m_time(other.m_time), m_wheelTime(other.m_time), m_aborting(false)
+{
+    ASSERT(!other.HaveEventList(), "Tried to copy an EventProcessor that still has events");
+}
+
 EventProcessor::~EventProcessor()
 {
     KillAllEvents(true);
@@ -43,12 +60,21 @@ void EventProcessor::Update(uint32 p_time)
     m_time += p_time;
 
     // main event loop
-    EventList::iterator i;
-    while (((i = m_events.begin()) != m_events.end()) && i->first <= m_time)
+    for (;;)
     {
+        if (!m_sorted || m_sorted->m_execTime > m_wheelTime)
+        {
+            if (m_wheelTime >= m_time)
+                break;
+
+            Advance();
+            continue;
+        }
+
         // get and remove event from queue
-        BasicEvent* event = i->second;
-        m_events.erase(i);
+        BasicEvent* event = m_sorted;
+        Unlink(event);
+        --m_eventCount;
 
         if (event->IsRunning())
         {
@@ -77,59 +103,74 @@ void EventProcessor::Update(uint32 p_time)
         // the next update tick
         AddEvent(event, CalculateTime(1), false);
     }
+
+    if (m_wheel && m_eventCount <= SORTED_LIST_LIMIT / 2)
+        StopWheel();
 }
 
 void EventProcessor::KillAllEvents(bool force)
 {
-    // first, abort all existing events
-    for (auto itr = m_events.begin(); itr != m_events.end();)
+    BasicEvent* events = DetachAll();
+    while (BasicEvent* event = events)
     {
+        events = event->m_next;
+        event->m_next = nullptr;
+
         // Abort events which weren't aborted already
-        if (!itr->second->IsAborted())
+        if (!event->IsAborted())
         {
-            itr->second->SetAborted();
-            itr->second->Abort(m_time);
+            event->SetAborted();
+            event->Abort(m_time);
         }
 
-        // Skip non-deletable events when we are
+        // Keep non-deletable events when we are
         // not forcing the event cancellation.
-        if (!force && !itr->second->IsDeletable())
+        if (!force && !event->IsDeletable())
         {
-            ++itr;
+            ++m_eventCount;
+            Schedule(event);
             continue;
         }
 
-        delete itr->second;
-
-        if (force)
-            ++itr; // Clear the whole container when forcing
-        else
-            itr = m_events.erase(itr);
+        delete event;
     }
-
-    if (force)
-        m_events.clear();
 }
 
 void EventProcessor::CancelEventGroup(uint8 group)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end();)
+    // Unlink first, Abort() of one event may cancel or add others
+    BasicEvent* cancelled = nullptr;
+    BasicEvent** cancelledTail = &cancelled;
+    ForEachList([&](BasicEvent*& head, bool /*newestFirst*/)
     {
-        if (itr->second->m_eventGroup != group)
+        for (BasicEvent* event = head; event;)
         {
-            ++itr;
-            continue;
+            BasicEvent* next = event->m_next;
+            if (event->m_eventGroup == group)
+            {
+                Unlink(event);
+                --m_eventCount;
+                *cancelledTail = event;
+                cancelledTail = &event->m_next;
+            }
+
+            event = next;
         }
+    });
+
+    while (BasicEvent* event = cancelled)
+    {
+        cancelled = event->m_next;
+        event->m_next = nullptr;
 
         // Abort events which weren't aborted already
-        if (!itr->second->IsAborted())
+        if (!event->IsAborted())
         {
-            itr->second->SetAborted();
-            itr->second->Abort(m_time);
+            event->SetAborted();
+            event->Abort(m_time);
         }
 
-        delete itr->second;
-        itr = m_events.erase(itr);
+        delete event;
     }
 }
 
@@ -139,21 +180,19 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
         Event->m_addTime = m_time;
     Event->m_execTime = e_time;
     Event->m_eventGroup = eventGroup;
-    m_events.emplace(e_time, Event);
+    ++m_eventCount;
+    Schedule(Event);
 }
 
 void EventProcessor::ModifyEventTime(BasicEvent* event, Milliseconds newTime)
 {
-    for (auto itr = m_events.begin(); itr != m_events.end(); ++itr)
-    {
-        if (itr->second != event)
-            continue;
+    // not queued, executing right now or already removed
+    if (!event->m_prevNext)
+        return;
 
-        event->m_execTime = newTime.count();
-        m_events.erase(itr);
-        m_events.emplace(newTime.count(), event);
-        break;
-    }
+    Unlink(event);
+    event->m_execTime = newTime.count();
+    Schedule(event);
 }
 
 uint64 EventProcessor::CalculateTime(uint64 t_offset) const
@@ -165,3 +204,247 @@ uint64 EventProcessor::CalculateQueueTime(uint64 delay) const
 {
     return CalculateTime(delay - (m_time % delay));
 }
+
+void EventProcessor::LinkFront(BasicEvent*& head, BasicEvent* event)
+{
+    event->m_next = head;
+    if (head)
+        head->m_prevNext = &event->m_next;
+
+    event->m_prevNext = &head;
+    head = event;
+}
+
+void EventProcessor::Unlink(BasicEvent* event)
+{
+    *event->m_prevNext = event->m_next;
+    if (event->m_next)
+        event->m_next->m_prevNext = event->m_prevNext;
+
+    event->m_next = nullptr;
+    event->m_prevNext = nullptr;
+}
+
+void EventProcessor::Schedule(BasicEvent* event)
+{
+    uint64 const time = event->m_execTime;
+
+    if (!m_wheel && m_eventCount > SORTED_LIST_LIMIT)
+        StartWheel();
+
+    if (!m_wheel || time <= m_wheelTime)
+    {
+        // Behind every event with the same or an earlier time
+        BasicEvent** link = &m_sorted;
+        while (*link && (*link)->m_execTime <= time)
+            link = &(*link)->m_next;
+
+        LinkFront(*link, event);
+        return;
+    }
+
+    // The lowest level whose slot range still contains the current time, above that the bits differ
+    uint64 const differentBits = time ^ m_wheelTime;
+    for (uint32 level = 0; level < WHEEL_LEVELS; ++level)
+    {
+        if (differentBits >> (WHEEL_BITS * (level + 1)))
+            continue;
+
+        uint32 const slot = uint32(time >> (WHEEL_BITS * level)) & (WHEEL_SIZE - 1);
+        LinkFront(m_wheel->Slots[level][slot], event);
+        m_wheel->Occupied[level] |= uint64(1) << slot;
+        m_wheelNextVisit = std::min(m_wheelNextVisit, time & ~((uint64(1) << (WHEEL_BITS * level)) - 1));
+        return;
+    }
+
+    LinkFront(m_wheel->Overflow, event);
+    m_wheelNextVisit = std::min(m_wheelNextVisit, (m_wheelTime | ((uint64(1) << (WHEEL_BITS * WHEEL_LEVELS)) - 1)) + 1);
+}
+
+void EventProcessor::StartWheel()
+{
+    m_wheel = std::make_unique<TimerWheel>();
+
+    // Only events that are already due stay in the list
+    BasicEvent** link = &m_sorted;
+    while (*link && (*link)->m_execTime <= m_wheelTime)
+        link = &(*link)->m_next;
+
+    BasicEvent* events = *link;
+    *link = nullptr;
+    while (BasicEvent* event = events)
+    {
+        events = event->m_next;
+        event->m_next = nullptr;
+        event->m_prevNext = nullptr;
+        Schedule(event);
+    }
+}
+
+void EventProcessor::StopWheel()
+{
+    std::size_t const count = m_eventCount;
+    BasicEvent* events = DetachAll();
+    m_wheel.reset();
+    m_eventCount = count;
+
+    while (BasicEvent* event = events)
+    {
+        events = event->m_next;
+        event->m_next = nullptr;
+        Schedule(event);
+    }
+}
+
+void EventProcessor::Advance()
+{
+    while ((!m_sorted || m_sorted->m_execTime > m_wheelTime) && m_wheelTime < m_time)
+    {
+        // Jump straight to the next slot holding events, the ones in between are empty
+        if (m_wheelNextVisit > m_time)
+        {
+            m_wheelTime = m_time;
+            break;
+        }
+
+        TimerWheel& wheel = *m_wheel;
+        uint64 const now = m_wheelNextVisit;
+        m_wheelTime = now;
+
+        // Entering a new range of a level pulls the events of its slot down, upper levels first
+        if (wheel.Overflow && !(now & ((uint64(1) << (WHEEL_BITS * WHEEL_LEVELS)) - 1)))
+            CascadeSlot(wheel.Overflow);
+
+        for (uint32 level = WHEEL_LEVELS - 1; level > 0; --level)
+        {
+            if (now & ((uint64(1) << (WHEEL_BITS * level)) - 1))
+                continue;
+
+            uint32 const slot = uint32(now >> (WHEEL_BITS * level)) & (WHEEL_SIZE - 1);
+            if (wheel.Occupied[level] & (uint64(1) << slot))
+            {
+                wheel.Occupied[level] &= ~(uint64(1) << slot);
+                CascadeSlot(wheel.Slots[level][slot]);
+            }
+        }
+
+        uint32 const slot = uint32(now) & (WHEEL_SIZE - 1);
+        if (wheel.Occupied[0] & (uint64(1) << slot))
+            DrainSlot(wheel.Slots[0][slot]);
+
+        m_wheelNextVisit = FindNextVisit();
+    }
+}
+
+uint64 EventProcessor::FindNextVisit() const
+{
+    if (!m_wheel)
+        return ~uint64(0);
+
+    // Slots after the current one on each level, a lower level always comes first
+    for (uint32 level = 0; level < WHEEL_LEVELS; ++level)
+    {
+        uint32 const shift = WHEEL_BITS * level;
+        uint32 const current = uint32(m_wheelTime >> shift) & (WHEEL_SIZE - 1);
+        uint64 const later = current + 1 < WHEEL_SIZE ? m_wheel->Occupied[level] & (~uint64(0) << (current + 1)) : 0;
+        if (later)
+            return (m_wheelTime & ~((uint64(1) << (shift + WHEEL_BITS)) - 1)) + (uint64(std::countr_zero(later)) << shift);
+    }
+
+    if (m_wheel->Overflow)
+        return (m_wheelTime | ((uint64(1) << (WHEEL_BITS * WHEEL_LEVELS)) - 1)) + 1;
+
+    return ~uint64(0);
+}
+
+void EventProcessor::CascadeSlot(BasicEvent*& slot)
+{
+    // Reverse into the order the events were added, so events with the same time keep it in their new slot
+    BasicEvent* events = nullptr;
+    while (BasicEvent* event = slot)
+    {
+        slot = event->m_next;
+        event->m_next = events;
+        events = event;
+    }
+
+    while (BasicEvent* event = events)
+    {
+        events = event->m_next;
+        event->m_next = nullptr;
+        event->m_prevNext = nullptr;
+        Schedule(event);
+    }
+}
+
+void EventProcessor::DrainSlot(BasicEvent*& slot)
+{
+    // Every event of a first level slot has the same time, which is now the latest one that is due
+    m_wheel->Occupied[0] &= ~(uint64(1) << (m_wheelTime & (WHEEL_SIZE - 1)));
+
+    BasicEvent** tail = &m_sorted;
+    while (*tail)
+        tail = &(*tail)->m_next;
+
+    BasicEvent* events = slot;
+    slot = nullptr;
+    while (BasicEvent* event = events)
+    {
+        events = event->m_next;
+        LinkFront(*tail, event);
+    }
+}
+
+template<typename Visitor>
+void EventProcessor::ForEachList(Visitor&& visitor)
+{
+    visitor(m_sorted, false);
+
+    if (!m_wheel)
+        return;
+
+    for (uint32 level = 0; level < WHEEL_LEVELS; ++level)
+        for (uint64 occupied = m_wheel->Occupied[level]; occupied; occupied &= occupied - 1)
+            visitor(m_wheel->Slots[level][std::countr_zero(occupied)], true);
+
+    visitor(m_wheel->Overflow, true);
+}
+
+BasicEvent* EventProcessor::DetachAll()
+{
+    BasicEvent* events = nullptr;
+    BasicEvent** tail = &events;
+    ForEachList([&](BasicEvent*& head, bool newestFirst)
+    {
+        BasicEvent* list = head;
+        head = nullptr;
+
+        if (newestFirst)
+        {
+            BasicEvent* reversed = nullptr;
+            while (BasicEvent* event = list)
+            {
+                list = event->m_next;
+                event->m_next = reversed;
+                reversed = event;
+            }
+
+            list = reversed;
+        }
+
+        for (BasicEvent* event = list; event; event = event->m_next)
+        {
+            event->m_prevNext = nullptr;
+            *tail = event;
+            tail = &event->m_next;
+        }
+    });
+
+    if (m_wheel)
+        m_wheel->Occupied.fill(0);
+
+    m_wheelNextVisit = ~uint64(0);
+
+    m_eventCount = 0;
+    return events;
+}
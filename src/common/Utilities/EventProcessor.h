@@ -21,7 +21,8 @@
 #include "Define.h"
 #include "Duration.h"
 #include "Random.h"
-#include <map>
+#include "SmallObjectPool.h"
+#include <memory>
 
 class EventProcessor;
 
@@ -56,6 +57,10 @@ class BasicEvent
         // Aborts the event at the next update tick
         void ScheduleAbort();
 
+        // Events are created and destroyed constantly, keep them in slabs instead of the general heap
+        static void* operator new(std::size_t size) { return Acore::SmallObjectPool::Allocate(size); }
+        static void operator delete(void* event, std::size_t size) { Acore::SmallObjectPool::Deallocate(event, size); }
+
     private:
         void SetAborted();
         [[nodiscard]] bool IsRunning() const { return (m_abortState == AbortState::STATE_RUNNING); }
@@ -68,6 +73,10 @@ class BasicEvent
         uint64 m_addTime{0};                                   // time when the event was added to queue, filled by event handler
         uint64 m_execTime{0};                                  // planned time of next execution, filled by event handler
         uint8 m_eventGroup{0};
+
+        // intrusive link into the list of the EventProcessor holding the event, m_prevNext is nullptr while not queued
+        BasicEvent* m_next{nullptr};
+        BasicEvent** m_prevNext{nullptr};
 };
 
 template<typename T>
@@ -90,14 +99,31 @@ class LambdaBasicEvent : public BasicEvent
 template<typename T>
 using is_lambda_event = std::enable_if_t<!std::is_base_of_v<BasicEvent, std::remove_pointer_t<std::remove_cvref_t<T>>>>;
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
-
+/**
+ * Queue of timed events. Events run in order of their execution time, events with the same time in the order
+ * they were added.
+ *
+ * Most objects only have a handful of events, those are kept in a sorted intrusive list. Once an object has more
+ * than SORTED_LIST_LIMIT events they move to a hierarchical timing wheel: events due within the next WHEEL_SIZE ms
+ * sit in the slot of their exact time on the first level, later ones in coarser slots of the upper levels (or an
+ * unsorted overflow list past the last level) and move down whenever the time reaches their slot. Adding, moving
+ * and removing an event is then O(1) and Update() only visits slots that hold events.
+ */
 class EventProcessor
 {
     public:
-        EventProcessor()  = default;
+        static constexpr uint32 WHEEL_BITS = 6;
+        static constexpr uint32 WHEEL_SIZE = 1 << WHEEL_BITS;
+        static constexpr uint32 WHEEL_LEVELS = 3;
+        static constexpr std::size_t SORTED_LIST_LIMIT = 8;
+
+        EventProcessor();
         ~EventProcessor();
 
+        // Events are owned by one processor, only an empty one can be copied (battleground templates)
+        EventProcessor(EventProcessor const& other);
+        EventProcessor& operator=(EventProcessor const&) = delete;
+
         void Update(uint32 p_time);
         void KillAllEvents(bool force);
 
@@ -120,11 +146,31 @@ class EventProcessor
         [[nodiscard]] uint64 CalculateQueueTime(uint64 delay) const;
 
         void CancelEventGroup(uint8 group);
-        bool HaveEventList() const { return !m_events.empty(); }
+        bool HaveEventList() const { return m_eventCount != 0; }
 
     protected:
+        struct TimerWheel;
+
+        static void LinkFront(BasicEvent*& head, BasicEvent* event);
+        static void Unlink(BasicEvent* event);
+
+        void Schedule(BasicEvent* event);
+        void StartWheel();
+        void StopWheel();
+        void Advance();
+        [[nodiscard]] uint64 FindNextVisit() const;
+        void CascadeSlot(BasicEvent*& slot);
+        void DrainSlot(BasicEvent*& slot);
+        template<typename Visitor>
+        void ForEachList(Visitor&& visitor);
+        [[nodiscard]] BasicEvent* DetachAll();
+
         uint64 m_time{0};
-        EventList m_events;
+        uint64 m_wheelTime{0};                  // every event due up to this time has left the wheel
+        uint64 m_wheelNextVisit{~uint64(0)};    // no wheel slot has to be looked at before this time
+        BasicEvent* m_sorted{nullptr};          // events not in the wheel, sorted by execution time
+        std::unique_ptr<TimerWheel> m_wheel;    // with a wheel m_sorted only holds events due at or before m_wheelTime
+        std::size_t m_eventCount{0};
         bool m_aborting;
 };
 
@@ -0,0 +1,196 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SmallObjectPool.h"
+#include <array>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace
+{
+    using Acore::SmallObjectPool;
+
+    constexpr std::size_t SLAB_SIZE = 0x10000;
+    constexpr std::size_t TRANSFER_BATCH = 64;
+    constexpr std::size_t THREAD_CACHE_LIMIT = TRANSFER_BATCH * 4;
+
+    struct FreeBlock
+    {
+        FreeBlock* Next;
+    };
+
+    // Chains of free blocks handed between threads, a chain is taken or given back as a whole
+    struct Depot
+    {
+        std::mutex Lock;
+        std::vector<FreeBlock*> Chains;
+        std::vector<void*> Slabs;
+    };
+
+    // Never destroyed, objects may still be freed during static teardown and the slabs have to outlive them
+    std::array<Depot, SmallObjectPool::SIZE_CLASS_COUNT>& GetDepots()
+    {
+        static auto* depots = new std::array<Depot, SmallObjectPool::SIZE_CLASS_COUNT>();
+        return *depots;
+    }
+
+    void PushChain(std::size_t sizeClass, FreeBlock* chain)
+    {
+        Depot& depot = GetDepots()[sizeClass];
+        std::lock_guard<std::mutex> lock(depot.Lock);
+        depot.Chains.push_back(chain);
+    }
+
+    struct FreeList
+    {
+        FreeBlock* Head = nullptr;
+        std::size_t Count = 0;
+    };
+
+    struct ThreadCache
+    {
+        std::array<FreeList, SmallObjectPool::SIZE_CLASS_COUNT> Lists;
+
+        ~ThreadCache()
+        {
+            for (std::size_t sizeClass = 0; sizeClass < SmallObjectPool::SIZE_CLASS_COUNT; ++sizeClass)
+                if (Lists[sizeClass].Head)
+                    PushChain(sizeClass, Lists[sizeClass].Head);
+        }
+    };
+
+    // Same teardown handling as BufferPool, objects freed after the cache is gone go to the depot directly
+    thread_local ThreadCache* t_cache = nullptr;
+    thread_local bool t_cacheDestroyed = false;
+
+    struct ThreadCacheHolder
+    {
+        ~ThreadCacheHolder()
+        {
+            delete t_cache;
+            t_cache = nullptr;
+            t_cacheDestroyed = true;
+        }
+    };
+
+    ThreadCache* GetThreadCache()
+    {
+        if (!t_cache && !t_cacheDestroyed)
+        {
+            thread_local ThreadCacheHolder holder;
+            t_cache = new ThreadCache();
+        }
+
+        return t_cache;
+    }
+
+    // Takes a chain from the depot or carves a new slab, returns the number of blocks in the chain
+    std::size_t Refill(std::size_t sizeClass, FreeBlock*& chain)
+    {
+        Depot& depot = GetDepots()[sizeClass];
+        std::lock_guard<std::mutex> lock(depot.Lock);
+
+        if (!depot.Chains.empty())
+        {
+            chain = depot.Chains.back();
+            depot.Chains.pop_back();
+
+            std::size_t count = 0;
+            for (FreeBlock* block = chain; block; block = block->Next)
+                ++count;
+
+            return count;
+        }
+
+        std::size_t const blockSize = SmallObjectPool::GetBlockSize(sizeClass);
+        std::size_t const count = SLAB_SIZE / blockSize;
+        char* slab = static_cast<char*>(::operator new(SLAB_SIZE));
+        depot.Slabs.push_back(slab);
+
+        chain = nullptr;
+        for (std::size_t i = count; i > 0; --i)
+        {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + (i - 1) * blockSize);
+            block->Next = chain;
+            chain = block;
+        }
+
+        return count;
+    }
+}
+
+void* Acore::SmallObjectPool::Allocate(std::size_t bytes)
+{
+    if (bytes > MAX_OBJECT_SIZE)
+        return ::operator new(bytes);
+
+    std::size_t const sizeClass = GetSizeClass(bytes);
+    ThreadCache* cache = GetThreadCache();
+    if (!cache)
+        return ::operator new(GetBlockSize(sizeClass));
+
+    FreeList& list = cache->Lists[sizeClass];
+    if (!list.Head)
+        list.Count = Refill(sizeClass, list.Head);
+
+    FreeBlock* block = list.Head;
+    list.Head = block->Next;
+    --list.Count;
+    return block;
+}
+
+void Acore::SmallObjectPool::Deallocate(void* object, std::size_t bytes)
+{
+    if (!object)
+        return;
+
+    if (bytes > MAX_OBJECT_SIZE)
+    {
+        ::operator delete(object);
+        return;
+    }
+
+    std::size_t const sizeClass = GetSizeClass(bytes);
+    FreeBlock* block = static_cast<FreeBlock*>(object);
+
+    ThreadCache* cache = GetThreadCache();
+    if (!cache)
+    {
+        block->Next = nullptr;
+        PushChain(sizeClass, block);
+        return;
+    }
+
+    FreeList& list = cache->Lists[sizeClass];
+    block->Next = list.Head;
+    list.Head = block;
+
+    if (++list.Count < THREAD_CACHE_LIMIT)
+        return;
+
+    // Hand a batch over to the depot so threads that mostly create objects can pick it up
+    FreeBlock* chain = list.Head;
+    FreeBlock* last = chain;
+    for (std::size_t i = 1; i < TRANSFER_BATCH; ++i)
+        last = last->Next;
+
+    list.Head = last->Next;
+    list.Count -= TRANSFER_BATCH;
+    last->Next = nullptr;
+    PushChain(sizeClass, chain);
+}
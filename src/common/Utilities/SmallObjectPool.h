@@ -0,0 +1,49 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_SMALL_OBJECT_POOL_H
+#define ACORE_SMALL_OBJECT_POOL_H
+
+#include "Define.h"
+#include <cstddef>
+
+namespace Acore
+{
+    /**
+     * Slab allocator for small, short lived objects that are created and destroyed at a high rate (timed events).
+     *
+     * Sizes are rounded up to GRANULARITY and served from 64 KiB slabs that are carved into blocks of one size
+     * class. Freed blocks are kept on a per thread free list, a thread holding too many hands a batch to a shared
+     * depot. Slab memory is never returned to the heap, so the footprint follows the peak number of live objects.
+     * Objects larger than MAX_OBJECT_SIZE use the regular heap.
+     */
+    class AC_COMMON_API SmallObjectPool
+    {
+    public:
+        static constexpr std::size_t GRANULARITY = 16;
+        static constexpr std::size_t MAX_OBJECT_SIZE = 256;
+        static constexpr std::size_t SIZE_CLASS_COUNT = MAX_OBJECT_SIZE / GRANULARITY;
+
+        static void* Allocate(std::size_t bytes);
+        static void Deallocate(void* object, std::size_t bytes);
+
+        static constexpr std::size_t GetSizeClass(std::size_t bytes) { return bytes ? (bytes - 1) / GRANULARITY : 0; }
+        static constexpr std::size_t GetBlockSize(std::size_t sizeClass) { return (sizeClass + 1) * GRANULARITY; }
+    };
+}
+
+#endif
@@ -87,7 +87,7 @@ int main(int argc, char** argv)
 
     // Init logging
     sLog->RegisterAppender<AppenderDB>();
-    sLog->Initialize(nullptr);
+    sLog->Initialize();
 
     Acore::Banner::Show("authserver",
         [](std::string_view text)
@@ -25,11 +25,14 @@
 #include "Banner.h"
 #include "BattlegroundMgr.h"
 #include "BigNumber.h"
+#include "BufferPool.h"
 #include "CliRunnable.h"
 #include "Common.h"
 #include "Config.h"
 #include "DatabaseEnv.h"
 #include "DatabaseLoader.h"
+#include "DatabaseWorker.h"
+#include "DBUpdater.h"
 #include "GitRevision.h"
 #include "IoContext.h"
 #include "MapMgr.h"
@@ -37,6 +40,8 @@
 #include "ModuleMgr.h"
 #include "ModulesScriptLoader.h"
 #include "MySQLThreading.h"
+#include "ObjectAccessor.h"
+#include "OpcodeProfiler.h"
 #include "OpenSSLCrypto.h"
 #include "OutdoorPvPMgr.h"
 #include "ProcessPriority.h"
@@ -188,8 +193,8 @@ int main(int argc, char** argv)
 
     // Init all logs
     sLog->RegisterAppender<AppenderDB>();
-    // If logs are supposed to be handled async then we need to pass the IoContext into the Log singleton
-    sLog->Initialize(sConfigMgr->GetOption<bool>("Log.Async.Enable", false) ? ioContext.get() : nullptr);
+    // Asynchronous logging starts its own writer thread
+    sLog->Initialize(sConfigMgr->GetOption<bool>("Log.Async.Enable", false));
 
     Acore::Banner::Show("worldserver-daemon",
         [](std::string_view text)
@@ -291,8 +296,36 @@ int main(int argc, char** argv)
         METRIC_VALUE("db_queue_login", uint64(LoginDatabase.QueueSize()));
         METRIC_VALUE("db_queue_character", uint64(CharacterDatabase.QueueSize()));
         METRIC_VALUE("db_queue_world", uint64(WorldDatabase.QueueSize()));
+
+        auto reportBatching = [](DatabaseWorkerBatching& batching, std::string const& pool)
+        {
+            METRIC_VALUE("db_batches", batching.Batches.exchange(0, std::memory_order_relaxed), METRIC_TAG("pool", pool));
+            METRIC_VALUE("db_batched_operations", batching.BatchedOperations.exchange(0, std::memory_order_relaxed), METRIC_TAG("pool", pool));
+            METRIC_VALUE("db_batch_size_max", uint64(batching.LargestBatch.exchange(0, std::memory_order_relaxed)), METRIC_TAG("pool", pool));
+            METRIC_VALUE("db_batch_fallbacks", batching.Fallbacks.exchange(0, std::memory_order_relaxed), METRIC_TAG("pool", pool));
+        };
+        reportBatching(LoginDatabase.GetBatching(), "login");
+        reportBatching(CharacterDatabase.GetBatching(), "character");
+        reportBatching(WorldDatabase.GetBatching(), "world");
+
+        HashMapHolder<Player>::LookupStats lookups = HashMapHolder<Player>::GetLookupStats(true);
+        METRIC_VALUE("object_accessor_lookups", lookups.Lookups, METRIC_TAG("type", "player"));
+        METRIC_VALUE("object_accessor_lookups_contended", lookups.Contended, METRIC_TAG("type", "player"));
+
+        for (std::size_t sizeClass = 0; sizeClass <= Acore::BufferPool::SIZE_CLASS_COUNT; ++sizeClass)
+        {
+            Acore::BufferPool::SizeClassStats const stats = Acore::BufferPool::GetStats(sizeClass);
+            std::string size = sizeClass < Acore::BufferPool::SIZE_CLASS_COUNT ? std::to_string(Acore::BufferPool::GetBlockSize(sizeClass)) : "large";
+            METRIC_VALUE("buffer_pool_allocations", stats.Allocations, METRIC_TAG("size_class", size));
+            METRIC_VALUE("buffer_pool_reused", stats.Reused, METRIC_TAG("size_class", size));
+            METRIC_VALUE("buffer_pool_released", stats.Released, METRIC_TAG("size_class", size));
+        }
+
+        METRIC_VALUE("log_messages_dropped", sLog->GetDroppedMessages());
     });
 
+    sOpcodeProfiler->RegisterMetrics(sMetric->GetRegistry());
+
     METRIC_EVENT("events", "Worldserver started", "");
 
     std::shared_ptr<void> sMetricHandle(nullptr, [](void*)
@@ -307,6 +340,9 @@ int main(int argc, char** argv)
     sSecretMgr->Initialize();
     sWorld->SetInitialWorldSettings();
 
+    ///- Snapshots are only for startup, reload commands must see the current rows
+    WorldDatabase.DisableResultSnapshots();
+
     std::shared_ptr<void> mapManagementHandle(nullptr, [](void*)
     {
         // unload battleground templates before different singletons destroyed
@@ -434,6 +470,12 @@ bool StartDB()
     if (!loader.Load())
         return false;
 
+    ///- Serve static world content from result snapshots, keyed by the updates applied to the world database
+    std::string const snapshotDir = sConfigMgr->GetOption<std::string>("WorldDatabase.SnapshotDir", "");
+    if (!snapshotDir.empty())
+        WorldDatabase.EnableResultSnapshots(snapshotDir, DBUpdater<WorldDatabaseConnection>::GetAppliedUpdatesHash(WorldDatabase),
+            sConfigMgr->GetOption<bool>("WorldDatabase.SnapshotChecksum", false));
+
     if (!sScriptMgr->OnDatabasesLoading())
     {
         return false;
@@ -16,6 +16,9 @@
  */
 
 #include "DatabaseWorker.h"
+#include "Log.h"
+#include "Metric.h"
+#include "MySQLConnection.h"
 #include "PCQueue.h"
 #include "SQLOperation.h"
 
@@ -23,6 +26,8 @@ DatabaseWorker::DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, M
 {
     _connection = connection;
     _queue = newQueue;
+    _batching = nullptr;
+    _queueLatency = nullptr;
     _workerThread = std::thread(&DatabaseWorker::WorkerThread, this);
 }
 
@@ -36,6 +41,9 @@ void DatabaseWorker::WorkerThread()
     if (!_queue)
         return;
 
+    std::vector<SQLOperation*> batch;
+    std::vector<SQLElementData> elements;
+
     for (;;)
     {
         SQLOperation* operation = nullptr;
@@ -45,9 +53,78 @@ void DatabaseWorker::WorkerThread()
         if (!operation)
             return;
 
-        operation->SetConnection(_connection);
-        operation->call();
+        RecordQueueLatency(operation);
 
-        delete operation;
+        // _batching was set before anything was queued, the queue lock orders that write before this read
+        if (_batching && _batching->MaxOperations > 1 && operation->AppendToBatch(elements))
+        {
+            batch.push_back(operation);
+
+            // Take what is already waiting, up to the first operation that needs to run on its own
+            operation = nullptr;
+            while (batch.size() < _batching->MaxOperations && _queue->Pop(operation))
+            {
+                RecordQueueLatency(operation);
+
+                if (!operation->AppendToBatch(elements))
+                    break;
+
+                batch.push_back(operation);
+                operation = nullptr;
+            }
+
+            ExecuteBatch(batch, elements);
+            batch.clear();
+            elements.clear();
+
+            if (!operation)
+                continue;
+        }
+
+        Execute(operation);
     }
 }
+
+void DatabaseWorker::RecordQueueLatency(SQLOperation const* operation)
+{
+    if (_queueLatency)
+        METRIC_HISTOGRAM_OBSERVE(*_queueLatency, std::chrono::steady_clock::now() - operation->m_queueTime);
+}
+
+void DatabaseWorker::Execute(SQLOperation* operation)
+{
+    operation->SetConnection(_connection);
+    operation->call();
+
+    delete operation;
+}
+
+void DatabaseWorker::ExecuteBatch(std::vector<SQLOperation*> const& batch, std::vector<SQLElementData> const& elements)
+{
+    if (batch.size() == 1)
+    {
+        Execute(batch.front());
+        return;
+    }
+
+    if (int errorCode = _connection->ExecuteTransaction(elements))
+    {
+        // The batch was rolled back, replay it so only the failing operation is lost like before
+        LOG_DEBUG("sql.sql", "Batch of {} operations failed with error {}, executing them one by one.", batch.size(), errorCode);
+        ++_batching->Fallbacks;
+
+        for (SQLOperation* operation : batch)
+            Execute(operation);
+
+        return;
+    }
+
+    ++_batching->Batches;
+    _batching->BatchedOperations += batch.size();
+
+    uint32 largest = _batching->LargestBatch.load(std::memory_order_relaxed);
+    while (batch.size() > largest && !_batching->LargestBatch.compare_exchange_weak(largest, uint32(batch.size()), std::memory_order_relaxed));
+
+    for (SQLOperation* operation : batch)
+        delete operation;
+}
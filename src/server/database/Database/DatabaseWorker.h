@@ -21,12 +21,25 @@
 #include "Define.h"
 #include <atomic>
 #include <thread>
+#include <vector>
 
 template <typename T>
 class ProducerConsumerQueue;
 
+class MetricHistogram;
 class MySQLConnection;
 class SQLOperation;
+struct SQLElementData;
+
+//! Batching settings and counters shared by the async workers of one pool
+struct AC_DATABASE_API DatabaseWorkerBatching
+{
+    uint32 MaxOperations = 1;                   //! Set before the connections open, 1 disables batching
+    std::atomic<uint64> Batches{0};             //! Operations sent as one transaction, counting batches of more than one
+    std::atomic<uint64> BatchedOperations{0};
+    std::atomic<uint32> LargestBatch{0};
+    std::atomic<uint64> Fallbacks{0};           //! Batches that failed and were replayed one operation at a time
+};
 
 class AC_DATABASE_API DatabaseWorker
 {
@@ -34,11 +47,21 @@ public:
     DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection);
     ~DatabaseWorker();
 
+    //! Must be called before the first operation is queued
+    void SetBatching(DatabaseWorkerBatching* batching) { _batching = batching; }
+    //! Must be called before the first operation is queued
+    void SetQueueLatency(MetricHistogram* queueLatency) { _queueLatency = queueLatency; }
+
 private:
     ProducerConsumerQueue<SQLOperation*>* _queue;
     MySQLConnection* _connection;
+    DatabaseWorkerBatching* _batching;
+    MetricHistogram* _queueLatency;
 
     void WorkerThread();
+    void RecordQueueLatency(SQLOperation const* operation);
+    void Execute(SQLOperation* operation);
+    void ExecuteBatch(std::vector<SQLOperation*> const& batch, std::vector<SQLElementData> const& elements);
     std::thread _workerThread;
 
     DatabaseWorker(DatabaseWorker const& right) = delete;
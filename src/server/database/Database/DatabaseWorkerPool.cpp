@@ -18,9 +18,11 @@
 #include "DatabaseWorkerPool.h"
 #include "AdhocStatement.h"
 #include "CharacterDatabase.h"
+#include "DatabaseWorker.h"
 #include "Errors.h"
 #include "Log.h"
 #include "LoginDatabase.h"
+#include "Metric.h"
 #include "MySQLPreparedStatement.h"
 #include "MySQLWorkaround.h"
 #include "PCQueue.h"
@@ -28,9 +30,11 @@
 #include "QueryCallback.h"
 #include "QueryHolder.h"
 #include "QueryResult.h"
+#include "ResultSnapshot.h"
 #include "SQLOperation.h"
 #include "Transaction.h"
 #include "WorldDatabase.h"
+#include <algorithm>
 #include <limits>
 #include <mysqld_error.h>
 #include <sstream>
@@ -59,7 +63,9 @@ template <class T>
 DatabaseWorkerPool<T>::DatabaseWorkerPool() :
     _queue(new ProducerConsumerQueue<SQLOperation*>()),
     _async_threads(0),
-    _synch_threads(0)
+    _synch_threads(0),
+    _batching(std::make_unique<DatabaseWorkerBatching>()),
+    _snapshotChecksums(false)
 {
     WPFatal(mysql_thread_safe(), "Used MySQL library isn't thread-safe.");
 
@@ -198,6 +204,87 @@ QueryResult DatabaseWorkerPool<T>::Query(std::string_view sql)
     return QueryResult(result);
 }
 
+template <class T>
+void DatabaseWorkerPool<T>::SetMaxBatchSize(uint32 maxOperations)
+{
+    _batching->MaxOperations = std::max<uint32>(maxOperations, 1);
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::EnableResultSnapshots(std::string directory, std::string key, bool checksumTables)
+{
+    LOG_INFO("sql.driver", "Using result snapshots from '{}' for database '{}'.", directory, GetDatabaseName());
+    _snapshots = std::make_unique<ResultSnapshotStore>(std::move(directory), std::move(key));
+    _snapshotChecksums = checksumTables;
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::DisableResultSnapshots()
+{
+    _snapshots.reset();
+}
+
+template <class T>
+QueryResult DatabaseWorkerPool<T>::QuerySnapshot(std::string_view name, std::string_view sql)
+{
+    if (!_snapshots)
+        return Query(sql);
+
+    // Catches edits made outside of database updates, only reads the table statistics.
+    // UPDATE_TIME of InnoDB tables is not kept over a MySQL restart, the optional checksum is.
+    QueryResult status = Query(Acore::StringFormat("SELECT CREATE_TIME, UPDATE_TIME FROM information_schema.TABLES "
+        "WHERE TABLE_SCHEMA = DATABASE() AND TABLE_NAME = '{}'", name));
+    if (!status)
+        return Query(sql);
+
+    Field* fields = status->Fetch();
+    std::string tableKey = Acore::StringFormat("{}/{}", fields[0].Get<std::string>(), fields[1].Get<std::string>());
+
+    if (_snapshotChecksums)
+    {
+        QueryResult checksum = Query(Acore::StringFormat("CHECKSUM TABLE `{}`", name));
+        if (!checksum || checksum->Fetch()[1].IsNull())
+            return Query(sql);
+
+        tableKey += Acore::StringFormat("/{}", checksum->Fetch()[1].Get<std::string>());
+    }
+
+    if (std::shared_ptr<ResultSnapshot const> snapshot = _snapshots->Find(name, tableKey, sql))
+    {
+        ResultSet* result = new ResultSet(std::move(snapshot));
+        if (!result->NextRow())
+        {
+            delete result;
+            return QueryResult(nullptr);
+        }
+
+        LOG_DEBUG("sql.sql", "Serving '{}' from its result snapshot", name);
+        return QueryResult(result);
+    }
+
+    auto connection = GetFreeConnection();
+
+    ResultSet* result = connection->Query(sql);
+    connection->Unlock();
+
+    if (!result || !result->GetRowCount())
+    {
+        delete result;
+        return QueryResult(nullptr);
+    }
+
+    // Must be attached before the first row is fetched
+    result->RecordSnapshot(_snapshots->CreateWriter(name, tableKey, sql, result->GetFieldMetadata()));
+
+    if (!result->NextRow())
+    {
+        delete result;
+        return QueryResult(nullptr);
+    }
+
+    return QueryResult(result);
+}
+
 template <class T>
 PreparedQueryResult DatabaseWorkerPool<T>::Query(PreparedStatement<T>* stmt)
 {
@@ -429,7 +516,13 @@ uint32 DatabaseWorkerPool<T>::OpenConnections(InternalIndex type, uint8 numConne
             switch (type)
             {
             case IDX_ASYNC:
-                return std::make_unique<T>(_queue.get(), *_connectionInfo);
+            {
+                auto async = std::make_unique<T>(_queue.get(), *_connectionInfo);
+                async->m_worker->SetBatching(_batching.get());
+                async->m_worker->SetQueueLatency(&sMetric->GetRegistry().GetHistogram("db_queue_latency_seconds",
+                    "Time async operations waited for a database worker", { METRIC_TAG("database", std::string(GetDatabaseName())) }));
+                return async;
+            }
             case IDX_SYNCH:
                 return std::make_unique<T>(*_connectionInfo);
             default:
@@ -472,6 +565,7 @@ unsigned long DatabaseWorkerPool<T>::EscapeString(char* to, char const* from, un
 template <class T>
 void DatabaseWorkerPool<T>::Enqueue(SQLOperation* op)
 {
+    op->m_queueTime = std::chrono::steady_clock::now();
     _queue->Push(op);
 }
 
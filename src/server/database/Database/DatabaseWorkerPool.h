@@ -42,6 +42,8 @@ template <typename T>
 class ProducerConsumerQueue;
 
 class SQLOperation;
+class ResultSnapshotStore;
+struct DatabaseWorkerBatching;
 struct MySQLConnectionInfo;
 
 template <class T>
@@ -68,6 +70,17 @@ public:
     //! Prepares all prepared statements
     bool PrepareStatements();
 
+    //! Lets async workers send up to maxOperations queued operations without results as one transaction.
+    //! Must be called before Open(), 1 sends every operation on its own.
+    void SetMaxBatchSize(uint32 maxOperations);
+
+    //! Lets QuerySnapshot serve results from snapshot files in directory, written for the given content key.
+    //! Tables are told apart by their creation and update time, checksumTables also compares CHECKSUM TABLE.
+    void EnableResultSnapshots(std::string directory, std::string key, bool checksumTables);
+
+    //! Makes QuerySnapshot query the database again, snapshots are only used while the server starts.
+    void DisableResultSnapshots();
+
     [[nodiscard]] inline MySQLConnectionInfo const* GetConnectionInfo() const
     {
         return _connectionInfo.get();
@@ -143,6 +156,10 @@ public:
     //! Statement must be prepared with CONNECTION_SYNCH flag.
     PreparedQueryResult Query(PreparedStatement<T>* stmt);
 
+    //! Same as Query(sql) for queries over the static table called name. If result snapshots are enabled the rows
+    //! come from its snapshot when it matches the current content, otherwise the query runs and refreshes it.
+    QueryResult QuerySnapshot(std::string_view name, std::string_view sql);
+
     /**
         Asynchronous query (with resultset) methods.
     */
@@ -214,6 +231,7 @@ public:
     }
 
     [[nodiscard]] std::size_t QueueSize() const;
+    [[nodiscard]] DatabaseWorkerBatching& GetBatching() const { return *_batching; }
 
 private:
     uint32 OpenConnections(InternalIndex type, uint8 numConnections);
@@ -234,6 +252,9 @@ private:
     std::unique_ptr<MySQLConnectionInfo> _connectionInfo;
     std::vector<uint8> _preparedStatementSize;
     uint8 _async_threads, _synch_threads;
+    std::unique_ptr<DatabaseWorkerBatching> _batching;
+    std::unique_ptr<ResultSnapshotStore> _snapshots;
+    bool _snapshotChecksums;
 #ifdef ACORE_DEBUG
     static inline thread_local bool _warnSyncQueries = false;
 #endif
@@ -186,6 +186,12 @@ void Field::LogWrongType(std::string_view getter, std::string_view typeName) con
         getter, typeName, meta->TypeName, meta->TableAlias, meta->Alias, meta->TableName, meta->Name, meta->Index);
 }
 
+void Field::AbortWrongRawSize(std::string_view typeName, std::size_t size) const
+{
+    ASSERT(false, "Field::Decode<{}> ({} bytes) on {} field {}.{} ({}.{}) at index {} holding {} bytes",
+        typeName, size, meta->TypeName, meta->TableAlias, meta->Alias, meta->TableName, meta->Name, meta->Index, data.length);
+}
+
 void Field::SetMetadata(QueryResultFieldMetadata const* fieldMeta)
 {
     meta = fieldMeta;
@@ -286,6 +292,27 @@ template int64 Field::GetData() const;
 template float Field::GetData() const;
 template double Field::GetData() const;
 
+template<typename T>
+T Field::DecodeText() const
+{
+    if (Optional<T> result = Acore::StringTo<T>(std::string_view(data.value, data.length)))
+        return *result;
+
+    return T(0);
+}
+
+template bool Field::DecodeText() const;
+template uint8 Field::DecodeText() const;
+template uint16 Field::DecodeText() const;
+template uint32 Field::DecodeText() const;
+template uint64 Field::DecodeText() const;
+template int8 Field::DecodeText() const;
+template int16 Field::DecodeText() const;
+template int32 Field::DecodeText() const;
+template int64 Field::DecodeText() const;
+template float Field::DecodeText() const;
+template double Field::DecodeText() const;
+
 std::string Field::GetDataString() const
 {
     if (!data.value)
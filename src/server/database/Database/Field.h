@@ -21,7 +21,9 @@
 #include "Define.h"
 #include "Duration.h"
 #include <array>
+#include <cstring>
 #include <string_view>
+#include <typeinfo>
 #include <vector>
 
 namespace Acore::Types
@@ -146,6 +148,39 @@ public:
         return convertToUin32 ? T(GetData<uint32>()) : T(GetData<uint64>());
     }
 
+    /**
+        Decodes the value without the checks Get<T>() does (type checks, aggregate aliases, signed *_dbc values).
+        Meant for bulk loads that know their column types, used by ResultSet::Rows() and PreparedResultSet::Rows().
+        Only arithmetic types and std::string_view are supported, NULL gives 0 or an empty view.
+        A prepared statement column of another size than T asserts instead of reading past its buffer.
+    */
+    template<typename T>
+    inline T Decode() const
+    {
+        static_assert(std::is_arithmetic_v<T> || std::is_same_v<std::string_view, T>, "Field::Decode supports arithmetic types and std::string_view");
+
+        if constexpr (std::is_same_v<std::string_view, T>)
+            return data.value ? std::string_view(data.value, data.length) : std::string_view();
+        else
+        {
+            if (!data.value)
+                return T(0);
+
+            // Prepared statements bind every column with its own C type, T has to match its size
+            if (data.raw && (!std::is_same_v<T, double> || meta->Type != DatabaseFieldTypes::Decimal))
+            {
+                if (data.length != sizeof(T))
+                    AbortWrongRawSize(typeid(T).name(), sizeof(T));
+
+                T value;
+                std::memcpy(&value, data.value, sizeof(T));
+                return value;
+            }
+
+            return DecodeText<T>();
+        }
+    }
+
     DatabaseFieldTypes GetType() { return meta->Type; }
 
 protected:
@@ -165,12 +200,16 @@ private:
     template<typename T>
     T GetData() const;
 
+    template<typename T>
+    T DecodeText() const;
+
     std::string GetDataString() const;
     std::string_view GetDataStringView() const;
     Binary GetDataBinary() const;
 
     QueryResultFieldMetadata const* meta;
     void LogWrongType(std::string_view getter, std::string_view typeName) const;
+    void AbortWrongRawSize(std::string_view typeName, std::size_t size) const;
     void SetMetadata(QueryResultFieldMetadata const* fieldMeta);
     void GetBinarySizeChecked(uint8* buf, std::size_t size) const;
 };
@@ -381,7 +381,11 @@ void MySQLConnection::CommitTransaction()
 
 int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transaction)
 {
-    std::vector<SQLElementData> const& queries = transaction->m_queries;
+    return ExecuteTransaction(transaction->m_queries);
+}
+
+int MySQLConnection::ExecuteTransaction(std::vector<SQLElementData> const& queries)
+{
     if (queries.empty())
         return -1;
 
@@ -31,6 +31,7 @@ class ProducerConsumerQueue;
 class DatabaseWorker;
 class MySQLPreparedStatement;
 class SQLOperation;
+struct SQLElementData;
 
 enum ConnectionFlags
 {
@@ -79,6 +80,7 @@ public:
     void RollbackTransaction();
     void CommitTransaction();
     int ExecuteTransaction(std::shared_ptr<TransactionBase> transaction);
+    int ExecuteTransaction(std::vector<SQLElementData> const& queries);
     std::size_t EscapeString(char* to, const char* from, std::size_t length);
     void Ping();
 
@@ -28,6 +28,27 @@ PreparedStatementBase::PreparedStatementBase(uint32 index, uint8 capacity) :
 
 PreparedStatementBase::~PreparedStatementBase() { }
 
+std::size_t PreparedStatementBase::GetDataSize() const
+{
+    std::size_t size = 0;
+
+    for (PreparedStatementData const& parameter : statement_data)
+    {
+        size += std::visit([](auto const& value) -> std::size_t
+        {
+            using T = std::decay_t<decltype(value)>;
+            if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::vector<uint8>>)
+                return value.size();
+            else if constexpr (std::is_same_v<T, std::nullptr_t>)
+                return 0;
+            else
+                return sizeof(T);
+        }, parameter.data);
+    }
+
+    return size;
+}
+
 //- Bind to buffer
 template<typename T>
 Acore::Types::is_non_string_view_v<T> PreparedStatementBase::SetValidData(const uint8 index, T const& value)
@@ -100,6 +121,18 @@ bool PreparedStatementTask::Execute()
     return m_conn->Execute(m_stmt);
 }
 
+bool PreparedStatementTask::AppendToBatch(std::vector<SQLElementData>& elements) const
+{
+    if (m_has_result)
+        return false;
+
+    SQLElementData data = {};
+    data.type = SQL_ELEMENT_PREPARED;
+    data.element = m_stmt;
+    elements.emplace_back(data);
+    return true;
+}
+
 template<typename T>
 std::string PreparedStatementData::ToString(T value)
 {
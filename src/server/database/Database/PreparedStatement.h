@@ -123,6 +123,9 @@ public:
     [[nodiscard]] uint32 GetIndex() const { return m_index; }
     [[nodiscard]] std::vector<PreparedStatementData> const& GetParameters() const { return statement_data; }
 
+    //! Payload size of the bound parameters in bytes
+    [[nodiscard]] std::size_t GetDataSize() const;
+
 protected:
     template<typename T>
     Acore::Types::is_non_string_view_v<T> SetValidData(const uint8 index, T const& value);
@@ -173,6 +176,7 @@ public:
     ~PreparedStatementTask() override;
 
     bool Execute() override;
+    bool AppendToBatch(std::vector<SQLElementData>& elements) const override;
     PreparedQueryResultFuture GetFuture() { return m_result->get_future(); }
 
 protected:
@@ -21,6 +21,7 @@
 #include "Log.h"
 #include "MySQLHacks.h"
 #include "MySQLWorkaround.h"
+#include "ResultSnapshot.h"
 
 namespace
 {
@@ -168,7 +169,10 @@ ResultSet::ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, u
     _rowCount(rowCount),
     _fieldCount(fieldCount),
     _result(result),
-    _fields(fields)
+    _fields(fields),
+    _snapshotOffset(0),
+    _snapshotRow(0),
+    _fetchedRows(0)
 {
     _fieldMetadata.resize(_fieldCount);
     _currentRow = new Field[_fieldCount];
@@ -180,15 +184,57 @@ ResultSet::ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, u
     }
 }
 
+ResultSet::ResultSet(std::shared_ptr<ResultSnapshot const> snapshot) :
+    _fieldMetadata(snapshot->GetFieldMetadata()),
+    _rowCount(snapshot->GetRowCount()),
+    _fieldCount(snapshot->GetFieldCount()),
+    _result(nullptr),
+    _fields(nullptr),
+    _snapshot(std::move(snapshot)),
+    _snapshotOffset(_snapshot->GetFirstRowOffset()),
+    _snapshotRow(0),
+    _fetchedRows(0)
+{
+    _currentRow = new Field[_fieldCount];
+
+    for (uint32 i = 0; i < _fieldCount; i++)
+        _currentRow[i].SetMetadata(&_fieldMetadata[i]);
+}
+
 ResultSet::~ResultSet()
 {
     CleanUp();
 }
 
+void ResultSet::RecordSnapshot(std::unique_ptr<ResultSnapshotWriter> writer)
+{
+    _snapshotWriter = std::move(writer);
+}
+
 bool ResultSet::NextRow()
 {
     MYSQL_ROW row;
 
+    if (_snapshot)
+    {
+        if (_snapshotRow >= _rowCount)
+        {
+            CleanUp();
+            return false;
+        }
+
+        for (uint32 i = 0; i < _fieldCount; i++)
+        {
+            char const* value;
+            uint32 length;
+            _snapshot->ReadField(_snapshotOffset, value, length);
+            _currentRow[i].SetStructuredValue(value, length);
+        }
+
+        ++_snapshotRow;
+        return true;
+    }
+
     if (!_result)
         return false;
 
@@ -210,13 +256,17 @@ bool ResultSet::NextRow()
     for (uint32 i = 0; i < _fieldCount; i++)
         _currentRow[i].SetStructuredValue(row[i], lengths[i]);
 
+    if (_snapshotWriter)
+        _snapshotWriter->AddRow(row, lengths);
+
+    ++_fetchedRows;
     return true;
 }
 
 std::string ResultSet::GetFieldName(uint32 index) const
 {
     ASSERT(index < _fieldCount);
-    return _fields[index].name;
+    return _fieldMetadata[index].Alias;
 }
 
 void ResultSet::CleanUp()
@@ -231,7 +281,14 @@ void ResultSet::CleanUp()
     {
         mysql_free_result(_result);
         _result = nullptr;
+
+        // Only a result that was read to the end makes a complete snapshot
+        if (_snapshotWriter && _fetchedRows == _rowCount)
+            _snapshotWriter->Commit(_rowCount);
     }
+
+    _snapshotWriter.reset();
+    _snapshot.reset();
 }
 
 Field const& ResultSet::operator[](std::size_t index) const
@@ -21,9 +21,14 @@
 #include "DatabaseEnvFwd.h"
 #include "Define.h"
 #include "Field.h"
+#include <memory>
 #include <tuple>
+#include <utility>
 #include <vector>
 
+class ResultSnapshot;
+class ResultSnapshotWriter;
+
 template<typename T>
 struct ResultIterator
 {
@@ -45,12 +50,60 @@ private:
     pointer _ptr;
 };
 
+/**
+    Typed view over the remaining rows of a result, see ResultSet::Rows().
+    Each row is decoded straight from the field buffers into a std::tuple<Ts...> through Field::Decode,
+    strings come out as std::string_view into the result and stay valid until the next row.
+*/
+template<typename Result, typename... Ts>
+class TypedResultRows
+{
+public:
+    using Row = std::tuple<Ts...>;
+
+    struct Iterator
+    {
+        using iterator_category = std::input_iterator_tag;
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = Row;
+
+        explicit Iterator(Result* result) : _result(result) { }
+
+        Row operator*() const { return Decode(_result->Fetch(), std::index_sequence_for<Ts...>()); }
+        Iterator& operator++() { if (!_result->NextRow()) _result = nullptr; return *this; }
+
+        bool operator!=(Iterator const& right) const { return _result != right._result; }
+
+    private:
+        template<std::size_t... Index>
+        static Row Decode(Field const* fields, std::index_sequence<Index...>)
+        {
+            return Row(fields[Index].template Decode<Ts>()...);
+        }
+
+        Result* _result;
+    };
+
+    explicit TypedResultRows(Result* result) : _result(result) { }
+
+    Iterator begin() const { return Iterator(_result); }
+    static Iterator end() { return Iterator(nullptr); }
+
+private:
+    Result* _result;
+};
+
 class AC_DATABASE_API ResultSet
 {
 public:
     ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, uint32 fieldCount);
+    explicit ResultSet(std::shared_ptr<ResultSnapshot const> snapshot);
     ~ResultSet();
 
+    //! Copies every row into the writer as it is fetched, the snapshot is written after the last row.
+    void RecordSnapshot(std::unique_ptr<ResultSnapshotWriter> writer);
+    [[nodiscard]] std::vector<QueryResultFieldMetadata> const& GetFieldMetadata() const { return _fieldMetadata; }
+
     bool NextRow();
     [[nodiscard]] uint64 GetRowCount() const { return _rowCount; }
     [[nodiscard]] uint32 GetFieldCount() const { return _fieldCount; }
@@ -78,6 +131,15 @@ public:
     auto begin()      { return ResultIterator<ResultSet>(this); }
     static auto end() { return ResultIterator<ResultSet>(nullptr); }
 
+    //! Iterates the rows from the current one on, decoded as Ts... without creating strings or per field checks:
+    //! for (auto [entry, name] : result->Rows<uint32, std::string_view>())
+    template<typename... Ts>
+    TypedResultRows<ResultSet, Ts...> Rows()
+    {
+        AssertRows(sizeof...(Ts));
+        return TypedResultRows<ResultSet, Ts...>(this);
+    }
+
 protected:
     std::vector<QueryResultFieldMetadata> _fieldMetadata;
     uint64 _rowCount;
@@ -91,6 +153,12 @@ private:
     MySQLResult* _result;
     MySQLField* _fields;
 
+    std::shared_ptr<ResultSnapshot const> _snapshot;
+    std::size_t _snapshotOffset;
+    uint64 _snapshotRow;
+    std::unique_ptr<ResultSnapshotWriter> _snapshotWriter;
+    uint64 _fetchedRows;
+
     ResultSet(ResultSet const& right) = delete;
     ResultSet& operator=(ResultSet const& right) = delete;
 };
@@ -127,6 +195,14 @@ public:
     auto begin()        { return ResultIterator<PreparedResultSet>(this); }
     static auto end()   { return ResultIterator<PreparedResultSet>(nullptr); }
 
+    //! See ResultSet::Rows()
+    template<typename... Ts>
+    TypedResultRows<PreparedResultSet, Ts...> Rows()
+    {
+        AssertRows(sizeof...(Ts));
+        return TypedResultRows<PreparedResultSet, Ts...>(this);
+    }
+
 protected:
     std::vector<QueryResultFieldMetadata> m_fieldMetadata;
     std::vector<Field> m_rows;
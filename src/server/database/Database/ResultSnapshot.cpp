@@ -0,0 +1,285 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ResultSnapshot.h"
+#include "Log.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+    constexpr char SNAPSHOT_MAGIC[4] = { 'A', 'C', 'R', 'S' };
+    constexpr uint32 SNAPSHOT_VERSION = 1;
+    constexpr uint32 NULL_LENGTH = 0xFFFFFFFF;
+
+    // FNV-1a, stable between builds unlike std::hash
+    uint64 HashQuery(std::string_view sql)
+    {
+        uint64 hash = 0xcbf29ce484222325ULL;
+        for (char c : sql)
+        {
+            hash ^= uint8(c);
+            hash *= 0x100000001b3ULL;
+        }
+
+        return hash;
+    }
+
+    template<typename T>
+    void Write(std::string& buffer, T value)
+    {
+        buffer.append(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    void WriteString(std::string& buffer, std::string_view value)
+    {
+        Write<uint32>(buffer, uint32(value.size()));
+        buffer.append(value);
+    }
+
+    class Reader
+    {
+    public:
+        Reader(char const* data, std::size_t size, std::size_t offset = 0) : _data(data), _size(size), _offset(offset) { }
+
+        template<typename T>
+        bool Read(T& value)
+        {
+            if (_size - _offset < sizeof(T))
+                return false;
+
+            std::memcpy(&value, _data + _offset, sizeof(T));
+            _offset += sizeof(T);
+            return true;
+        }
+
+        bool Skip(std::size_t bytes)
+        {
+            if (_size - _offset < bytes)
+                return false;
+
+            _offset += bytes;
+            return true;
+        }
+
+        bool ReadString(std::string& value)
+        {
+            uint32 length;
+            if (!Read(length) || _size - _offset < length)
+                return false;
+
+            value.assign(_data + _offset, length);
+            _offset += length;
+            return true;
+        }
+
+        [[nodiscard]] std::size_t GetOffset() const { return _offset; }
+        [[nodiscard]] bool AtEnd() const { return _offset == _size; }
+
+    private:
+        char const* _data;
+        std::size_t _size;
+        std::size_t _offset;
+    };
+}
+
+ResultSnapshot::~ResultSnapshot() = default;
+
+std::shared_ptr<ResultSnapshot const> ResultSnapshot::Open(std::string const& path, std::string_view key, std::string_view sql)
+{
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(path, error) || !std::filesystem::file_size(path, error))
+        return nullptr;
+
+    std::shared_ptr<ResultSnapshot> snapshot(new ResultSnapshot());
+
+    try
+    {
+        snapshot->_file = std::make_unique<boost::interprocess::file_mapping>(path.c_str(), boost::interprocess::read_only);
+        snapshot->_region = std::make_unique<boost::interprocess::mapped_region>(*snapshot->_file, boost::interprocess::read_only);
+    }
+    catch (boost::interprocess::interprocess_exception const& e)
+    {
+        LOG_WARN("sql.sql", "ResultSnapshot: Could not map {}: {}", path, e.what());
+        return nullptr;
+    }
+
+    snapshot->_data = static_cast<char const*>(snapshot->_region->get_address());
+    snapshot->_size = snapshot->_region->get_size();
+
+    Reader reader(snapshot->_data, snapshot->_size);
+
+    char magic[4];
+    uint32 version;
+    uint64 queryHash;
+    std::string storedKey;
+    uint32 fieldCount;
+
+    if (!reader.Read(magic) || std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) ||
+        !reader.Read(version) || version != SNAPSHOT_VERSION ||
+        !reader.Read(queryHash) || queryHash != HashQuery(sql) ||
+        !reader.ReadString(storedKey) || storedKey != key ||
+        !reader.Read(snapshot->_rowCount) || !reader.Read(fieldCount))
+        return nullptr;
+
+    snapshot->_fieldMetadata.resize(fieldCount);
+    for (QueryResultFieldMetadata& meta : snapshot->_fieldMetadata)
+    {
+        uint8 type;
+        if (!reader.Read(type) || !reader.Read(meta.Index) ||
+            !reader.ReadString(meta.TableName) || !reader.ReadString(meta.TableAlias) ||
+            !reader.ReadString(meta.Name) || !reader.ReadString(meta.Alias) || !reader.ReadString(meta.TypeName))
+            return nullptr;
+
+        meta.Type = DatabaseFieldTypes(type);
+    }
+
+    snapshot->_firstRow = reader.GetOffset();
+
+    // Walk the rows once so reading them later never has to check bounds
+    for (uint64 row = 0; row < snapshot->_rowCount; ++row)
+    {
+        for (uint32 field = 0; field < fieldCount; ++field)
+        {
+            uint32 length;
+            if (!reader.Read(length))
+                return nullptr;
+
+            if (length != NULL_LENGTH && !reader.Skip(std::size_t(length) + 1))
+                return nullptr;
+        }
+    }
+
+    if (!reader.AtEnd())
+        return nullptr;
+
+    return snapshot;
+}
+
+void ResultSnapshot::ReadField(std::size_t& offset, char const*& value, uint32& length) const
+{
+    std::memcpy(&length, _data + offset, sizeof(length));
+    offset += sizeof(length);
+
+    if (length == NULL_LENGTH)
+    {
+        value = nullptr;
+        length = 0;
+        return;
+    }
+
+    value = _data + offset;
+    offset += std::size_t(length) + 1;
+}
+
+ResultSnapshotWriter::ResultSnapshotWriter(std::string path, std::string_view key, std::string_view sql, std::vector<QueryResultFieldMetadata> const& fieldMetadata) :
+    _path(std::move(path)), _fieldCount(uint32(fieldMetadata.size()))
+{
+    _buffer.append(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    Write<uint32>(_buffer, SNAPSHOT_VERSION);
+    Write<uint64>(_buffer, HashQuery(sql));
+    WriteString(_buffer, key);
+
+    _rowCountOffset = _buffer.size();
+    Write<uint64>(_buffer, 0);
+    Write<uint32>(_buffer, _fieldCount);
+
+    for (QueryResultFieldMetadata const& meta : fieldMetadata)
+    {
+        Write<uint8>(_buffer, uint8(meta.Type));
+        Write<uint32>(_buffer, meta.Index);
+        WriteString(_buffer, meta.TableName);
+        WriteString(_buffer, meta.TableAlias);
+        WriteString(_buffer, meta.Name);
+        WriteString(_buffer, meta.Alias);
+        WriteString(_buffer, meta.TypeName);
+    }
+}
+
+void ResultSnapshotWriter::AddRow(char const* const* values, unsigned long const* lengths)
+{
+    for (uint32 i = 0; i < _fieldCount; ++i)
+    {
+        if (!values[i])
+        {
+            Write<uint32>(_buffer, NULL_LENGTH);
+            continue;
+        }
+
+        Write<uint32>(_buffer, uint32(lengths[i]));
+        _buffer.append(values[i], lengths[i]);
+        _buffer.push_back('\0');
+    }
+
+    ++_rows;
+}
+
+void ResultSnapshotWriter::Commit(uint64 rowCount)
+{
+    if (rowCount != _rows)
+        return;
+
+    std::memcpy(_buffer.data() + _rowCountOffset, &_rows, sizeof(_rows));
+
+    // Write next to the old file and swap it in, a crash in between leaves the old snapshot intact
+    std::string tempPath = _path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file || !file.write(_buffer.data(), _buffer.size()))
+        {
+            LOG_WARN("sql.sql", "ResultSnapshot: Could not write {}", tempPath);
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, _path, error);
+    if (error)
+        LOG_WARN("sql.sql", "ResultSnapshot: Could not replace {}: {}", _path, error.message());
+}
+
+ResultSnapshotStore::ResultSnapshotStore(std::string directory, std::string key) :
+    _directory(std::move(directory)), _key(std::move(key))
+{
+    std::error_code error;
+    std::filesystem::create_directories(_directory, error);
+    if (error)
+        LOG_WARN("sql.sql", "ResultSnapshot: Could not create directory {}: {}", _directory, error.message());
+}
+
+std::shared_ptr<ResultSnapshot const> ResultSnapshotStore::Find(std::string_view name, std::string_view tableKey, std::string_view sql) const
+{
+    return ResultSnapshot::Open(GetPath(name), GetKey(tableKey), sql);
+}
+
+std::unique_ptr<ResultSnapshotWriter> ResultSnapshotStore::CreateWriter(std::string_view name, std::string_view tableKey, std::string_view sql, std::vector<QueryResultFieldMetadata> const& fieldMetadata) const
+{
+    return std::make_unique<ResultSnapshotWriter>(GetPath(name), GetKey(tableKey), sql, fieldMetadata);
+}
+
+std::string ResultSnapshotStore::GetPath(std::string_view name) const
+{
+    return (std::filesystem::path(_directory) / (std::string(name) + ".snapshot")).string();
+}
+
+std::string ResultSnapshotStore::GetKey(std::string_view tableKey) const
+{
+    return Acore::StringFormat("{}:{}", _key, tableKey);
+}
@@ -0,0 +1,113 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _RESULTSNAPSHOT_H
+#define _RESULTSNAPSHOT_H
+
+#include "Define.h"
+#include "Field.h"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+    @file ResultSnapshot.h
+
+    Result snapshots keep the rows of large static queries (templates, spawns, quests) on disk so a restart
+    with unchanged content does not have to fetch them from the MySQL server again.
+
+    A snapshot file is only used when it was written for the same store key (the hash of all applied
+    database updates), the same table key (creation and update time of the table) and the same query
+    text, otherwise the query runs normally and rewrites it.
+    The file is memory mapped and fields point straight into the mapping.
+*/
+
+namespace boost::interprocess
+{
+    class file_mapping;
+    class mapped_region;
+}
+
+/// Read only view of a snapshot file, rows are read sequentially.
+class AC_DATABASE_API ResultSnapshot
+{
+public:
+    ~ResultSnapshot();
+
+    /// Returns nullptr if the file is missing, damaged or was written for another key or query
+    static std::shared_ptr<ResultSnapshot const> Open(std::string const& path, std::string_view key, std::string_view sql);
+
+    [[nodiscard]] uint64 GetRowCount() const { return _rowCount; }
+    [[nodiscard]] uint32 GetFieldCount() const { return uint32(_fieldMetadata.size()); }
+    [[nodiscard]] std::vector<QueryResultFieldMetadata> const& GetFieldMetadata() const { return _fieldMetadata; }
+
+    /// Reads the field at offset and moves offset past it, value is nullptr for NULL fields
+    void ReadField(std::size_t& offset, char const*& value, uint32& length) const;
+
+    [[nodiscard]] std::size_t GetFirstRowOffset() const { return _firstRow; }
+
+private:
+    ResultSnapshot() = default;
+
+    std::unique_ptr<boost::interprocess::file_mapping> _file;
+    std::unique_ptr<boost::interprocess::mapped_region> _region;
+    char const* _data = nullptr;
+    std::size_t _size = 0;
+    std::size_t _firstRow = 0;
+    uint64 _rowCount = 0;
+    std::vector<QueryResultFieldMetadata> _fieldMetadata;
+};
+
+/// Collects the rows of a result while it is consumed and writes them out once the last row was read.
+class AC_DATABASE_API ResultSnapshotWriter
+{
+public:
+    ResultSnapshotWriter(std::string path, std::string_view key, std::string_view sql, std::vector<QueryResultFieldMetadata> const& fieldMetadata);
+
+    void AddRow(char const* const* values, unsigned long const* lengths);
+
+    /// Writes the file, rowCount must match the number of added rows or the snapshot is dropped
+    void Commit(uint64 rowCount);
+
+private:
+    std::string _path;
+    std::string _buffer;
+    std::size_t _rowCountOffset;
+    uint32 _fieldCount;
+    uint64 _rows = 0;
+};
+
+/// Snapshot directory and key of one database
+class AC_DATABASE_API ResultSnapshotStore
+{
+public:
+    ResultSnapshotStore(std::string directory, std::string key);
+
+    /// tableKey identifies the current content of the table, e.g. its update time
+    [[nodiscard]] std::shared_ptr<ResultSnapshot const> Find(std::string_view name, std::string_view tableKey, std::string_view sql) const;
+    [[nodiscard]] std::unique_ptr<ResultSnapshotWriter> CreateWriter(std::string_view name, std::string_view tableKey, std::string_view sql, std::vector<QueryResultFieldMetadata> const& fieldMetadata) const;
+
+private:
+    [[nodiscard]] std::string GetPath(std::string_view name) const;
+    [[nodiscard]] std::string GetKey(std::string_view tableKey) const;
+
+    std::string _directory;
+    std::string _key;
+};
+
+#endif
@@ -20,7 +20,9 @@
 
 #include "DatabaseEnvFwd.h"
 #include "Define.h"
+#include "Duration.h"
 #include <variant>
+#include <vector>
 
 //- Type specifier of our element data
 enum SQLElementDataType
@@ -53,8 +55,15 @@ public:
     virtual bool Execute() = 0;
     virtual void SetConnection(MySQLConnection* con) { m_conn = con; }
 
+    //! Operations without a result may share one transaction with their neighbours in the queue.
+    //! Appends the statements and returns true if this operation allows that, leaves elements untouched otherwise.
+    virtual bool AppendToBatch(std::vector<SQLElementData>& /*elements*/) const { return false; }
+
     MySQLConnection* m_conn{nullptr};
 
+    //! Set when the operation is queued for the async workers
+    TimePoint m_queueTime;
+
 private:
     SQLOperation(SQLOperation const& right) = delete;
     SQLOperation& operator=(SQLOperation const& right) = delete;
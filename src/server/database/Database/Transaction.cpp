@@ -47,6 +47,21 @@ void TransactionBase::AppendPreparedStatement(PreparedStatementBase* stmt)
     m_queries.emplace_back(data);
 }
 
+std::size_t TransactionBase::GetDataSize() const
+{
+    std::size_t size = 0;
+
+    for (SQLElementData const& data : m_queries)
+    {
+        if (data.type == SQL_ELEMENT_PREPARED)
+            size += std::get<PreparedStatementBase*>(data.element)->GetDataSize();
+        else
+            size += std::get<std::string>(data.element).size();
+    }
+
+    return size;
+}
+
 void TransactionBase::Cleanup()
 {
     // This might be called by explicit calls to Cleanup or by the auto-destructor
@@ -128,6 +143,15 @@ bool TransactionTask::Execute()
     return false;
 }
 
+bool TransactionTask::AppendToBatch(std::vector<SQLElementData>& elements) const
+{
+    if (m_trans->m_queries.empty())
+        return false;
+
+    elements.insert(elements.end(), m_trans->m_queries.begin(), m_trans->m_queries.end());
+    return true;
+}
+
 int TransactionTask::TryExecute()
 {
     return m_conn->ExecuteTransaction(m_trans);
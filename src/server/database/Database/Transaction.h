@@ -49,6 +49,9 @@ public:
 
     [[nodiscard]] std::size_t GetSize() const { return m_queries.size(); }
 
+    //! Payload size of all queries in bytes: raw query text and bound parameters of prepared statements
+    [[nodiscard]] std::size_t GetDataSize() const;
+
 protected:
     void AppendPreparedStatement(PreparedStatementBase* statement);
     void Cleanup();
@@ -83,6 +86,8 @@ public:
     TransactionTask(std::shared_ptr<TransactionBase> trans) : m_trans(std::move(trans)) { }
     ~TransactionTask() override = default;
 
+    bool AppendToBatch(std::vector<SQLElementData>& elements) const override;
+
 protected:
     bool Execute() override;
     int TryExecute();
@@ -99,6 +104,9 @@ public:
 
     TransactionFuture GetFuture() { return m_result.get_future(); }
 
+    // The caller waits for the outcome of exactly this transaction
+    bool AppendToBatch(std::vector<SQLElementData>& /*elements*/) const override { return false; }
+
 protected:
     bool Execute() override;
 
@@ -18,12 +18,14 @@
 #include "DBUpdater.h"
 #include "BuiltInConfig.h"
 #include "Config.h"
+#include "CryptoHash.h"
 #include "DatabaseEnv.h"
 #include "DatabaseLoader.h"
 #include "Log.h"
 #include "StartProcess.h"
 #include "UpdateFetcher.h"
 #include "QueryResult.h"
+#include "Util.h"
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -410,6 +412,25 @@ bool DBUpdater<T>::Update(DatabaseWorkerPool<T>& pool, std::vector<std::string>
     return true;
 }
 
+template<class T>
+std::string DBUpdater<T>::GetAppliedUpdatesHash(DatabaseWorkerPool<T>& pool)
+{
+    Acore::Crypto::SHA1 hash;
+
+    if (QueryResult result = Retrieve(pool, "SELECT `name`, `hash` FROM `updates` ORDER BY `name`"))
+    {
+        do
+        {
+            Field* fields = result->Fetch();
+            hash.UpdateData(fields[0].Get<std::string_view>());
+            hash.UpdateData(fields[1].Get<std::string_view>());
+        } while (result->NextRow());
+    }
+
+    hash.Finalize();
+    return ByteArrayToHexStr(hash.GetDigest());
+}
+
 template<class T>
 bool DBUpdater<T>::Populate(DatabaseWorkerPool<T>& pool)
 {
@@ -81,6 +81,9 @@ public:
     static bool Update(DatabaseWorkerPool<T>& pool, std::vector<std::string> const* setDirectories);
     static bool Populate(DatabaseWorkerPool<T>& pool);
 
+    // Changes whenever an update is applied or rehashed, used to tell if cached content is still current
+    static std::string GetAppliedUpdatesHash(DatabaseWorkerPool<T>& pool);
+
     // module
     static std::string GetDBModuleName();
 
@@ -906,16 +906,18 @@ void Channel::SetOwner(ObjectGuid guid, bool exclaim)
 
 void Channel::SendToAll(WorldPacket* data, ObjectGuid guid)
 {
+    SharedWorldPacket shared = MakeSharedWorldPacket(*data);
     for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
         if (!guid || !i->second.plrPtr->GetSocial()->HasIgnore(guid))
-            i->second.plrPtr->SendDirectMessage(data);
+            i->second.plrPtr->SendDirectMessage(shared);
 }
 
 void Channel::SendToAllButOne(WorldPacket* data, ObjectGuid who)
 {
+    SharedWorldPacket shared = MakeSharedWorldPacket(*data);
     for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
         if (i->first != who)
-            i->second.plrPtr->SendDirectMessage(data);
+            i->second.plrPtr->SendDirectMessage(shared);
 }
 
 void Channel::SendToOne(WorldPacket* data, ObjectGuid who)
@@ -926,8 +928,9 @@ void Channel::SendToOne(WorldPacket* data, ObjectGuid who)
 
 void Channel::SendToAllWatching(WorldPacket* data)
 {
+    SharedWorldPacket shared = MakeSharedWorldPacket(*data);
     for (PlayersWatchingContainer::const_iterator i = playersWatchingStore.begin(); i != playersWatchingStore.end(); ++i)
-        (*i)->SendDirectMessage(data);
+        (*i)->SendDirectMessage(shared);
 }
 
 bool Channel::ShouldAnnouncePlayer(Player const* player) const
@@ -320,11 +320,7 @@ void Creature::AddToWorld()
         // it's also initialized in AIM_Initialize(), few lines below, but it's not a problem
         Motion_Initialize();
 
-        GetMap()->GetObjectsStore().Insert<Creature>(GetGUID(), this);
-        if (m_spawnId)
-        {
-            GetMap()->GetCreatureBySpawnIdStore().insert(std::make_pair(m_spawnId, this));
-        }
+        GetMap()->AddToObjectsStore(this);
         Unit::AddToWorld();
 
         SearchFormation();
@@ -364,10 +360,7 @@ void Creature::RemoveFromWorld()
 
         Unit::RemoveFromWorld();
 
-        if (m_spawnId)
-            Acore::Containers::MultimapErasePair(GetMap()->GetCreatureBySpawnIdStore(), m_spawnId, this);
-
-        GetMap()->GetObjectsStore().Remove<Creature>(GetGUID());
+        GetMap()->RemoveFromObjectsStore(this);
     }
 }
 
@@ -60,7 +60,7 @@ void DynamicObject::AddToWorld()
     ///- Register the dynamicObject for guid lookup and for caster
     if (!IsInWorld())
     {
-        GetMap()->GetObjectsStore().Insert<DynamicObject>(GetGUID(), this);
+        GetMap()->AddToObjectsStore(this);
 
         WorldObject::AddToWorld();
 
@@ -90,7 +90,7 @@ void DynamicObject::RemoveFromWorld()
 
         WorldObject::RemoveFromWorld();
 
-        GetMap()->GetObjectsStore().Remove<DynamicObject>(GetGUID());
+        GetMap()->RemoveFromObjectsStore(this);
     }
 }
 
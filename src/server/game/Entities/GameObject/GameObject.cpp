@@ -145,9 +145,7 @@ void GameObject::AddToWorld()
         if (m_zoneScript)
             m_zoneScript->OnGameObjectCreate(this);
 
-        GetMap()->GetObjectsStore().Insert<GameObject>(GetGUID(), this);
-        if (m_spawnId)
-            GetMap()->GetGameObjectBySpawnIdStore().insert(std::make_pair(m_spawnId, this));
+        GetMap()->AddToObjectsStore(this);
 
         if (m_model)
         {
@@ -192,9 +190,7 @@ void GameObject::RemoveFromWorld()
 
         WorldObject::RemoveFromWorld();
 
-        if (m_spawnId)
-            Acore::Containers::MultimapErasePair(GetMap()->GetGameObjectBySpawnIdStore(), m_spawnId, this);
-        GetMap()->GetObjectsStore().Remove<GameObject>(GetGUID());
+        GetMap()->RemoveFromObjectsStore(this);
     }
 }
 
@@ -2751,18 +2747,31 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
         return;
 
     bool forcedFlags = GetGoType() == GAMEOBJECT_TYPE_CHEST && GetGOInfo()->chest.groupLootRules && HasLootRecipient();
-    bool targetIsGM = target->IsGameMaster() && target->GetSession()->IsGMAccount();
-
-    ByteBuffer fieldBuffer;
-
-    UpdateMask updateMask;
-    updateMask.SetCount(m_valuesCount);
 
     uint32* flags = GameObjectUpdateFieldFlags;
     uint32 visibleFlag = UF_FLAG_PUBLIC;
     if (GetOwnerGUID() == target->GetGUID())
         visibleFlag |= UF_FLAG_OWNER;
 
+    // GAMEOBJECT_DYNAMIC and GAMEOBJECT_FLAGS depend on the observer, they are patched into the shared block
+    bool share = updateType == UPDATETYPE_VALUES && IsSharingValuesUpdates();
+    if (share)
+    {
+        if (SharedValuesUpdate const* shared = Acore::Containers::MapGetValuePtr(_sharedValuesUpdates, visibleFlag))
+        {
+            std::size_t pos = data->wpos();
+            data->append(shared->Buffer);
+            PatchValuesUpdate(*data, pos, *shared, target);
+            return;
+        }
+    }
+
+    ByteBuffer fieldBuffer;
+
+    UpdateMask updateMask;
+    updateMask.SetCount(m_valuesCount);
+
+    SharedValuesUpdate built;
     for (uint16 index = 0; index < m_valuesCount; ++index)
     {
         if (_fieldNotifyFlags & flags[index] ||
@@ -2773,76 +2782,119 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
 
             if (index == GAMEOBJECT_DYNAMIC)
             {
-                uint16 dynFlags = 0;
-                int16 pathProgress = -1;
-                switch (GetGoType())
-                {
-                    case GAMEOBJECT_TYPE_QUESTGIVER:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                        break;
-                    case GAMEOBJECT_TYPE_CHEST:
-                    case GAMEOBJECT_TYPE_GOOBER:
-                        if (ActivateToQuest(target))
-                        {
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                            if (sWorld->getBoolConfig(CONFIG_OBJECT_SPARKLES))
-                                dynFlags |= GO_DYNFLAG_LO_SPARKLE;
-                        }
-                        else if (targetIsGM)
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                        break;
-                    case GAMEOBJECT_TYPE_SPELL_FOCUS:
-                    case GAMEOBJECT_TYPE_GENERIC:
-                        if (ActivateToQuest(target) && sWorld->getBoolConfig(CONFIG_OBJECT_SPARKLES))
-                            dynFlags |= GO_DYNFLAG_LO_SPARKLE;
-                        break;
-                    case GAMEOBJECT_TYPE_TRANSPORT:
-                        if (const StaticTransport* t = ToStaticTransport())
-                            if (t->GetPauseTime())
-                            {
-                                if (GetGoState() == GO_STATE_READY)
-                                {
-                                    if (t->GetPathProgress() >= t->GetPauseTime()) // if not, send 100% progress
-                                        pathProgress = int16(float(t->GetPathProgress() - t->GetPauseTime()) / float(t->GetPeriod() - t->GetPauseTime()) * 65535.0f);
-                                }
-                                else
-                                {
-                                    if (t->GetPathProgress() <= t->GetPauseTime()) // if not, send 100% progress
-                                        pathProgress = int16(float(t->GetPathProgress()) / float(t->GetPauseTime()) * 65535.0f);
-                                }
-                            }
-                        // else it's ignored
-                        break;
-                    case GAMEOBJECT_TYPE_MO_TRANSPORT:
-                        if (const MotionTransport* t = ToMotionTransport())
-                            pathProgress = int16(float(t->GetPathProgress()) / float(t->GetPeriod()) * 65535.0f);
-                        break;
-                    default:
-                        break;
-                }
-
-                fieldBuffer << uint16(dynFlags);
-                fieldBuffer << int16(pathProgress);
+                built.PatchPos[0] = int32(fieldBuffer.wpos());
+                uint32 dynamicValue = GetDynamicValueForPlayer(target);
+                fieldBuffer << uint16(dynamicValue);
+                fieldBuffer << int16(dynamicValue >> 16);
             }
             else if (index == GAMEOBJECT_FLAGS)
             {
-                uint32 goFlags = m_uint32Values[GAMEOBJECT_FLAGS];
-                if (GetGoType() == GAMEOBJECT_TYPE_CHEST && GetGOInfo() && GetGOInfo()->chest.groupLootRules && !IsLootAllowedFor(target))
-                {
-                    goFlags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
-                }
-
-                fieldBuffer << goFlags;
+                built.PatchPos[1] = int32(fieldBuffer.wpos());
+                fieldBuffer << GetFlagsValueForPlayer(target);
             }
             else
                 fieldBuffer << m_uint32Values[index];                // other cases
         }
     }
 
-    *data << uint8(updateMask.GetBlockCount());
-    updateMask.AppendToPacket(data);
-    data->append(fieldBuffer);
+    if (!share)
+    {
+        *data << uint8(updateMask.GetBlockCount());
+        updateMask.AppendToPacket(data);
+        data->append(fieldBuffer);
+        return;
+    }
+
+    built.Buffer << uint8(updateMask.GetBlockCount());
+    updateMask.AppendToPacket(&built.Buffer);
+    int32 fieldBufferPos = int32(built.Buffer.wpos());
+    built.Buffer.append(fieldBuffer);
+    for (int32& patchPos : built.PatchPos)
+        if (patchPos >= 0)
+            patchPos += fieldBufferPos;
+
+    data->append(built.Buffer);
+    _sharedValuesUpdates.emplace(visibleFlag, std::move(built));
+}
+
+void GameObject::PatchValuesUpdate(ByteBuffer& data, std::size_t blockPos, SharedValuesUpdate const& shared, Player* target)
+{
+    if (shared.PatchPos[0] >= 0)
+    {
+        uint32 dynamicValue = GetDynamicValueForPlayer(target);
+        data.put(blockPos + shared.PatchPos[0], uint16(dynamicValue));
+        data.put(blockPos + shared.PatchPos[0] + sizeof(uint16), int16(dynamicValue >> 16));
+    }
+
+    if (shared.PatchPos[1] >= 0)
+        data.put(blockPos + shared.PatchPos[1], GetFlagsValueForPlayer(target));
+}
+
+uint32 GameObject::GetDynamicValueForPlayer(Player* target) const
+{
+    bool targetIsGM = target->IsGameMaster() && target->GetSession()->IsGMAccount();
+
+    uint16 dynFlags = 0;
+    int16 pathProgress = -1;
+    switch (GetGoType())
+    {
+        case GAMEOBJECT_TYPE_QUESTGIVER:
+            if (ActivateToQuest(target))
+                dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+            break;
+        case GAMEOBJECT_TYPE_CHEST:
+        case GAMEOBJECT_TYPE_GOOBER:
+            if (ActivateToQuest(target))
+            {
+                dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                if (sWorld->getBoolConfig(CONFIG_OBJECT_SPARKLES))
+                    dynFlags |= GO_DYNFLAG_LO_SPARKLE;
+            }
+            else if (targetIsGM)
+                dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+            break;
+        case GAMEOBJECT_TYPE_SPELL_FOCUS:
+        case GAMEOBJECT_TYPE_GENERIC:
+            if (ActivateToQuest(target) && sWorld->getBoolConfig(CONFIG_OBJECT_SPARKLES))
+                dynFlags |= GO_DYNFLAG_LO_SPARKLE;
+            break;
+        case GAMEOBJECT_TYPE_TRANSPORT:
+            if (const StaticTransport* t = ToStaticTransport())
+                if (t->GetPauseTime())
+                {
+                    if (GetGoState() == GO_STATE_READY)
+                    {
+                        if (t->GetPathProgress() >= t->GetPauseTime()) // if not, send 100% progress
+                            pathProgress = int16(float(t->GetPathProgress() - t->GetPauseTime()) / float(t->GetPeriod() - t->GetPauseTime()) * 65535.0f);
+                    }
+                    else
+                    {
+                        if (t->GetPathProgress() <= t->GetPauseTime()) // if not, send 100% progress
+                            pathProgress = int16(float(t->GetPathProgress()) / float(t->GetPauseTime()) * 65535.0f);
+                    }
+                }
+            // else it's ignored
+            break;
+        case GAMEOBJECT_TYPE_MO_TRANSPORT:
+            if (const MotionTransport* t = ToMotionTransport())
+                pathProgress = int16(float(t->GetPathProgress()) / float(t->GetPeriod()) * 65535.0f);
+            break;
+        default:
+            break;
+    }
+
+    return uint32(dynFlags) | (uint32(uint16(pathProgress)) << 16);
+}
+
+uint32 GameObject::GetFlagsValueForPlayer(Player* target) const
+{
+    uint32 goFlags = m_uint32Values[GAMEOBJECT_FLAGS];
+    if (GetGoType() == GAMEOBJECT_TYPE_CHEST && GetGOInfo() && GetGOInfo()->chest.groupLootRules && !IsLootAllowedFor(target))
+    {
+        goFlags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
+    }
+
+    return goFlags;
 }
 
 void GameObject::GetRespawnPosition(float& x, float& y, float& z, float* ori /* = nullptr*/) const
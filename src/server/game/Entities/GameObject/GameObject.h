@@ -123,6 +123,9 @@ public:
     ~GameObject() override;
 
     void BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target) override;
+    void PatchValuesUpdate(ByteBuffer& data, std::size_t blockPos, SharedValuesUpdate const& shared, Player* target);
+    [[nodiscard]] uint32 GetDynamicValueForPlayer(Player* target) const;
+    [[nodiscard]] uint32 GetFlagsValueForPlayer(Player* target) const;
 
     void AddToWorld() override;
     void RemoveFromWorld() override;
@@ -80,6 +80,7 @@ Object::Object() : m_PackGUID(sizeof(uint64) + 1)
 
     m_inWorld           = false;
     m_objectUpdated     = false;
+    _sharingValuesUpdates = false;
 
     sScriptMgr->OnConstructObject(this);
 }
@@ -246,14 +247,12 @@ void Object::SendUpdateToPlayer(Player* player)
 
 void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player* target)
 {
-    ByteBuffer buf(500);
+    ByteBuffer& buf = data->AppendUpdateBlock();
 
     buf << (uint8) UPDATETYPE_VALUES;
     buf << GetPackGUID();
 
     BuildValuesUpdate(UPDATETYPE_VALUES, &buf, target);
-
-    data->AddUpdateBlock(buf);
 }
 
 void Object::BuildOutOfRangeUpdateBlock(UpdateData* data) const
@@ -500,6 +499,16 @@ void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* targe
     uint32* flags = nullptr;
     uint32 visibleFlag = GetUpdateFieldData(target, flags);
 
+    bool share = updateType == UPDATETYPE_VALUES && IsSharingValuesUpdates();
+    if (share)
+    {
+        if (SharedValuesUpdate const* shared = Acore::Containers::MapGetValuePtr(_sharedValuesUpdates, visibleFlag))
+        {
+            data->append(shared->Buffer);
+            return;
+        }
+    }
+
     for (uint16 index = 0; index < m_valuesCount; ++index)
     {
         if (_fieldNotifyFlags & flags[index] ||
@@ -510,9 +519,19 @@ void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* targe
         }
     }
 
-    *data << uint8(updateMask.GetBlockCount());
-    updateMask.AppendToPacket(data);
-    data->append(fieldBuffer);
+    if (!share)
+    {
+        *data << uint8(updateMask.GetBlockCount());
+        updateMask.AppendToPacket(data);
+        data->append(fieldBuffer);
+        return;
+    }
+
+    SharedValuesUpdate& shared = _sharedValuesUpdates[visibleFlag];
+    shared.Buffer << uint8(updateMask.GetBlockCount());
+    updateMask.AppendToPacket(&shared.Buffer);
+    shared.Buffer.append(fieldBuffer);
+    data->append(shared.Buffer);
 }
 
 void Object::AddToObjectUpdateIfNeeded()
@@ -2994,6 +3013,9 @@ void WorldObject::AddToNotify(uint16 f)
 
 void WorldObject::BuildUpdate(UpdateDataMapType& data_map)
 {
+    // Observers with the same visibility class get the same values block, serialize it only once
+    BeginSharingValuesUpdates();
+
     // Build update for self
     if (IsPlayer())
         BuildFieldsUpdate(ToPlayer(), data_map);
@@ -3004,6 +3026,7 @@ void WorldObject::BuildUpdate(UpdateDataMapType& data_map)
         BuildFieldsUpdate(player, data_map);
     });
 
+    EndSharingValuesUpdates();
     ClearUpdateMask(false);
 }
 
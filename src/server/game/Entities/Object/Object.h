@@ -34,10 +34,12 @@
 #include "UpdateData.h"
 #include "UpdateMask.h"
 #include "ObjectVisibilityContainer.h"
+#include <array>
 #include <memory>
 #include <set>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
 #include "UpdateFields.h"
 
@@ -250,6 +252,20 @@ protected:
     void BuildMovementUpdate(ByteBuffer* data, uint16 flags) const;
     virtual void BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target);
 
+    // Values update block serialized once per BuildUpdate pass and shared by every observer of the same
+    // visibility class (visible update field flags). Fields that depend on the observer are patched at PatchPos.
+    struct SharedValuesUpdate
+    {
+        ByteBuffer Buffer;
+        std::array<int32, 2> PatchPos = { -1, -1 };
+    };
+
+    [[nodiscard]] bool IsSharingValuesUpdates() const { return _sharingValuesUpdates; }
+    void BeginSharingValuesUpdates() { _sharingValuesUpdates = true; }
+    void EndSharingValuesUpdates() { _sharingValuesUpdates = false; _sharedValuesUpdates.clear(); }
+
+    std::unordered_map<uint32 /*visibleFlag*/, SharedValuesUpdate> _sharedValuesUpdates;
+
     uint16 m_objectType;
 
     TypeID m_objectTypeId;
@@ -276,6 +292,7 @@ protected:
 
 private:
     bool m_inWorld;
+    bool _sharingValuesUpdates;
 
     PackedGuid m_PackGUID;
 
@@ -56,6 +56,8 @@ public:
     void AddOutOfRangeGUID(ObjectGuid guid);
     void AddUpdateBlock(const ByteBuffer& block);
     void AddUpdateBlock(const UpdateData& block);
+    // Starts a new block that the caller serializes directly into the packet data, without a temporary buffer
+    ByteBuffer& AppendUpdateBlock() { ++m_blockCount; return m_data; }
     bool BuildPacket(WorldPacket& packet);
     [[nodiscard]] bool HasData() const { return m_blockCount > 0 || !m_outOfRangeGUIDs.empty(); }
     void Clear();
@@ -5848,6 +5848,11 @@ void Player::SendDirectMessage(WorldPacket const* data) const
     m_session->SendPacket(data);
 }
 
+void Player::SendDirectMessage(SharedWorldPacket const& data) const
+{
+    m_session->SendPacket(data);
+}
+
 void Player::SendCinematicStart(uint32 CinematicSequenceId) const
 {
     WorldPacket data(SMSG_TRIGGER_CINEMATIC, 4);
@@ -14842,13 +14847,18 @@ void Player::_SaveEquipmentSets(CharacterDatabaseTransaction trans)
     }
 }
 
-void Player::_SaveEntryPoint(CharacterDatabaseTransaction trans)
+void Player::_SaveEntryPoint(CharacterDatabaseTransaction trans, bool fullSave)
 {
     // xinef: dont save joinpos with invalid mapid
     MapEntry const* mEntry = sMapStore.LookupEntry(m_entryPointData.joinPos.GetMapId());
     if (!mEntry)
         return;
 
+    if (!fullSave && m_entryPointData == m_savedEntryPointData)
+        return;
+
+    m_savedEntryPointData = m_entryPointData;
+
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PLAYER_ENTRY_POINT);
     stmt->SetData(0, GetGUID().GetCounter());
     trans->Append(stmt);
@@ -16037,6 +16047,8 @@ void Player::_LoadInstanceTimeRestrictions(PreparedQueryResult result)
         Field* fields = result->Fetch();
         _instanceResetTimes.insert(InstanceTimeMap::value_type(fields[0].Get<uint32>(), fields[1].Get<uint64>()));
     } while (result->NextRow());
+
+    _savedInstanceResetTimes = _instanceResetTimes;
 }
 
 void Player::_LoadBrewOfTheMonth(PreparedQueryResult result)
@@ -16128,11 +16140,16 @@ void Player::_LoadPetStable(uint8 petStableSlots, PreparedQueryResult result)
     }
 }
 
-void Player::_SaveInstanceTimeRestrictions(CharacterDatabaseTransaction trans)
+void Player::_SaveInstanceTimeRestrictions(CharacterDatabaseTransaction trans, bool fullSave)
 {
     if (_instanceResetTimes.empty())
         return;
 
+    if (!fullSave && _instanceResetTimes == _savedInstanceResetTimes)
+        return;
+
+    _savedInstanceResetTimes = _instanceResetTimes;
+
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ACCOUNT_INSTANCE_LOCK_TIMES);
     stmt->SetData(0, GetSession()->GetAccountId());
     trans->Append(stmt);
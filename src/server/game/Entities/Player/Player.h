@@ -47,6 +47,7 @@
 
 struct CreatureTemplate;
 struct Mail;
+struct PreparedStatementData;
 struct TrainerSpell;
 struct VendorItem;
 
@@ -1055,6 +1056,12 @@ struct EntryPointData
 
     void ClearTaxiPath() { taxiPath.fill(0); }
     [[nodiscard]] bool HasTaxiPath() const { return taxiPath[0] && taxiPath[1]; }
+
+    bool operator==(EntryPointData const& right) const
+    {
+        return mountSpell == right.mountSpell && taxiPath == right.taxiPath &&
+            joinPos.GetMapId() == right.joinPos.GetMapId() && joinPos == right.joinPos;
+    }
 };
 
 struct PendingSpellCastRequest
@@ -2253,6 +2260,7 @@ public:
     void SendInitWorldStates(uint32 zoneId, uint32 areaId);
     void SendUpdateWorldState(uint32 variable, uint32 value) const;
     void SendDirectMessage(WorldPacket const* data) const;
+    void SendDirectMessage(SharedWorldPacket const& data) const;
     void SendBGWeekendWorldStates();
     void SendBattlefieldWorldStates();
 
@@ -2715,6 +2723,7 @@ protected:
     /*********************************************************/
 
     EntryPointData m_entryPointData;
+    EntryPointData m_savedEntryPointData;                   // as last written to the DB, autosave skips the row while unchanged
 
     /*********************************************************/
     /***                    QUEST SYSTEM                   ***/
@@ -2780,13 +2789,13 @@ protected:
     void _SaveSeasonalQuestStatus(CharacterDatabaseTransaction trans);
     void _SaveSpells(CharacterDatabaseTransaction trans);
     void _SaveEquipmentSets(CharacterDatabaseTransaction trans);
-    void _SaveEntryPoint(CharacterDatabaseTransaction trans);
+    void _SaveEntryPoint(CharacterDatabaseTransaction trans, bool fullSave);
     void _SaveGlyphs(CharacterDatabaseTransaction trans);
     void _SaveTalents(CharacterDatabaseTransaction trans);
-    void _SaveStats(CharacterDatabaseTransaction trans);
+    void _SaveStats(CharacterDatabaseTransaction trans, bool fullSave);
     void _SaveCharacter(bool create, CharacterDatabaseTransaction trans);
-    void _SaveInstanceTimeRestrictions(CharacterDatabaseTransaction trans);
-    void _SavePlayerSettings(CharacterDatabaseTransaction trans);
+    void _SaveInstanceTimeRestrictions(CharacterDatabaseTransaction trans, bool fullSave);
+    void _SavePlayerSettings(CharacterDatabaseTransaction trans, bool fullSave);
 
     /*********************************************************/
     /***              ENVIRONMENTAL SYSTEM                 ***/
@@ -3021,6 +3030,7 @@ private:
     uint32 m_ChampioningFaction;
 
     InstanceTimeMap _instanceResetTimes;
+    InstanceTimeMap _savedInstanceResetTimes;
     uint32 _pendingBindId;
     uint32 _pendingBindTimer;
 
@@ -3041,6 +3051,9 @@ private:
     bool _wasOutdoor;
 
     PlayerSettingMap m_charSettingsMap;
+    std::set<std::string> m_charSettingsChanged;            // sources modified since the last save
+
+    std::vector<PreparedStatementData> m_savedStats;        // character_stats row as last written
 
     Seconds m_creationTime;
 
@@ -141,7 +141,7 @@ PlayerSetting Player::GetPlayerSetting(std::string const& source, uint32 index)
     return it->second[index];
 }
 
-void Player::_SavePlayerSettings(CharacterDatabaseTransaction trans)
+void Player::_SavePlayerSettings(CharacterDatabaseTransaction trans, bool fullSave)
 {
     if (!sWorld->getBoolConfig(CONFIG_PLAYER_SETTINGS_ENABLED))
         return;
@@ -151,9 +151,14 @@ void Player::_SavePlayerSettings(CharacterDatabaseTransaction trans)
         if (settings.empty())
             continue;
 
+        if (!fullSave && !m_charSettingsChanged.count(source))
+            continue;
+
         CharacterDatabasePreparedStatement* stmt = PlayerSettingsStore::PrepareReplaceStatement(GetGUID().GetCounter(), source, settings);
         trans->Append(stmt);
     }
+
+    m_charSettingsChanged.clear();
 }
 
 void Player::UpdatePlayerSetting(std::string const& source, uint32 index, uint32 value)
@@ -168,13 +173,21 @@ void Player::UpdatePlayerSetting(std::string const& source, uint32 index, uint32
         settings[index].value = value;
 
         m_charSettingsMap.emplace(source, std::move(settings));
+        m_charSettingsChanged.insert(source);
     }
     else
     {
         PlayerSettingVector& settings = it->second;
         if (settings.size() < requiredSize)
+        {
             settings.resize(requiredSize); // new elements default to zero
+            m_charSettingsChanged.insert(source);
+        }
 
-        settings[index].value = value;
+        if (settings[index].value != value)
+        {
+            settings[index].value = value;
+            m_charSettingsChanged.insert(source);
+        }
     }
 }
@@ -41,6 +41,7 @@
 #include "Log.h"
 #include "LootItemStorage.h"
 #include "MapMgr.h"
+#include "Metric.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "Opcodes.h"
@@ -4887,6 +4888,8 @@ void Player::_LoadEntryPointData(PreparedQueryResult result)
     m_entryPointData.taxiPath[0] = fields[5].Get<uint32>();
     m_entryPointData.taxiPath[1] = fields[6].Get<uint32>();
     m_entryPointData.mountSpell = fields[7].Get<uint32>();
+
+    m_savedEntryPointData = m_entryPointData;
 }
 
 bool Player::LoadPositionFromDB(uint32& mapid, float& x, float& y, float& z, float& o, bool& in_flight, ObjectGuid::LowType guid)
@@ -7103,6 +7106,11 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logo
     m_additionalSaveTimer = 0;
     m_additionalSaveMask = 0;
 
+    // rows that track their own changes are written when dirty, the rest only when they differ from the last save
+    // creating and logging out rewrite them unconditionally
+    bool const fullSave = create || logout;
+    std::size_t const savedBytes = trans->GetDataSize();
+
     // first save/honor gain after midnight will also update the player's honor fields
     UpdateHonorFields();
 
@@ -7117,7 +7125,7 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logo
     if (m_mailsUpdated)                                     //save mails only when needed
         _SaveMail(trans);
 
-    _SaveEntryPoint(trans);
+    _SaveEntryPoint(trans, fullSave);
     _SaveInventory(trans);
     _SaveQuestStatus(trans);
     _SaveDailyQuestStatus(trans);
@@ -7135,13 +7143,17 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logo
     _SaveEquipmentSets(trans);
     GetSession()->SaveTutorialsData(trans);                 // changed only while character in game
     _SaveGlyphs(trans);
-    _SaveInstanceTimeRestrictions(trans);
-    _SavePlayerSettings(trans);
+    _SaveInstanceTimeRestrictions(trans, fullSave);
+    _SavePlayerSettings(trans, fullSave);
 
     // check if stats should only be saved on logout
     // save stats can be out of transaction
     if (m_session->isLogingOut() || !sWorld->getBoolConfig(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT))
-        _SaveStats(trans);
+        _SaveStats(trans, fullSave);
+
+    std::size_t const bytes = trans->GetDataSize() - savedBytes;
+    LOG_DEBUG("entities.player", "Player {} saved {} bytes ({} save)", GetName(), bytes, fullSave ? "full" : "incremental");
+    METRIC_VALUE("player_save_bytes", uint64(bytes), METRIC_TAG("type", fullSave ? "full" : "incremental"));
 
     // save pet (hunter pet level and experience and all type pets health/mana).
     if (Pet* pet = GetPet())
@@ -7769,18 +7781,13 @@ void Player::_SaveSpells(CharacterDatabaseTransaction trans)
 
 // save player stats -- only for external usage
 // real stats will be recalculated on player login
-void Player::_SaveStats(CharacterDatabaseTransaction trans)
+void Player::_SaveStats(CharacterDatabaseTransaction trans, bool fullSave)
 {
     // check if stat saving is enabled and if char level is high enough
     if (!sWorld->getIntConfig(CONFIG_MIN_LEVEL_STAT_SAVE) || GetLevel() < sWorld->getIntConfig(CONFIG_MIN_LEVEL_STAT_SAVE))
         return;
 
     CharacterDatabasePreparedStatement* stmt = nullptr;
-
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_STATS);
-    stmt->SetData(0, GetGUID().GetCounter());
-    trans->Append(stmt);
-
     uint8 index = 0;
 
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_STATS);
@@ -7807,6 +7814,20 @@ void Player::_SaveStats(CharacterDatabaseTransaction trans)
     stmt->SetData(index++, GetBaseSpellPowerBonus());
     stmt->SetData(index++, GetUInt32Value(PLAYER_FIELD_COMBAT_RATING_1 + static_cast<uint16>(CR_CRIT_TAKEN_SPELL)));
 
+    std::vector<PreparedStatementData> const& stats = stmt->GetParameters();
+    if (!fullSave && std::equal(stats.begin(), stats.end(), m_savedStats.begin(), m_savedStats.end(),
+        [](PreparedStatementData const& left, PreparedStatementData const& right) { return left.data == right.data; }))
+    {
+        delete stmt;
+        return;
+    }
+
+    m_savedStats = stats;
+
+    CharacterDatabasePreparedStatement* deleteStmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_STATS);
+    deleteStmt->SetData(0, GetGUID().GetCounter());
+    trans->Append(deleteStmt);
+
     trans->Append(stmt);
 }
 
@@ -28,6 +28,91 @@
 #include "Pet.h"
 #include "Player.h"
 #include "Transport.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    template<class T>
+    struct alignas(64) LookupShard
+    {
+        std::shared_mutex Lock;
+        typename HashMapHolder<T>::MapType Objects;
+    };
+
+    template<class T>
+    std::array<LookupShard<T>, HashMapHolder<T>::LOOKUP_SHARDS>& GetLookupShards()
+    {
+        static std::array<LookupShard<T>, HashMapHolder<T>::LOOKUP_SHARDS> _shards;
+        return _shards;
+    }
+
+    template<class T>
+    LookupShard<T>& GetLookupShard(ObjectGuid guid)
+    {
+        return GetLookupShards<T>()[guid.GetCounter() % HashMapHolder<T>::LOOKUP_SHARDS];
+    }
+
+    struct LookupCounters
+    {
+        std::atomic<uint64> Lookups{0};
+        std::atomic<uint64> Contended{0};
+    };
+
+    // Counters of running threads, what exited threads counted and the totals at the last reset
+    template<class T>
+    struct LookupCounterRegistry
+    {
+        std::mutex Lock;
+        std::vector<LookupCounters const*> Live;
+        typename HashMapHolder<T>::LookupStats Retired;
+        typename HashMapHolder<T>::LookupStats Reported;
+    };
+
+    template<class T>
+    LookupCounterRegistry<T>& GetLookupCounterRegistry()
+    {
+        static LookupCounterRegistry<T> _registry;
+        return _registry;
+    }
+
+    template<class T>
+    struct ThreadLookupCounters : LookupCounters
+    {
+        ThreadLookupCounters()
+        {
+            LookupCounterRegistry<T>& registry = GetLookupCounterRegistry<T>();
+            std::lock_guard<std::mutex> lock(registry.Lock);
+            registry.Live.push_back(this);
+        }
+
+        ~ThreadLookupCounters()
+        {
+            LookupCounterRegistry<T>& registry = GetLookupCounterRegistry<T>();
+            std::lock_guard<std::mutex> lock(registry.Lock);
+            std::erase(registry.Live, this);
+            registry.Retired.Lookups += Lookups.load(std::memory_order_relaxed);
+            registry.Retired.Contended += Contended.load(std::memory_order_relaxed);
+        }
+    };
+
+    // Counting in the shard would write the cache line holding its lock on every lookup
+    template<class T>
+    LookupCounters& GetThreadLookupCounters()
+    {
+        thread_local ThreadLookupCounters<T> _counters;
+        return _counters;
+    }
+
+    void Count(std::atomic<uint64>& counter)
+    {
+        // Only the thread that looks objects up increments its counters, GetLookupStats() sums them under
+        // the registry lock until the thread exits and its counts are moved to Retired
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+}
 
 template<class T>
 void HashMapHolder<T>::Insert(T* o)
@@ -39,6 +124,10 @@ void HashMapHolder<T>::Insert(T* o)
     std::unique_lock<std::shared_mutex> lock(*GetLock());
 
     GetContainer()[o->GetGUID()] = o;
+
+    LookupShard<T>& shard = GetLookupShard<T>(o->GetGUID());
+    std::unique_lock<std::shared_mutex> shardLock(shard.Lock);
+    shard.Objects[o->GetGUID()] = o;
 }
 
 template<class T>
@@ -47,15 +136,28 @@ void HashMapHolder<T>::Remove(T* o)
     std::unique_lock<std::shared_mutex> lock(*GetLock());
 
     GetContainer().erase(o->GetGUID());
+
+    LookupShard<T>& shard = GetLookupShard<T>(o->GetGUID());
+    std::unique_lock<std::shared_mutex> shardLock(shard.Lock);
+    shard.Objects.erase(o->GetGUID());
 }
 
 template<class T>
 T* HashMapHolder<T>::Find(ObjectGuid guid)
 {
-    std::shared_lock<std::shared_mutex> lock(*GetLock());
+    LookupShard<T>& shard = GetLookupShard<T>(guid);
+    LookupCounters& counters = GetThreadLookupCounters<T>();
+    Count(counters.Lookups);
 
-    typename MapType::iterator itr = GetContainer().find(guid);
-    return (itr != GetContainer().end()) ? itr->second : nullptr;
+    std::shared_lock<std::shared_mutex> lock(shard.Lock, std::try_to_lock);
+    if (!lock.owns_lock())
+    {
+        Count(counters.Contended);
+        lock.lock();
+    }
+
+    typename MapType::iterator itr = shard.Objects.find(guid);
+    return (itr != shard.Objects.end()) ? itr->second : nullptr;
 }
 
 template<class T>
@@ -72,6 +174,28 @@ std::shared_mutex* HashMapHolder<T>::GetLock()
     return &_lock;
 }
 
+template<class T>
+auto HashMapHolder<T>::GetLookupStats(bool reset) -> LookupStats
+{
+    LookupCounterRegistry<T>& registry = GetLookupCounterRegistry<T>();
+    std::lock_guard<std::mutex> lock(registry.Lock);
+
+    LookupStats total = registry.Retired;
+    for (LookupCounters const* counters : registry.Live)
+    {
+        total.Lookups += counters->Lookups.load(std::memory_order_relaxed);
+        total.Contended += counters->Contended.load(std::memory_order_relaxed);
+    }
+
+    LookupStats stats;
+    stats.Lookups = total.Lookups - registry.Reported.Lookups;
+    stats.Contended = total.Contended - registry.Reported.Contended;
+    if (reset)
+        registry.Reported = total;
+
+    return stats;
+}
+
 HashMapHolder<Player>::MapType const& ObjectAccessor::GetPlayers()
 {
     return HashMapHolder<Player>::GetContainer();
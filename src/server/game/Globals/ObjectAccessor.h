@@ -36,6 +36,13 @@ class Transport;
 class StaticTransport;
 class MotionTransport;
 
+/**
+ * Global registry of objects that can be found from any map.
+ *
+ * GetContainer() and GetLock() are kept for iterating every object. Find() does not use them, it reads
+ * one of LOOKUP_SHARDS smaller maps selected by the low bits of the guid counter, each with its own lock
+ * on its own cache line, so lookups from different map threads rarely touch the same lock.
+ */
 template <class T>
 class HashMapHolder
 {
@@ -43,9 +50,16 @@ class HashMapHolder
     HashMapHolder() = default;
 
 public:
+    static constexpr std::size_t LOOKUP_SHARDS = 32;
 
     typedef std::unordered_map<ObjectGuid, T*> MapType;
 
+    struct LookupStats
+    {
+        uint64 Lookups = 0;
+        uint64 Contended = 0;   // lookups that had to wait for a writer on their shard
+    };
+
     static void Insert(T* o);
 
     static void Remove(T* o);
@@ -55,6 +69,9 @@ public:
     static MapType& GetContainer();
 
     static std::shared_mutex* GetLock();
+
+    // Sums what every thread counted since the last reset, reset starts the next reporting interval
+    static LookupStats GetLookupStats(bool reset = false);
 };
 
 namespace ObjectAccessor
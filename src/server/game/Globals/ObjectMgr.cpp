@@ -524,7 +524,7 @@ void ObjectMgr::LoadCreatureTemplates()
     uint32 oldMSTime = getMSTime();
 
 //                                                   0      1                   2                   3                   4            5            6     7        8
-    QueryResult result = WorldDatabase.Query("SELECT entry, difficulty_entry_1, difficulty_entry_2, difficulty_entry_3, KillCredit1, KillCredit2, name, subname, IconName, "
+    QueryResult result = WorldDatabase.QuerySnapshot("creature_template", "SELECT entry, difficulty_entry_1, difficulty_entry_2, difficulty_entry_3, KillCredit1, KillCredit2, name, subname, IconName, "
 //                        9               10        11        12   13       14       15          16         17          18            19               20     21      22
                          "gossip_menu_id, minlevel, maxlevel, exp, faction, npcflag, speed_walk, speed_run, speed_swim, speed_flight, detection_range, scale, `rank`, dmgschool, "
 //                        23              24              25               26            27             28          29          30           31            32      33            34
@@ -720,15 +720,8 @@ void ObjectMgr::LoadCreatureTemplateModels()
     }
 
     uint32 count = 0;
-    do
+    for (auto [creatureId, creatureDisplayId, displayScale, probability] : result->Rows<uint32, uint32, float, float>())
     {
-        Field* fields = result->Fetch();
-
-        uint32 creatureId = fields[0].Get<uint32>();
-        uint32 creatureDisplayId = fields[1].Get<uint32>();
-        float displayScale = fields[2].Get<float>();
-        float probability = fields[3].Get<float>();
-
         CreatureTemplate const* cInfo = GetCreatureTemplate(creatureId);
         if (!cInfo)
         {
@@ -753,7 +746,7 @@ void ObjectMgr::LoadCreatureTemplateModels()
         const_cast<CreatureTemplate*>(cInfo)->Models.emplace_back(creatureDisplayId, displayScale, probability);
 
         ++count;
-    } while (result->NextRow());
+    }
 
     LOG_INFO("server.loading", ">> Loaded {} creature template models in {} ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
@@ -2881,7 +2874,7 @@ void ObjectMgr::LoadItemTemplates()
     uint32 oldMSTime = getMSTime();
 
     //                                                 0      1       2               3              4        5        6       7          8         9        10        11           12
-    QueryResult result = WorldDatabase.Query("SELECT entry, class, subclass, SoundOverrideSubclass, name, displayid, Quality, Flags, FlagsExtra, BuyCount, BuyPrice, SellPrice, InventoryType, "
+    QueryResult result = WorldDatabase.QuerySnapshot("item_template", "SELECT entry, class, subclass, SoundOverrideSubclass, name, displayid, Quality, Flags, FlagsExtra, BuyCount, BuyPrice, SellPrice, InventoryType, "
                          //     13              14           15          16             17               18                19              20
                          "AllowableClass, AllowableRace, ItemLevel, RequiredLevel, RequiredSkill, RequiredSkillRank, requiredspell, requiredhonorrank, "
                          //      21                      22                       23               24        25          26             27
@@ -4638,7 +4631,7 @@ void ObjectMgr::LoadQuests()
 
     mExclusiveQuestGroups.clear();
 
-    QueryResult result = WorldDatabase.Query("SELECT "
+    QueryResult result = WorldDatabase.QuerySnapshot("quest_template", "SELECT "
                          //0      1         2           3           4           5             6                 7            8
                          "ID, QuestType, QuestLevel, MinLevel, QuestSortID, QuestInfoID, SuggestedGroupNum, TimeAllowed, AllowableRaces,"
                          //      9                     10                   11                    12
@@ -7391,7 +7384,7 @@ void ObjectMgr::LoadGameObjectTemplate()
     uint32 oldMSTime = getMSTime();
 
     //                                                 0      1      2        3       4             5          6      7
-    QueryResult result = WorldDatabase.Query("SELECT entry, type, displayId, name, IconName, castBarCaption, unk1, size, "
+    QueryResult result = WorldDatabase.QuerySnapshot("gameobject_template", "SELECT entry, type, displayId, name, IconName, castBarCaption, unk1, size, "
                          //                                          8      9      10     11     12     13     14     15     16     17     18      19      20
                          "Data0, Data1, Data2, Data3, Data4, Data5, Data6, Data7, Data8, Data9, Data10, Data11, Data12, "
                          //                                          21      22      23      24      25      26      27      28      29      30      31      32        33
@@ -3,6 +3,9 @@
 #include "GridTerrainData.h"
 #include "Log.h"
 #include "MapDefines.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstring>
 #include <filesystem>
 #include <G3D/Ray.h>
 
@@ -14,6 +17,8 @@ GridTerrainData::GridTerrainData()
     _gridGetHeight = &GridTerrainData::getHeightFromFlat;
 }
 
+GridTerrainData::~GridTerrainData() = default;
+
 TerrainMapDataReadResult GridTerrainData::Load(std::string const& mapFileName)
 {
     // Check if file exists, we do this first as we need to
@@ -21,14 +26,29 @@ TerrainMapDataReadResult GridTerrainData::Load(std::string const& mapFileName)
     if (!std::filesystem::exists(mapFileName))
         return TerrainMapDataReadResult::NotFound;
 
-    // Start the input stream and check for any errors
-    std::ifstream fileStream(mapFileName, std::ios::binary);
-    if (fileStream.fail())
+    // Map the file, the terrain arrays are used in place and stay shared with the page cache
+    std::error_code error;
+    if (std::filesystem::file_size(mapFileName, error) < sizeof(map_fileheader) || error)
         return TerrainMapDataReadResult::ReadError;
 
+    try
+    {
+        boost::interprocess::file_mapping file(mapFileName.c_str(), boost::interprocess::read_only);
+        _region = std::make_unique<boost::interprocess::mapped_region>(file, boost::interprocess::read_only);
+    }
+    catch (boost::interprocess::interprocess_exception const&)
+    {
+        return TerrainMapDataReadResult::ReadError;
+    }
+
+    // Start reading the pages in the background, accessing them later should not block on I/O
+    _region->advise(boost::interprocess::mapped_region::advice_willneed);
+    _fileData = static_cast<char const*>(_region->get_address());
+    _fileSize = _region->get_size();
+
     // Read the map header
     map_fileheader header;
-    if (!fileStream.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    if (!ReadStruct(0, header))
         return TerrainMapDataReadResult::ReadError;
 
     // Check for valid map and version magics
@@ -36,60 +56,100 @@ TerrainMapDataReadResult GridTerrainData::Load(std::string const& mapFileName)
         return TerrainMapDataReadResult::InvalidMagic;
 
     // Load area data
-    if (header.areaMapOffset && !LoadAreaData(fileStream, header.areaMapOffset))
+    if (header.areaMapOffset && !LoadAreaData(header.areaMapOffset))
         return TerrainMapDataReadResult::InvalidAreaData;
 
     // Load height data
-    if (header.heightMapOffset && !LoadHeightData(fileStream, header.heightMapOffset))
+    if (header.heightMapOffset && !LoadHeightData(header.heightMapOffset))
         return TerrainMapDataReadResult::InvalidHeightData;
 
     // Load liquid data
-    if (header.liquidMapOffset && !LoadLiquidData(fileStream, header.liquidMapOffset))
+    if (header.liquidMapOffset && !LoadLiquidData(header.liquidMapOffset))
         return TerrainMapDataReadResult::InvalidLiquidData;
 
     // Load hole data
-    if (header.holesSize && !LoadHolesData(fileStream, header.holesOffset))
+    if (header.holesSize && !LoadHolesData(header.holesOffset))
         return TerrainMapDataReadResult::InvalidHoleData;
 
     return TerrainMapDataReadResult::Success;
 }
 
-bool GridTerrainData::LoadAreaData(std::ifstream& fileStream, uint32 const offset)
+template<typename T>
+bool GridTerrainData::ReadStruct(std::size_t offset, T& value) const
+{
+    if (offset > _fileSize || _fileSize - offset < sizeof(T))
+        return false;
+
+    std::memcpy(&value, _fileData + offset, sizeof(T));
+    return true;
+}
+
+template<typename T>
+T const* GridTerrainData::GetArray(std::size_t offset, std::size_t count)
 {
-    fileStream.seekg(offset);
+    std::size_t const size = count * sizeof(T);
+    if (offset > _fileSize || _fileSize - offset < size)
+        return nullptr;
+
+    char const* data = _fileData + offset;
+    if (reinterpret_cast<std::uintptr_t>(data) % alignof(T) == 0)
+        return reinterpret_cast<T const*>(data);
+
+    // Arrays following an odd sized one are not aligned in the file, those get a heap copy
+    std::unique_ptr<char[]> copy(new char[size]);
+    std::memcpy(copy.get(), data, size);
+    _heapSize += size;
+    return reinterpret_cast<T const*>(_copies.emplace_back(std::move(copy)).get());
+}
 
+bool GridTerrainData::LoadAreaData(uint32 const offset)
+{
     map_areaHeader header;
-    if (!fileStream.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.fourcc != MapAreaMagic.asUInt)
+    if (!ReadStruct(offset, header) || header.fourcc != MapAreaMagic.asUInt)
         return false;
 
     _loadedAreaData = std::make_unique<LoadedAreaData>();
+    _heapSize += sizeof(LoadedAreaData);
     _loadedAreaData->gridArea = header.gridArea;
     if (!(header.flags & MAP_AREA_NO_AREA))
     {
-        _loadedAreaData->areaMap = std::make_unique<LoadedAreaData::AreaMapType>();
-        if (!fileStream.read(reinterpret_cast<char*>(_loadedAreaData->areaMap.get()), sizeof(LoadedAreaData::AreaMapType)))
+        _loadedAreaData->areaMap = GetArray<uint16>(offset + sizeof(header), LoadedAreaData::AREA_MAP_SIZE);
+        if (!_loadedAreaData->areaMap)
             return false;
     }
     return true;
 }
 
-bool GridTerrainData::LoadHeightData(std::ifstream& fileStream, uint32 const offset)
+template<typename HeightData>
+bool GridTerrainData::LoadHeightArrays(HeightData& heightData, std::size_t& offset)
 {
-    fileStream.seekg(offset);
+    typedef typename HeightData::ValueType ValueType;
+
+    heightData.v9 = GetArray<ValueType>(offset, LoadedHeightData::V9_SIZE);
+    offset += LoadedHeightData::V9_SIZE * sizeof(ValueType);
+    heightData.v8 = GetArray<ValueType>(offset, LoadedHeightData::V8_SIZE);
+    offset += LoadedHeightData::V8_SIZE * sizeof(ValueType);
+    return heightData.v9 && heightData.v8;
+}
 
+bool GridTerrainData::LoadHeightData(uint32 const offset)
+{
     map_heightHeader header;
-    if (!fileStream.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.fourcc != MapHeightMagic.asUInt)
+    if (!ReadStruct(offset, header) || header.fourcc != MapHeightMagic.asUInt)
         return false;
 
+    std::size_t position = offset + sizeof(header);
+
     _loadedHeightData = std::make_unique<LoadedHeightData>();
+    _heapSize += sizeof(LoadedHeightData);
     _loadedHeightData->gridHeight = header.gridHeight;
     if (!(header.flags & MAP_HEIGHT_NO_HEIGHT))
     {
         if ((header.flags & MAP_HEIGHT_AS_INT16))
         {
             _loadedHeightData->uint16HeightData = std::make_unique<LoadedHeightData::Uint16HeightData>();
-            if (!fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->uint16HeightData->v9), sizeof(_loadedHeightData->uint16HeightData->v9))
-                || !fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->uint16HeightData->v8), sizeof(_loadedHeightData->uint16HeightData->v8)))
+            _heapSize += sizeof(LoadedHeightData::Uint16HeightData);
+            if (!LoadHeightArrays(*_loadedHeightData->uint16HeightData, position))
                 return false;
 
             _loadedHeightData->uint16HeightData->gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
@@ -98,8 +158,8 @@ bool GridTerrainData::LoadHeightData(std::ifstream& fileStream, uint32 const off
         else if ((header.flags & MAP_HEIGHT_AS_INT8))
         {
             _loadedHeightData->uint8HeightData = std::make_unique<LoadedHeightData::Uint8HeightData>();
-            if (!fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->uint8HeightData->v9), sizeof(_loadedHeightData->uint8HeightData->v9))
-                || !fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->uint8HeightData->v8), sizeof(_loadedHeightData->uint8HeightData->v8)))
+            _heapSize += sizeof(LoadedHeightData::Uint8HeightData);
+            if (!LoadHeightArrays(*_loadedHeightData->uint8HeightData, position))
                 return false;
 
             _loadedHeightData->uint8HeightData->gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
@@ -108,8 +168,8 @@ bool GridTerrainData::LoadHeightData(std::ifstream& fileStream, uint32 const off
         else
         {
             _loadedHeightData->floatHeightData = std::make_unique<LoadedHeightData::FloatHeightData>();
-            if (!fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->floatHeightData->v9), sizeof(_loadedHeightData->floatHeightData->v9))
-                || !fileStream.read(reinterpret_cast<char*>(&_loadedHeightData->floatHeightData->v8), sizeof(_loadedHeightData->floatHeightData->v8)))
+            _heapSize += sizeof(LoadedHeightData::FloatHeightData);
+            if (!LoadHeightArrays(*_loadedHeightData->floatHeightData, position))
                 return false;
 
             _gridGetHeight = &GridTerrainData::getHeightFromFloat;
@@ -122,8 +182,7 @@ bool GridTerrainData::LoadHeightData(std::ifstream& fileStream, uint32 const off
     {
         std::array<int16, 9> maxHeights;
         std::array<int16, 9> minHeights;
-        if (!fileStream.read(reinterpret_cast<char*>(maxHeights.data()), sizeof(maxHeights)) ||
-            !fileStream.read(reinterpret_cast<char*>(minHeights.data()), sizeof(minHeights)))
+        if (!ReadStruct(position, maxHeights) || !ReadStruct(position + sizeof(maxHeights), minHeights))
             return false;
 
         static uint32 constexpr indices[8][3] =
@@ -152,6 +211,7 @@ bool GridTerrainData::LoadHeightData(std::ifstream& fileStream, uint32 const off
         };
 
         _loadedHeightData->minHeightPlanes = std::make_unique<LoadedHeightData::HeightPlanesType>();
+        _heapSize += sizeof(LoadedHeightData::HeightPlanesType);
         for (uint32 quarterIndex = 0; quarterIndex < _loadedHeightData->minHeightPlanes->size(); ++quarterIndex)
             _loadedHeightData->minHeightPlanes->at(quarterIndex) = G3D::Plane(
                 G3D::Vector3(boundGridCoords[indices[quarterIndex][0]][0], boundGridCoords[indices[quarterIndex][0]][1], minHeights[indices[quarterIndex][0]]),
@@ -163,15 +223,16 @@ bool GridTerrainData::LoadHeightData(std::ifstream& fileStream, uint32 const off
     return true;
 }
 
-bool GridTerrainData::LoadLiquidData(std::ifstream& fileStream, uint32 const offset)
+bool GridTerrainData::LoadLiquidData(uint32 const offset)
 {
-    fileStream.seekg(offset);
-
     map_liquidHeader header;
-    if (!fileStream.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.fourcc != MapLiquidMagic.asUInt)
+    if (!ReadStruct(offset, header) || header.fourcc != MapLiquidMagic.asUInt)
         return false;
 
+    std::size_t position = offset + sizeof(header);
+
     _loadedLiquidData = std::make_unique<LoadedLiquidData>();
+    _heapSize += sizeof(LoadedLiquidData);
     _loadedLiquidData->liquidGlobalEntry = header.liquidType;
     _loadedLiquidData->liquidGlobalFlags = header.liquidFlags;
     _loadedLiquidData->liquidOffX = header.offsetX;
@@ -182,33 +243,28 @@ bool GridTerrainData::LoadLiquidData(std::ifstream& fileStream, uint32 const off
 
     if (!(header.flags & MAP_LIQUID_NO_TYPE))
     {
-        _loadedLiquidData->liquidEntry = std::make_unique<LoadedLiquidData::LiquidEntryType>();
-        if (!fileStream.read(reinterpret_cast<char*>(_loadedLiquidData->liquidEntry.get()), sizeof(LoadedLiquidData::LiquidEntryType)))
-            return false;
-
-        _loadedLiquidData->liquidFlags = std::make_unique<LoadedLiquidData::LiquidFlagsType>();
-        if (!fileStream.read(reinterpret_cast<char*>(_loadedLiquidData->liquidFlags.get()), sizeof(LoadedLiquidData::LiquidFlagsType)))
+        _loadedLiquidData->liquidEntry = GetArray<uint16>(position, LoadedLiquidData::LIQUID_MAP_SIZE);
+        position += LoadedLiquidData::LIQUID_MAP_SIZE * sizeof(uint16);
+        _loadedLiquidData->liquidFlags = GetArray<uint8>(position, LoadedLiquidData::LIQUID_MAP_SIZE);
+        position += LoadedLiquidData::LIQUID_MAP_SIZE * sizeof(uint8);
+        if (!_loadedLiquidData->liquidEntry || !_loadedLiquidData->liquidFlags)
             return false;
     }
     if (!(header.flags & MAP_LIQUID_NO_HEIGHT))
     {
-        _loadedLiquidData->liquidMap = std::make_unique<LoadedLiquidData::LiquidMapType>();
-        _loadedLiquidData->liquidMap->resize(_loadedLiquidData->liquidWidth * _loadedLiquidData->liquidHeight);
-        if (!fileStream.read(reinterpret_cast<char*>(_loadedLiquidData->liquidMap->data()), _loadedLiquidData->liquidMap->size() * sizeof(float)))
+        _loadedLiquidData->liquidMap = GetArray<float>(position, _loadedLiquidData->liquidWidth * _loadedLiquidData->liquidHeight);
+        if (!_loadedLiquidData->liquidMap)
             return false;
     }
     return true;
 }
 
-bool GridTerrainData::LoadHolesData(std::ifstream& fileStream, uint32 const offset)
+bool GridTerrainData::LoadHolesData(uint32 const offset)
 {
-    fileStream.seekg(offset);
-
     _loadedHoleData = std::make_unique<LoadedHoleData>();
-    if (!fileStream.read(reinterpret_cast<char*>(&_loadedHoleData->holes), sizeof(_loadedHoleData->holes)))
-        return false;
-
-    return true;
+    _heapSize += sizeof(LoadedHoleData);
+    _loadedHoleData->holes = GetArray<uint16>(offset, LoadedHoleData::HOLES_SIZE);
+    return _loadedHoleData->holes != nullptr;
 }
 
 uint16 GridTerrainData::getArea(float x, float y) const
@@ -223,7 +279,7 @@ uint16 GridTerrainData::getArea(float x, float y) const
     y = 16 * (32 - y / SIZE_OF_GRIDS);
     int lx = (int)x & 15;
     int ly = (int)y & 15;
-    return _loadedAreaData->areaMap->at(lx * 16 + ly);
+    return _loadedAreaData->areaMap[lx * 16 + ly];
 }
 
 float GridTerrainData::getHeightFromFlat(float /*x*/, float /*y*/) const
@@ -338,7 +394,7 @@ float GridTerrainData::getHeightFromUint8(float x, float y) const
         return INVALID_HEIGHT;
 
     int32 a, b, c;
-    uint8* V9_h1_ptr = &_loadedHeightData->uint8HeightData->v9[x_int * 128 + x_int + y_int];
+    uint8 const* V9_h1_ptr = &_loadedHeightData->uint8HeightData->v9[x_int * 128 + x_int + y_int];
     if (x + y < 1)
     {
         if (x > y)
@@ -408,7 +464,7 @@ float GridTerrainData::getHeightFromUint16(float x, float y) const
         return INVALID_HEIGHT;
 
     int32 a, b, c;
-    uint16* V9_h1_ptr = &_loadedHeightData->uint16HeightData->v9[x_int * 128 + x_int + y_int];
+    uint16 const* V9_h1_ptr = &_loadedHeightData->uint16HeightData->v9[x_int * 128 + x_int + y_int];
     if (x + y < 1)
     {
         if (x > y)
@@ -523,7 +579,7 @@ float GridTerrainData::getLiquidLevel(float x, float y) const
     if (cy_int < 0 || cy_int >= _loadedLiquidData->liquidWidth)
         return INVALID_HEIGHT;
 
-    return _loadedLiquidData->liquidMap->at(cx_int * _loadedLiquidData->liquidWidth + cy_int);
+    return _loadedLiquidData->liquidMap[cx_int * _loadedLiquidData->liquidWidth + cy_int];
 }
 
 // Get water state on map
@@ -545,8 +601,8 @@ LiquidData const GridTerrainData::GetLiquidData(float x, float y, float z, float
 
         // Check water type in cell
         int idx = (x_int >> 3) * 16 + (y_int >> 3);
-        uint8 type = _loadedLiquidData->liquidFlags ? _loadedLiquidData->liquidFlags->at(idx) : _loadedLiquidData->liquidGlobalFlags;
-        uint32 entry = _loadedLiquidData->liquidEntry ? _loadedLiquidData->liquidEntry->at(idx) : _loadedLiquidData->liquidGlobalEntry;
+        uint8 type = _loadedLiquidData->liquidFlags ? _loadedLiquidData->liquidFlags[idx] : _loadedLiquidData->liquidGlobalFlags;
+        uint32 entry = _loadedLiquidData->liquidEntry ? _loadedLiquidData->liquidEntry[idx] : _loadedLiquidData->liquidGlobalEntry;
         if (LiquidTypeEntry const* liquidEntry = sLiquidTypeStore.LookupEntry(entry))
         {
             type &= MAP_LIQUID_TYPE_DARK_WATER;
@@ -584,7 +640,7 @@ LiquidData const GridTerrainData::GetLiquidData(float x, float y, float z, float
             if (lx_int >= 0 && lx_int < _loadedLiquidData->liquidHeight && ly_int >= 0 && ly_int < _loadedLiquidData->liquidWidth)
             {
                 // Get water level
-                float liquid_level = _loadedLiquidData->liquidMap ? _loadedLiquidData->liquidMap->at(lx_int * _loadedLiquidData->liquidWidth + ly_int) : _loadedLiquidData->liquidLevel;
+                float liquid_level = _loadedLiquidData->liquidMap ? _loadedLiquidData->liquidMap[lx_int * _loadedLiquidData->liquidWidth + ly_int] : _loadedLiquidData->liquidLevel;
                 // Get ground level
                 float ground_level = getHeight(x, y);
 
@@ -19,9 +19,16 @@
 #define GRID_TERRAIN_DATA_H
 
 #include "Common.h"
+#include <array>
 #include <fstream>
 #include <G3D/Plane.h>
 #include <memory>
+#include <vector>
+
+namespace boost::interprocess
+{
+    class mapped_region;
+}
 
 #define MAX_HEIGHT            100000.0f                     // can be use for find ground height at surface
 #define INVALID_HEIGHT       -100000.0f                     // for check, must be equal to VMAP_INVALID_HEIGHT, real value for unknown height is VMAP_INVALID_HEIGHT_VALUE
@@ -113,45 +120,47 @@ struct map_liquidHeader
 // Loaded map data structures
 // ******************************************
 
+// The arrays point into the memory mapped .map file (or a heap copy if their offset is not aligned)
+
 struct LoadedAreaData
 {
-    typedef std::array<uint16, 16 * 16> AreaMapType;
+    static constexpr std::size_t AREA_MAP_SIZE = 16 * 16;
 
     uint16 gridArea;
-    std::unique_ptr<AreaMapType> areaMap;
+    uint16 const* areaMap = nullptr;
 };
 
 struct LoadedHeightData
 {
     typedef std::array<G3D::Plane, 8> HeightPlanesType;
 
+    static constexpr std::size_t V9_SIZE = 129 * 129;
+    static constexpr std::size_t V8_SIZE = 128 * 128;
+
     struct Uint16HeightData
     {
-        typedef std::array<uint16, 129 * 129> V9Type;
-        typedef std::array<uint16, 128 * 128> V8Type;
+        typedef uint16 ValueType;
 
-        V9Type v9;
-        V8Type v8;
+        uint16 const* v9;
+        uint16 const* v8;
         float gridIntHeightMultiplier;
     };
 
     struct Uint8HeightData
     {
-        typedef std::array<uint8, 129 * 129> V9Type;
-        typedef std::array<uint8, 128 * 128> V8Type;
+        typedef uint8 ValueType;
 
-        V9Type v9;
-        V8Type v8;
+        uint8 const* v9;
+        uint8 const* v8;
         float gridIntHeightMultiplier;
     };
 
     struct FloatHeightData
     {
-        typedef std::array<float, 129 * 129> V9Type;
-        typedef std::array<float, 128 * 128> V8Type;
+        typedef float ValueType;
 
-        V9Type v9;
-        V8Type v8;
+        float const* v9;
+        float const* v8;
     };
 
     float gridHeight;
@@ -163,9 +172,7 @@ struct LoadedHeightData
 
 struct LoadedLiquidData
 {
-    typedef std::array<uint16, 16 * 16> LiquidEntryType;
-    typedef std::array<uint8, 16 * 16> LiquidFlagsType;
-    typedef std::vector<float> LiquidMapType;
+    static constexpr std::size_t LIQUID_MAP_SIZE = 16 * 16;
 
     uint16 liquidGlobalEntry;
     uint8 liquidGlobalFlags;
@@ -174,16 +181,16 @@ struct LoadedLiquidData
     uint8 liquidWidth;
     uint8 liquidHeight;
     float liquidLevel;
-    std::unique_ptr<LiquidEntryType> liquidEntry;
-    std::unique_ptr<LiquidFlagsType> liquidFlags;
-    std::unique_ptr<LiquidMapType> liquidMap;
+    uint16 const* liquidEntry = nullptr;
+    uint8 const* liquidFlags = nullptr;
+    float const* liquidMap = nullptr;       // liquidWidth * liquidHeight entries
 };
 
 struct LoadedHoleData
 {
-    typedef std::array<uint16, 16 * 16> HolesType;
+    static constexpr std::size_t HOLES_SIZE = 16 * 16;
 
-    HolesType holes;
+    uint16 const* holes;
 };
 
 enum LiquidStatus
@@ -220,10 +227,23 @@ enum class TerrainMapDataReadResult
 
 class GridTerrainData
 {
-    bool LoadAreaData(std::ifstream& fileStream, uint32 const offset);
-    bool LoadHeightData(std::ifstream& fileStream, uint32 const offset);
-    bool LoadLiquidData(std::ifstream& fileStream, uint32 const offset);
-    bool LoadHolesData(std::ifstream& fileStream, uint32 const offset);
+    template<typename T>
+    bool ReadStruct(std::size_t offset, T& value) const;
+    template<typename T>
+    T const* GetArray(std::size_t offset, std::size_t count);
+    template<typename HeightData>
+    bool LoadHeightArrays(HeightData& heightData, std::size_t& offset);
+
+    bool LoadAreaData(uint32 const offset);
+    bool LoadHeightData(uint32 const offset);
+    bool LoadLiquidData(uint32 const offset);
+    bool LoadHolesData(uint32 const offset);
+
+    std::unique_ptr<boost::interprocess::mapped_region> _region;
+    char const* _fileData = nullptr;
+    std::size_t _fileSize = 0;
+    std::vector<std::unique_ptr<char[]>> _copies;
+    std::size_t _heapSize = sizeof(GridTerrainData);
 
     std::unique_ptr<LoadedAreaData> _loadedAreaData;
     std::unique_ptr<LoadedHeightData> _loadedHeightData;
@@ -242,9 +262,14 @@ class GridTerrainData
 
 public:
     GridTerrainData();
-    ~GridTerrainData() { };
+    ~GridTerrainData();
     TerrainMapDataReadResult Load(std::string const& mapFileName);
 
+    // Size of the mapped file, these pages are shared with the page cache and can be dropped by the OS
+    [[nodiscard]] std::size_t GetMappedSize() const { return _fileSize; }
+    // Private memory used for the parsed headers and copies of unaligned arrays
+    [[nodiscard]] std::size_t GetHeapSize() const { return _heapSize; }
+
     uint16 getArea(float x, float y) const;
     inline float getHeight(float x, float y) const { return (this->*_gridGetHeight)(x, y); }
     float getMinHeight(float x, float y) const;
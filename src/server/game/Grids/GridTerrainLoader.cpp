@@ -1,22 +1,30 @@
 #include "DisableMgr.h"
+#include "GridPreloader.h"
 #include "GridTerrainLoader.h"
 #include "MMapFactory.h"
 #include "MMapMgr.h"
+#include "MapMgr.h"
 #include "ScriptMgr.h"
+#include "TerrainTileCache.h"
 #include "VMapFactory.h"
 #include "VMapMgr2.h"
 
-void GridTerrainLoader::LoadTerrain()
+bool GridTerrainLoader::LoadTerrain()
 {
-    LoadMap();
-    if (_map->GetInstanceId() == 0)
+    if (_map->GetInstanceId() != 0)
     {
-        LoadVMap();
-        LoadMMap();
+        LoadMap(nullptr);
+        return false;
     }
+
+    std::unique_ptr<PreparedGrid> prepared = sMapMgr->GetGridPreloader()->Take(_map->GetId(), _grid.GetX(), _grid.GetY());
+    LoadMap(prepared.get());
+    LoadVMap();
+    LoadMMap(prepared.get());
+    return prepared != nullptr;
 }
 
-void GridTerrainLoader::LoadMap()
+void GridTerrainLoader::LoadMap(PreparedGrid* prepared)
 {
     // Instances will point to the parent maps terrain data
     if (_map->GetInstanceId() != 0)
@@ -32,13 +40,21 @@ void GridTerrainLoader::LoadMap()
     // map file name
     std::string const mapFileName = Acore::StringFormat("{}maps/{:03}{:02}{:02}.map", sWorld->GetDataPath(), _map->GetId(), _grid.GetX(), _grid.GetY());
 
-    // loading data
-    LOG_DEBUG("maps", "Loading map {}", mapFileName);
-    std::unique_ptr<GridTerrainData> terrainData = std::make_unique<GridTerrainData>();
-    TerrainMapDataReadResult loadResult = terrainData->Load(mapFileName);
-    if (loadResult == TerrainMapDataReadResult::Success)
-        _grid.SetTerrainData(std::move(terrainData));
+    // loading data, unless the GridPreloader already did
+    TerrainMapDataReadResult loadResult;
+    if (prepared)
+    {
+        loadResult = prepared->TerrainResult;
+        if (loadResult == TerrainMapDataReadResult::Success)
+            _grid.SetTerrainData(std::move(prepared->Terrain));
+    }
     else
+    {
+        LOG_DEBUG("maps", "Loading map {}", mapFileName);
+        _grid.SetTerrainData(sTerrainTileCache->Acquire(sWorld->GetDataPath(), _map->GetId(), _grid.GetX(), _grid.GetY(), loadResult));
+    }
+
+    if (loadResult != TerrainMapDataReadResult::Success)
     {
         if (loadResult == TerrainMapDataReadResult::InvalidMagic)
             LOG_ERROR("maps", "Map file '{}' is from an incompatible clientversion. Please recreate using the mapextractor.", mapFileName);
@@ -69,12 +85,16 @@ void GridTerrainLoader::LoadVMap()
     }
 }
 
-void GridTerrainLoader::LoadMMap()
+void GridTerrainLoader::LoadMMap(PreparedGrid* prepared)
 {
     if (!DisableMgr::IsPathfindingEnabled(_map))
         return;
 
-    int mmapLoadResult = MMAP::MMapFactory::createOrGetMMapMgr()->loadMap(_map->GetId(), _grid.GetX(), _grid.GetY());
+    MMAP::MMapTileData tile;
+    if (prepared)
+        tile = std::move(prepared->NavTile);
+
+    int mmapLoadResult = MMAP::MMapFactory::createOrGetMMapMgr()->loadMap(_map->GetId(), _grid.GetX(), _grid.GetY(), std::move(tile));
     switch (mmapLoadResult)
     {
     case MMAP::MMAP_LOAD_RESULT_OK:
@@ -20,21 +20,24 @@
 
 #include "GridDefines.h"
 
+struct PreparedGrid;
+
 class GridTerrainLoader
 {
 public:
     GridTerrainLoader(MapGridType& grid, Map* map)
         : _grid(grid), _map(map) { }
 
-    void LoadTerrain();
+    // Returns true if the terrain files were already read by the GridPreloader
+    bool LoadTerrain();
 
     static bool ExistMap(uint32 mapid, int gx, int gy);
     static bool ExistVMap(uint32 mapid, int gx, int gy);
 
 private:
-    void LoadMap();
+    void LoadMap(PreparedGrid* prepared);
     void LoadVMap();
-    void LoadMMap();
+    void LoadMMap(PreparedGrid* prepared);
 
     MapGridType& _grid;
     Map* _map;
@@ -1,6 +1,30 @@
 #include "MapGridManager.h"
 #include "GridObjectLoader.h"
 #include "GridTerrainLoader.h"
+#include "Map.h"
+#include "Metric.h"
+
+namespace
+{
+    // A grid load that blocks the map thread for longer than this is counted as a hitch
+    constexpr std::chrono::milliseconds GRID_LOAD_HITCH_THRESHOLD(5);
+
+    struct GridLoadMetrics
+    {
+        MetricCounter& PreloadedTerrain = sMetric->GetRegistry().GetCounter("grid_terrain_loads_total", "Grid terrain loads on the map thread", { METRIC_TAG("source", "preloaded") });
+        MetricCounter& SyncTerrain = sMetric->GetRegistry().GetCounter("grid_terrain_loads_total", "Grid terrain loads on the map thread", { METRIC_TAG("source", "sync") });
+        MetricHistogram& TerrainTime = sMetric->GetRegistry().GetHistogram("grid_terrain_load_seconds", "Time the map thread spent loading the terrain of a grid");
+        MetricHistogram& ObjectTime = sMetric->GetRegistry().GetHistogram("grid_object_load_seconds", "Time the map thread spent spawning the objects of a grid");
+        MetricCounter& TerrainHitches = sMetric->GetRegistry().GetCounter("grid_load_hitches_total", "Grid loads that blocked the map thread for more than 5ms", { METRIC_TAG("stage", "terrain") });
+        MetricCounter& ObjectHitches = sMetric->GetRegistry().GetCounter("grid_load_hitches_total", "Grid loads that blocked the map thread for more than 5ms", { METRIC_TAG("stage", "objects") });
+    };
+
+    GridLoadMetrics& GetGridLoadMetrics()
+    {
+        static GridLoadMetrics metrics;
+        return metrics;
+    }
+}
 
 void MapGridManager::CreateGrid(uint16 const x, uint16 const y)
 {
@@ -11,8 +35,21 @@ void MapGridManager::CreateGrid(uint16 const x, uint16 const y)
     std::unique_ptr<MapGridType> grid = std::make_unique<MapGridType>(x, y);
     grid->link(_map);
 
+    auto const startTime = std::chrono::steady_clock::now();
+
     GridTerrainLoader loader(*grid, _map);
-    loader.LoadTerrain();
+    bool preloaded = loader.LoadTerrain();
+
+    // Instances reuse the terrain of their parent map, which is measured there
+    if (_map->GetInstanceId() == 0)
+    {
+        GridLoadMetrics& metrics = GetGridLoadMetrics();
+        auto const duration = std::chrono::steady_clock::now() - startTime;
+        (preloaded ? metrics.PreloadedTerrain : metrics.SyncTerrain).Increment();
+        metrics.TerrainTime.Observe(duration);
+        if (duration > GRID_LOAD_HITCH_THRESHOLD)
+            metrics.TerrainHitches.Increment();
+    }
 
     _mapGrid[x][y] = std::move(grid);
 
@@ -28,9 +65,17 @@ bool MapGridManager::LoadGrid(uint16 const x, uint16 const y)
     // Must mark as loaded first, as GridObjectLoader spawning objects can attempt to recursively load the grid
     grid->SetObjectDataLoaded();
 
+    auto const startTime = std::chrono::steady_clock::now();
+
     GridObjectLoader loader(*grid, _map);
     loader.LoadAllCellsInGrid();
 
+    GridLoadMetrics& metrics = GetGridLoadMetrics();
+    auto const duration = std::chrono::steady_clock::now() - startTime;
+    metrics.ObjectTime.Observe(duration);
+    if (duration > GRID_LOAD_HITCH_THRESHOLD)
+        metrics.ObjectHitches.Increment();
+
     ++_loadedGridsCount;
     return true;
 }
@@ -126,8 +126,15 @@ namespace Acore
             if (!player->HaveAtClient(i_source))
                 return;
 
-            player->SendDirectMessage(i_message);
+            // Every receiver queues the same payload, it is copied once for the whole visit
+            if (!i_sharedMessage)
+                i_sharedMessage = MakeSharedWorldPacket(*i_message);
+
+            player->SendDirectMessage(i_sharedMessage);
         }
+
+    private:
+        SharedWorldPacket i_sharedMessage;
     };
 
     struct MessageDistDelivererToHostile
@@ -0,0 +1,103 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TerrainTileCache.h"
+#include "Metric.h"
+#include "StringFormat.h"
+
+TerrainTileCache::TerrainTileCache() :
+    _hits(sMetric->GetRegistry().GetCounter("terrain_tile_requests_total", "Terrain tile lookups", { METRIC_TAG("result", "hit") })),
+    _misses(sMetric->GetRegistry().GetCounter("terrain_tile_requests_total", "Terrain tile lookups", { METRIC_TAG("result", "miss") })),
+    _loadedTiles(sMetric->GetRegistry().GetGauge("terrain_tiles_loaded", "Terrain tiles currently referenced by any map")),
+    _heapBytes(sMetric->GetRegistry().GetGauge("terrain_tile_bytes", "Memory used by loaded terrain tiles", { METRIC_TAG("storage", "heap") })),
+    _mappedBytes(sMetric->GetRegistry().GetGauge("terrain_tile_bytes", "Memory used by loaded terrain tiles", { METRIC_TAG("storage", "mapped") }))
+{
+}
+
+TerrainTileCache* TerrainTileCache::instance()
+{
+    static TerrainTileCache instance;
+    return &instance;
+}
+
+std::shared_ptr<GridTerrainData> TerrainTileCache::Acquire(std::string const& dataPath, uint32 mapId, uint16 x, uint16 y, TerrainMapDataReadResult& result)
+{
+    uint64 const key = MakeKey(mapId, x, y);
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        auto itr = _tiles.find(key);
+        if (itr != _tiles.end())
+        {
+            if (itr->second.Missing)
+            {
+                _hits.Increment();
+                result = TerrainMapDataReadResult::NotFound;
+                return nullptr;
+            }
+
+            if (std::shared_ptr<GridTerrainData> tile = itr->second.Tile.lock())
+            {
+                _hits.Increment();
+                result = TerrainMapDataReadResult::Success;
+                return tile;
+            }
+        }
+    }
+
+    _misses.Increment();
+
+    // Load without holding the lock, other maps and the preloader may read other tiles meanwhile
+    std::string const mapFileName = Acore::StringFormat("{}maps/{:03}{:02}{:02}.map", dataPath, mapId, x, y);
+    std::unique_ptr<GridTerrainData> loaded = std::make_unique<GridTerrainData>();
+    result = loaded->Load(mapFileName);
+
+    std::lock_guard<std::mutex> guard(_lock);
+    Entry& entry = _tiles[key];
+    if (result == TerrainMapDataReadResult::NotFound)
+        entry.Missing = true;
+
+    if (result != TerrainMapDataReadResult::Success)
+        return nullptr;
+
+    // Somebody else loaded the same tile while we were reading it, keep theirs
+    if (std::shared_ptr<GridTerrainData> tile = entry.Tile.lock())
+        return tile;
+
+    std::shared_ptr<GridTerrainData> tile = Track(std::move(loaded));
+    entry.Tile = tile;
+    return tile;
+}
+
+std::shared_ptr<GridTerrainData> TerrainTileCache::Track(std::unique_ptr<GridTerrainData> tile)
+{
+    double const heapSize = double(tile->GetHeapSize());
+    double const mappedSize = double(tile->GetMappedSize());
+
+    _loadedTiles.Add(1);
+    _heapBytes.Add(heapSize);
+    _mappedBytes.Add(mappedSize);
+
+    // The gauges belong to sMetric, which is created before and destroyed after this cache
+    return std::shared_ptr<GridTerrainData>(tile.release(), [&loadedTiles = _loadedTiles, &heapBytes = _heapBytes, &mappedBytes = _mappedBytes, heapSize, mappedSize](GridTerrainData* data)
+    {
+        loadedTiles.Add(-1);
+        heapBytes.Add(-heapSize);
+        mappedBytes.Add(-mappedSize);
+        delete data;
+    });
+}
@@ -0,0 +1,71 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_TERRAIN_TILE_CACHE_H
+#define ACORE_TERRAIN_TILE_CACHE_H
+
+#include "Define.h"
+#include "GridTerrainData.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+class MetricCounter;
+class MetricGauge;
+
+/**
+ * Process wide registry of the loaded .map tiles, keyed by map id and grid coordinates.
+ *
+ * Only weak references are kept, a tile lives as long as a grid (of any map, instance or the
+ * GridPreloader) holds it. Asking for a tile that is still alive returns the same immutable
+ * GridTerrainData instead of mapping and parsing the file again. Missing files are remembered.
+ */
+class AC_GAME_API TerrainTileCache
+{
+public:
+    static TerrainTileCache* instance();
+
+    // Returns the tile and Success, or nullptr and the reason the file could not be loaded
+    std::shared_ptr<GridTerrainData> Acquire(std::string const& dataPath, uint32 mapId, uint16 x, uint16 y, TerrainMapDataReadResult& result);
+
+private:
+    struct Entry
+    {
+        std::weak_ptr<GridTerrainData> Tile;
+        bool Missing = false;
+    };
+
+    TerrainTileCache();
+
+    static uint64 MakeKey(uint32 mapId, uint16 x, uint16 y) { return (uint64(mapId) << 32) | (uint32(x) << 16) | y; }
+
+    std::shared_ptr<GridTerrainData> Track(std::unique_ptr<GridTerrainData> tile);
+
+    std::mutex _lock;
+    std::unordered_map<uint64, Entry> _tiles;
+
+    MetricCounter& _hits;
+    MetricCounter& _misses;
+    MetricGauge& _loadedTiles;
+    MetricGauge& _heapBytes;
+    MetricGauge& _mappedBytes;
+};
+
+#define sTerrainTileCache TerrainTileCache::instance()
+
+#endif
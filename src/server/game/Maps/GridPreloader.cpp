@@ -0,0 +1,161 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GridPreloader.h"
+#include "Log.h"
+#include "MapTree.h"
+#include "Metric.h"
+#include "TerrainTileCache.h"
+#include <fstream>
+
+GridPreloader::GridPreloader() : _cancelationToken(false),
+    _requests(sMetric->GetRegistry().GetCounter("grid_preload_requests_total", "Grids queued for reading ahead of time")),
+    _dropped(sMetric->GetRegistry().GetCounter("grid_preload_dropped_total", "Grid preload requests or prepared grids dropped before they were used"))
+{
+}
+
+GridPreloader::~GridPreloader()
+{
+    deactivate();
+}
+
+void GridPreloader::activate(std::size_t num_threads, std::string dataPath, std::string mmapDataDir)
+{
+    _dataPath = std::move(dataPath);
+    _mmapDataDir = std::move(mmapDataDir);
+    _cancelationToken = false;
+
+    for (std::size_t i = 0; i < num_threads; ++i)
+        _workerThreads.emplace_back(&GridPreloader::WorkerThread, this);
+}
+
+void GridPreloader::deactivate()
+{
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _cancelationToken = true;
+    }
+
+    _condition.notify_all();
+
+    for (std::thread& thread : _workerThreads)
+        if (thread.joinable())
+            thread.join();
+
+    _workerThreads.clear();
+    _queue.clear();
+    _pending.clear();
+    _prepared.clear();
+    _preparedIndex.clear();
+}
+
+void GridPreloader::Request(uint32 mapId, uint16 x, uint16 y, bool navTile)
+{
+    if (!activated())
+        return;
+
+    uint64 key = MakeKey(mapId, x, y);
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        if (_pending.count(key) || _preparedIndex.count(key))
+            return;
+
+        // Predictions get stale quickly, drop the oldest one instead of the newest
+        if (_queue.size() >= MAX_PREPARED_GRIDS)
+        {
+            _pending.erase(_queue.front().Key);
+            _queue.pop_front();
+            _dropped.Increment();
+        }
+
+        _queue.push_back({ key, mapId, x, y, navTile });
+        _pending.insert(key);
+    }
+
+    _requests.Increment();
+    _condition.notify_one();
+}
+
+std::unique_ptr<PreparedGrid> GridPreloader::Take(uint32 mapId, uint16 x, uint16 y)
+{
+    if (!activated())
+        return nullptr;
+
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr = _preparedIndex.find(MakeKey(mapId, x, y));
+    if (itr == _preparedIndex.end())
+        return nullptr;
+
+    std::unique_ptr<PreparedGrid> prepared = std::move(itr->second->second);
+    _prepared.erase(itr->second);
+    _preparedIndex.erase(itr);
+    return prepared;
+}
+
+void GridPreloader::WorkerThread()
+{
+    std::unique_lock<std::mutex> guard(_lock);
+    for (;;)
+    {
+        _condition.wait(guard, [this] { return _cancelationToken || !_queue.empty(); });
+        if (_cancelationToken)
+            return;
+
+        Job job = _queue.front();
+        _queue.pop_front();
+
+        guard.unlock();
+        std::unique_ptr<PreparedGrid> prepared = Prepare(job);
+        guard.lock();
+
+        _pending.erase(job.Key);
+
+        if (_prepared.size() >= MAX_PREPARED_GRIDS)
+        {
+            _preparedIndex.erase(_prepared.back().first);
+            _prepared.pop_back();
+            _dropped.Increment();
+        }
+
+        _prepared.emplace_front(job.Key, std::move(prepared));
+        _preparedIndex[job.Key] = _prepared.begin();
+    }
+}
+
+std::unique_ptr<PreparedGrid> GridPreloader::Prepare(Job const& job) const
+{
+    std::unique_ptr<PreparedGrid> prepared = std::make_unique<PreparedGrid>();
+
+    prepared->Terrain = sTerrainTileCache->Acquire(_dataPath, job.MapId, job.X, job.Y, prepared->TerrainResult);
+
+    WarmVMapTile(job.MapId, job.X, job.Y);
+
+    if (job.NavTile)
+        MMAP::MMapMgr::ReadTile(_mmapDataDir, job.MapId, job.X, job.Y, prepared->NavTile);
+
+    LOG_DEBUG("maps", "GridPreloader: Prepared grid [{}, {}] of map {}", job.X, job.Y, job.MapId);
+    return prepared;
+}
+
+void GridPreloader::WarmVMapTile(uint32 mapId, uint16 x, uint16 y) const
+{
+    std::ifstream file(_dataPath + "vmaps/" + VMAP::StaticMapTree::getTileFileName(mapId, x, y), std::ios::binary);
+    char buffer[64 * 1024];
+    while (file.read(buffer, sizeof(buffer)))
+        ;
+}
@@ -0,0 +1,105 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _GRID_PRELOADER_H_INCLUDED
+#define _GRID_PRELOADER_H_INCLUDED
+
+#include "Define.h"
+#include "GridTerrainData.h"
+#include "MMapMgr.h"
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class MetricCounter;
+
+// Terrain of one grid read and decoded ahead of time, attached by GridTerrainLoader when the grid is created
+struct PreparedGrid
+{
+    std::shared_ptr<GridTerrainData> Terrain;   // nullptr unless TerrainResult is Success
+    TerrainMapDataReadResult TerrainResult = TerrainMapDataReadResult::NotFound;
+    MMAP::MMapTileData NavTile;                 // empty if not requested or missing
+};
+
+/**
+ * Reads the terrain files of grids that are expected to be needed soon on background threads.
+ *
+ * Only file I/O and decoding happen on the workers: the .map file is decoded into GridTerrainData and
+ * the .mmtile is read and validated. The vmap tile is read once so it sits in the OS page cache, the
+ * vmap tree and the navmesh are not thread safe and are still updated by the map thread when the grid
+ * is created. Prepared grids are kept in a small LRU and dropped if they are not used in time.
+ */
+class GridPreloader
+{
+public:
+    // Upper bound for both queued requests and prepared grids
+    static constexpr std::size_t MAX_PREPARED_GRIDS = 64;
+
+    GridPreloader();
+    ~GridPreloader();
+
+    void activate(std::size_t num_threads, std::string dataPath, std::string mmapDataDir);
+    void deactivate();
+    [[nodiscard]] bool activated() const { return !_workerThreads.empty(); }
+
+    // Queues a grid unless it is already queued or prepared, may be called from any map thread
+    void Request(uint32 mapId, uint16 x, uint16 y, bool navTile);
+    // Removes and returns the prepared grid, nullptr if it is not ready (yet)
+    std::unique_ptr<PreparedGrid> Take(uint32 mapId, uint16 x, uint16 y);
+
+private:
+    struct Job
+    {
+        uint64 Key;
+        uint32 MapId;
+        uint16 X;
+        uint16 Y;
+        bool NavTile;
+    };
+
+    typedef std::list<std::pair<uint64, std::unique_ptr<PreparedGrid>>> PreparedList;
+
+    static uint64 MakeKey(uint32 mapId, uint16 x, uint16 y) { return (uint64(mapId) << 32) | (uint32(x) << 16) | y; }
+
+    void WorkerThread();
+    std::unique_ptr<PreparedGrid> Prepare(Job const& job) const;
+    void WarmVMapTile(uint32 mapId, uint16 x, uint16 y) const;
+
+    std::string _dataPath;
+    std::string _mmapDataDir;
+
+    std::mutex _lock;
+    std::condition_variable _condition;
+    std::deque<Job> _queue;
+    std::unordered_set<uint64> _pending;            // queued or being prepared
+    PreparedList _prepared;                          // most recently prepared first
+    std::unordered_map<uint64, PreparedList::iterator> _preparedIndex;
+    bool _cancelationToken;
+    std::vector<std::thread> _workerThreads;
+
+    MetricCounter& _requests;
+    MetricCounter& _dropped;
+};
+
+#endif //_GRID_PRELOADER_H_INCLUDED
@@ -30,6 +30,7 @@
 #include "LFGMgr.h"
 #include "MapGrid.h"
 #include "MapInstanced.h"
+#include "MapMgr.h"
 #include "Metric.h"
 #include "MiscPackets.h"
 #include "MMapFactory.h"
@@ -47,6 +48,13 @@
 
 #define MAP_INVALID_ZONE        0xFFFFFFFF
 
+namespace
+{
+    // Set while a worker thread updates one region of a partitioned map update
+    thread_local Map const* t_regionUpdateMap = nullptr;
+    thread_local MapRegionUpdateContext* t_regionUpdateContext = nullptr;
+}
+
 ZoneDynamicInfo::ZoneDynamicInfo() : MusicId(0), DefaultWeather(nullptr), WeatherId(WEATHER_STATE_FINE),
                                      WeatherGrade(0.0f), OverrideLightId(0), LightFadeInTime(0) { }
 
@@ -58,14 +66,12 @@ Map::~Map()
 
     if (!m_scriptSchedule.empty())
         sScriptMgr->DecreaseScheduledScriptCount(m_scriptSchedule.size());
-
-    MMAP::MMapFactory::createOrGetMMapMgr()->unloadMapInstance(GetId(), i_InstanceId);
 }
 
 Map::Map(uint32 id, uint32 InstanceId, uint8 SpawnMode, Map* _parent) :
     _mapGridManager(this), i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(InstanceId),
     m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), _instanceResetPeriod(0),
-    _transportsUpdateIter(_transports.end()), i_scriptLock(false), _defaultLight(GetDefaultMapLight(id))
+    _transportsUpdateIter(_transports.end()), i_scriptLock(false), _defaultLight(GetDefaultMapLight(id)), _pathRequests(this)
 {
     m_parentMap = (_parent ? _parent : this);
 
@@ -77,6 +83,8 @@ Map::Map(uint32 id, uint32 InstanceId, uint8 SpawnMode, Map* _parent) :
 
     _weatherUpdateTimer.SetInterval(1 * IN_MILLISECONDS);
     _corpseUpdateTimer.SetInterval(20 * MINUTE * IN_MILLISECONDS);
+
+    _updateTimeHistogram = &sMetric->GetRegistry().GetHistogram("map_update_seconds", "Time spent in one full map update", { METRIC_TAG("map_id", std::to_string(id)) });
 }
 
 // Hook called after map is created AND after added to map list
@@ -181,6 +189,10 @@ void Map::EnsureGridCreated(GridCoord const& gridCoord)
 
 bool Map::EnsureGridLoaded(Cell const& cell)
 {
+    std::unique_lock<std::recursive_mutex> guard(_regionSerialLock, std::defer_lock);
+    if (IsInRegionUpdate())
+        guard.lock();
+
     EnsureGridCreated(GridCoord(cell.GridX(), cell.GridY()));
 
     if (_mapGridManager.LoadGrid(cell.GridX(), cell.GridY()))
@@ -212,6 +224,41 @@ void Map::LoadGrid(float x, float y)
     EnsureGridLoaded(Cell(x, y));
 }
 
+void Map::PreloadGrid(float x, float y)
+{
+    GridPreloader* preloader = sMapMgr->GetGridPreloader();
+    if (!preloader->activated() || GetInstanceId() != 0)
+        return;
+
+    GridCoord const gridCoord = Acore::ComputeGridCoord(x, y);
+    if (!gridCoord.IsCoordValid() || IsGridCreated(gridCoord))
+        return;
+
+    preloader->Request(GetId(), gridCoord.x_coord, gridCoord.y_coord, DisableMgr::IsPathfindingEnabled(this));
+}
+
+void Map::PreloadGridsAhead(Player* player, float x, float y)
+{
+    if (!sMapMgr->GetGridPreloader()->activated() || GetInstanceId() != 0)
+        return;
+
+    // Direction of travel, not orientation, players can strafe or move backwards
+    float dx = x - player->GetPositionX();
+    float dy = y - player->GetPositionY();
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length < 0.1f)
+        return;
+
+    dx /= length;
+    dy /= length;
+
+    float distance = GetVisibilityRange() + player->GetSpeed(player->IsFlying() ? MOVE_FLIGHT : MOVE_RUN) * sWorld->getIntConfig(CONFIG_GRID_PRELOAD_LOOKAHEAD);
+    for (float step = SIZE_OF_GRIDS / 2; step < distance; step += SIZE_OF_GRIDS / 2)
+        PreloadGrid(x + dx * step, y + dy * step);
+
+    PreloadGrid(x + dx * distance, y + dy * distance);
+}
+
 void Map::LoadAllGrids()
 {
     for (uint32 cellX = 0; cellX < TOTAL_NUMBER_OF_CELLS_PER_MAP; cellX++)
@@ -300,6 +347,10 @@ void Map::InitializeObject(GameObject*  /*obj*/)
 template<class T>
 bool Map::AddToMap(T* obj, bool checkTransport)
 {
+    std::unique_lock<std::recursive_mutex> guard(_regionSerialLock, std::defer_lock);
+    if (IsInRegionUpdate())
+        guard.lock();
+
     //TODO: Needs clean up. An object should not be added to map twice.
     if (obj->IsInWorld())
     {
@@ -354,6 +405,10 @@ bool Map::AddToMap(T* obj, bool checkTransport)
 template<>
 bool Map::AddToMap(Transport* obj, bool /*checkTransport*/)
 {
+    std::unique_lock<std::recursive_mutex> guard(_regionSerialLock, std::defer_lock);
+    if (IsInRegionUpdate())
+        guard.lock();
+
     //TODO: Needs clean up. An object should not be added to map twice.
     if (obj->IsInWorld())
         return true;
@@ -483,7 +538,12 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
         }
     }
 
-    UpdateNonPlayerObjects(t_diff);
+    if (CanUsePartitionedUpdate())
+        UpdateNonPlayerObjectsPartitioned(t_diff);
+    else
+        UpdateNonPlayerObjects(t_diff);
+
+    _pathRequests.Process();
 
     SendObjectUpdates();
 
@@ -558,11 +618,165 @@ void Map::UpdateNonPlayerObjects(uint32 const diff)
     }
 }
 
+bool Map::IsInRegionUpdate() const
+{
+    return t_regionUpdateMap == this;
+}
+
+std::unique_lock<std::mutex> Map::LockDynamicTree() const
+{
+    std::unique_lock<std::mutex> guard(_dynamicTreeLock, std::defer_lock);
+    if (IsInRegionUpdate())
+        guard.lock();
+
+    return guard;
+}
+
+bool Map::CanUsePartitionedUpdate() const
+{
+    return !Instanceable() && sWorld->getBoolConfig(CONFIG_MAP_PARTITION_ENABLE) &&
+        sWorld->getIntConfig(CONFIG_NUMTHREADS) > 1 && sMapMgr->GetMapUpdater()->activated();
+}
+
+// Splits the updatable objects into square regions of MapUpdate.Partition.RegionGrids grids and updates
+// them on the map update workers. The regions are processed in four passes following a 2x2 checkerboard,
+// so two regions running at the same time are always at least one region width apart.
+// Everything that can reach across regions (transports and their passengers, far visible objects) is
+// updated serially afterwards, and so is every relocation that crosses a grid boundary. Objects the
+// regions added to or removed from the world are registered for guid lookups right after the passes.
+void Map::UpdateNonPlayerObjectsPartitioned(uint32 const diff)
+{
+    for (WorldObject* obj : _pendingAddUpdatableObjectList)
+        _AddObjectToUpdateList(obj);
+    _pendingAddUpdatableObjectList.clear();
+
+    uint32 const regionGrids = sWorld->getIntConfig(CONFIG_MAP_PARTITION_REGION_GRIDS);
+    uint32 const regionsPerSide = (MAX_NUMBER_OF_GRIDS + regionGrids - 1) / regionGrids;
+
+    if (_regionUpdateContexts.size() != regionsPerSide * regionsPerSide)
+        _regionUpdateContexts.resize(regionsPerSide * regionsPerSide);
+
+    std::vector<WorldObject*> serialObjects;
+    for (WorldObject* obj : _updatableObjectList)
+    {
+        if (!obj->IsInWorld())
+            continue;
+
+        if (obj->IsFarVisible() || obj->GetTransport() || (obj->ToGameObject() && obj->ToGameObject()->IsTransport()))
+        {
+            serialObjects.push_back(obj);
+            continue;
+        }
+
+        GridCoord const gridCoord = Acore::ComputeGridCoord(obj->GetPositionX(), obj->GetPositionY());
+        uint32 const regionX = gridCoord.x_coord / regionGrids;
+        uint32 const regionY = gridCoord.y_coord / regionGrids;
+        _regionUpdateContexts[regionX * regionsPerSide + regionY].Objects.push_back(obj);
+    }
+
+    std::vector<std::size_t> passRegions;
+    MapUpdater* updater = sMapMgr->GetMapUpdater();
+    for (uint32 pass = 0; pass < 4; ++pass)
+    {
+        passRegions.clear();
+        for (uint32 regionX = (pass & 1); regionX < regionsPerSide; regionX += 2)
+            for (uint32 regionY = (pass >> 1); regionY < regionsPerSide; regionY += 2)
+                if (!_regionUpdateContexts[regionX * regionsPerSide + regionY].Objects.empty())
+                    passRegions.push_back(regionX * regionsPerSide + regionY);
+
+        updater->run_parallel(passRegions.size(), [this, diff, &passRegions](std::size_t index)
+        {
+            UpdateRegion(_regionUpdateContexts[passRegions[index]], diff);
+        });
+    }
+
+    // The serial updates below look up what the regions added
+    for (MapRegionUpdateContext& context : _regionUpdateContexts)
+        for (MapObjectsStoreChange const& change : context.StoreChanges)
+            ApplyObjectsStoreChange(change);
+
+    for (WorldObject* obj : serialObjects)
+        if (obj->IsInWorld())
+            obj->Update(diff);
+
+    // Merge in region order so the resulting move lists do not depend on thread scheduling
+    for (MapRegionUpdateContext& context : _regionUpdateContexts)
+    {
+        _creaturesToMove.insert(_creaturesToMove.end(), context.CreaturesToMove.begin(), context.CreaturesToMove.end());
+        _gameObjectsToMove.insert(_gameObjectsToMove.end(), context.GameObjectsToMove.begin(), context.GameObjectsToMove.end());
+        _dynamicObjectsToMove.insert(_dynamicObjectsToMove.end(), context.DynamicObjectsToMove.begin(), context.DynamicObjectsToMove.end());
+        context.Clear();
+    }
+
+    if (_updatableObjectListRecheckTimer.Passed())
+    {
+        for (uint32 i = 0; i < _updatableObjectList.size();)
+        {
+            WorldObject* obj = _updatableObjectList[i];
+            if (obj->IsInWorld() && !obj->IsUpdateNeeded())
+                _RemoveObjectFromUpdateList(obj); // obj is swapped with the last element, check the same index again
+            else
+                ++i;
+        }
+        _updatableObjectListRecheckTimer.Reset();
+    }
+}
+
+void Map::UpdateRegion(MapRegionUpdateContext& context, uint32 const diff)
+{
+    t_regionUpdateMap = this;
+    t_regionUpdateContext = &context;
+
+    for (WorldObject* obj : context.Objects)
+        if (obj->IsInWorld())
+            obj->Update(diff);
+
+    RelocateWithinRegion(context.CreaturesToMove);
+    RelocateWithinRegion(context.GameObjectsToMove);
+    RelocateWithinRegion(context.DynamicObjectsToMove);
+
+    t_regionUpdateContext = nullptr;
+    t_regionUpdateMap = nullptr;
+}
+
+// Moves objects between cells of the same grid right away, every other move is left for the serial merge
+template<class T>
+void Map::RelocateWithinRegion(std::vector<T*>& moveList)
+{
+    std::size_t kept = 0;
+    for (T* obj : moveList)
+    {
+        if (obj->_moveState != MAP_OBJECT_CELL_MOVE_ACTIVE || !obj->IsInWorld() || obj->FindMap() != this || obj->IsFarVisible())
+        {
+            moveList[kept++] = obj;
+            continue;
+        }
+
+        Cell const& oldCell = obj->GetCurrentCell();
+        Cell newCell(obj->GetPositionX(), obj->GetPositionY());
+        if (oldCell.DiffGrid(newCell))
+        {
+            moveList[kept++] = obj;
+            continue;
+        }
+
+        obj->_moveState = MAP_OBJECT_CELL_MOVE_NONE;
+        obj->RemoveFromGrid();
+        AddToGrid(obj, newCell);
+    }
+
+    moveList.resize(kept);
+}
+
 void Map::AddObjectToPendingUpdateList(WorldObject* obj)
 {
     if (!obj->CanBeAddedToMapUpdateList())
         return;
 
+    std::unique_lock<std::mutex> guard(_regionMergeLock, std::defer_lock);
+    if (IsInRegionUpdate())
+        guard.lock();
+
     UpdatableMapObject* mapUpdatableObject = dynamic_cast<UpdatableMapObject*>(obj);
     if (mapUpdatableObject->GetUpdateState() != UpdatableMapObject::UpdateState::NotUpdating)
         return;
@@ -603,6 +817,10 @@ void Map::RemoveObjectFromMapUpdateList(WorldObject* obj)
     if (!obj->CanBeAddedToMapUpdateList())
         return;
 
+    std::unique_lock<std::mutex> guard(_regionMergeLock, std::defer_lock);
+    if (IsInRegionUpdate())
+        guard.lock();
+
     UpdatableMapObject* mapUpdatableObject = dynamic_cast<UpdatableMapObject*>(obj);
     if (mapUpdatableObject->GetUpdateState() == UpdatableMapObject::UpdateState::PendingAdd)
         _pendingAddUpdatableObjectList.erase(obj);
@@ -673,6 +891,15 @@ ZoneWideVisibleWorldObjectsSet const* Map::GetZoneWideVisibleWorldObjectsForZone
     return &itr->second;
 }
 
+void Map::AddObjectForDelayedVisibility(Unit* unit)
+{
+    std::unique_lock<std::mutex> guard(_regionMergeLock, std::defer_lock);
+    if (IsInRegionUpdate())
+        guard.lock();
+
+    i_objectsForDelayedVisibility.insert(unit);
+}
+
 void Map::HandleDelayedVisibility()
 {
     if (i_objectsForDelayedVisibility.empty())
@@ -790,6 +1017,7 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float o)
             EnsureGridLoaded(new_cell);
 
         AddToGrid(player, new_cell);
+        PreloadGridsAhead(player, x, y);
     }
 
     player->Relocate(x, y, z, o);
@@ -865,7 +1093,12 @@ void Map::DynamicObjectRelocation(DynamicObject* dynObj, float x, float y, float
 void Map::AddCreatureToMoveList(Creature* c)
 {
     if (c->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
-        _creaturesToMove.push_back(c);
+    {
+        if (t_regionUpdateMap == this)
+            t_regionUpdateContext->CreaturesToMove.push_back(c);
+        else
+            _creaturesToMove.push_back(c);
+    }
     c->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
 }
 
@@ -878,7 +1111,12 @@ void Map::RemoveCreatureFromMoveList(Creature* c)
 void Map::AddGameObjectToMoveList(GameObject* go)
 {
     if (go->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
-        _gameObjectsToMove.push_back(go);
+    {
+        if (t_regionUpdateMap == this)
+            t_regionUpdateContext->GameObjectsToMove.push_back(go);
+        else
+            _gameObjectsToMove.push_back(go);
+    }
     go->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
 }
 
@@ -891,7 +1129,12 @@ void Map::RemoveGameObjectFromMoveList(GameObject* go)
 void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj)
 {
     if (dynObj->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
-        _dynamicObjectsToMove.push_back(dynObj);
+    {
+        if (t_regionUpdateMap == this)
+            t_regionUpdateContext->DynamicObjectsToMove.push_back(dynObj);
+        else
+            _dynamicObjectsToMove.push_back(dynObj);
+    }
     dynObj->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
 }
 
@@ -1212,7 +1455,11 @@ bool Map::GetAreaInfo(uint32 phaseMask, float x, float y, float z, uint32& flags
     int32 dgroupId;
 
     bool hasVmapAreaInfo = vmgr->GetAreaInfo(GetId(), x, y, vmap_z, vflags, vadtId, vrootId, vgroupId);
-    bool hasDynamicAreaInfo = _dynamicTree.GetAreaInfo(x, y, dynamic_z, phaseMask, dflags, dadtId, drootId, dgroupId);
+    bool hasDynamicAreaInfo;
+    {
+        std::unique_lock<std::mutex> guard = LockDynamicTree();
+        hasDynamicAreaInfo = _dynamicTree.GetAreaInfo(x, y, dynamic_z, phaseMask, dflags, dadtId, drootId, dgroupId);
+    }
     auto useVmap = [&]() { check_z = vmap_z; flags = vflags; adtId = vadtId; rootId = vrootId; groupId = vgroupId; };
     auto useDyn = [&]() { check_z = dynamic_z; flags = dflags; adtId = dadtId; rootId = drootId; groupId = dgroupId; };
 
@@ -1567,6 +1814,7 @@ bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, floa
             ignoreFlags = VMAP::ModelIgnoreFlags::M2;
         }
 
+        std::unique_lock<std::mutex> guard = LockDynamicTree();
         if (!_dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask, ignoreFlags))
         {
             return false;
@@ -1582,7 +1830,11 @@ bool Map::GetObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float
     G3D::Vector3 dstPos(x2, y2, z2);
 
     G3D::Vector3 resultPos;
-    bool result = _dynamicTree.GetObjectHitPos(phasemask, startPos, dstPos, resultPos, modifyDist);
+    bool result;
+    {
+        std::unique_lock<std::mutex> guard = LockDynamicTree();
+        result = _dynamicTree.GetObjectHitPos(phasemask, startPos, dstPos, resultPos, modifyDist);
+    }
 
     rx = resultPos.x;
     ry = resultPos.y;
@@ -1594,7 +1846,7 @@ float Map::GetHeight(uint32 phasemask, float x, float y, float z, bool vmap/*=tr
 {
     float h1, h2;
     h1 = GetHeight(x, y, z, vmap, maxSearchDist);
-    h2 = _dynamicTree.getHeight(x, y, z, maxSearchDist, phasemask);
+    h2 = GetGameObjectFloor(phasemask, x, y, z, maxSearchDist);
     return std::max<float>(h1, h2);
 }
 
@@ -1799,6 +2051,10 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 
     obj->CleanupsBeforeDelete(false);                            // remove or simplify at least cross referenced links
 
+    std::unique_lock<std::mutex> guard(_regionMergeLock, std::defer_lock);
+    if (IsInRegionUpdate())
+        guard.lock();
+
     i_objectsToRemove.insert(obj);
     //LOG_DEBUG("maps", "Object ({}) added to removing list.", obj->GetGUID().ToString());
 }
@@ -1855,8 +2111,9 @@ uint32 Map::GetPlayersCountExceptGMs() const
 
 void Map::SendToPlayers(WorldPacket const* data) const
 {
+    SharedWorldPacket shared = MakeSharedWorldPacket(*data);
     for (MapRefMgr::const_iterator itr = m_mapRefMgr.begin(); itr != m_mapRefMgr.end(); ++itr)
-        itr->GetSource()->SendDirectMessage(data);
+        itr->GetSource()->SendDirectMessage(shared);
 }
 
 template bool Map::AddToMap(Corpse*, bool);
@@ -2362,6 +2619,95 @@ void BattlegroundMap::RemoveAllPlayers()
                     player->TeleportTo(player->GetEntryPoint());
 }
 
+void Map::AddToObjectsStore(WorldObject* obj)
+{
+    ObjectGuid::LowType spawnId = 0;
+    if (Creature* creature = obj->ToCreature())
+        spawnId = creature->GetSpawnId();
+    else if (GameObject* go = obj->ToGameObject())
+        spawnId = go->GetSpawnId();
+
+    MapObjectsStoreChange change = { obj, obj->GetGUID(), spawnId, true };
+    if (IsInRegionUpdate())
+        t_regionUpdateContext->StoreChanges.push_back(change);
+    else
+        ApplyObjectsStoreChange(change);
+}
+
+void Map::RemoveFromObjectsStore(WorldObject* obj)
+{
+    ObjectGuid::LowType spawnId = 0;
+    if (Creature* creature = obj->ToCreature())
+        spawnId = creature->GetSpawnId();
+    else if (GameObject* go = obj->ToGameObject())
+        spawnId = go->GetSpawnId();
+
+    MapObjectsStoreChange change = { obj, obj->GetGUID(), spawnId, false };
+    if (IsInRegionUpdate())
+        t_regionUpdateContext->StoreChanges.push_back(change);
+    else
+        ApplyObjectsStoreChange(change);
+}
+
+// Only uses the values saved in the change, the object may already be gone when it is removed
+void Map::ApplyObjectsStoreChange(MapObjectsStoreChange const& change)
+{
+    if (change.Guid.IsAnyTypeCreature())
+    {
+        Creature* creature = static_cast<Creature*>(change.Object);
+        if (change.Added)
+        {
+            _objectsStore.Insert<Creature>(change.Guid, creature);
+            if (change.SpawnId)
+                _creatureBySpawnIdStore.insert(std::make_pair(change.SpawnId, creature));
+        }
+        else
+        {
+            if (change.SpawnId)
+                Acore::Containers::MultimapErasePair(_creatureBySpawnIdStore, change.SpawnId, creature);
+            _objectsStore.Remove<Creature>(change.Guid);
+        }
+    }
+    else if (change.Guid.IsAnyTypeGameObject())
+    {
+        GameObject* go = static_cast<GameObject*>(change.Object);
+        if (change.Added)
+        {
+            _objectsStore.Insert<GameObject>(change.Guid, go);
+            if (change.SpawnId)
+                _gameobjectBySpawnIdStore.insert(std::make_pair(change.SpawnId, go));
+        }
+        else
+        {
+            if (change.SpawnId)
+                Acore::Containers::MultimapErasePair(_gameobjectBySpawnIdStore, change.SpawnId, go);
+            _objectsStore.Remove<GameObject>(change.Guid);
+        }
+    }
+    else if (change.Guid.IsDynamicObject())
+    {
+        if (change.Added)
+            _objectsStore.Insert<DynamicObject>(change.Guid, static_cast<DynamicObject*>(change.Object));
+        else
+            _objectsStore.Remove<DynamicObject>(change.Guid);
+    }
+}
+
+template<class T>
+T* Map::FindInObjectsStore(ObjectGuid const& guid)
+{
+    // A region worker sees what its own region added or removed before the merge
+    if (IsInRegionUpdate())
+    {
+        std::vector<MapObjectsStoreChange> const& changes = t_regionUpdateContext->StoreChanges;
+        for (auto itr = changes.rbegin(); itr != changes.rend(); ++itr)
+            if (itr->Guid == guid)
+                return itr->Added ? dynamic_cast<T*>(itr->Object) : nullptr;
+    }
+
+    return _objectsStore.Find<T>(guid);
+}
+
 Corpse* Map::GetCorpse(ObjectGuid const& guid)
 {
     return _objectsStore.Find<Corpse>(guid);
@@ -2369,17 +2715,17 @@ Corpse* Map::GetCorpse(ObjectGuid const& guid)
 
 Creature* Map::GetCreature(ObjectGuid const& guid)
 {
-    return _objectsStore.Find<Creature>(guid);
+    return FindInObjectsStore<Creature>(guid);
 }
 
 GameObject* Map::GetGameObject(ObjectGuid const& guid)
 {
-    return _objectsStore.Find<GameObject>(guid);
+    return FindInObjectsStore<GameObject>(guid);
 }
 
 Pet* Map::GetPet(ObjectGuid const& guid)
 {
-    return dynamic_cast<Pet*>(_objectsStore.Find<Creature>(guid));
+    return dynamic_cast<Pet*>(FindInObjectsStore<Creature>(guid));
 }
 
 Transport* Map::GetTransport(ObjectGuid const& guid)
@@ -2393,7 +2739,7 @@ Transport* Map::GetTransport(ObjectGuid const& guid)
 
 DynamicObject* Map::GetDynamicObject(ObjectGuid const& guid)
 {
-    return _objectsStore.Find<DynamicObject>(guid);
+    return FindInObjectsStore<DynamicObject>(guid);
 }
 
 void Map::UpdateIteratorBack(Player* player)
@@ -2415,7 +2761,13 @@ void Map::SaveCreatureRespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTi
     if (GetInstanceResetPeriod() > 0 && respawnTime - now + 5 >= GetInstanceResetPeriod())
         respawnTime = now + YEAR;
 
-    _creatureRespawnTimes[spawnId] = respawnTime;
+    {
+        std::unique_lock<std::mutex> guard(_respawnTimesLock, std::defer_lock);
+        if (IsInRegionUpdate())
+            guard.lock();
+
+        _creatureRespawnTimes[spawnId] = respawnTime;
+    }
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CREATURE_RESPAWN);
     stmt->SetData(0, spawnId);
@@ -2427,7 +2779,13 @@ void Map::SaveCreatureRespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTi
 
 void Map::RemoveCreatureRespawnTime(ObjectGuid::LowType spawnId)
 {
-    _creatureRespawnTimes.erase(spawnId);
+    {
+        std::unique_lock<std::mutex> guard(_respawnTimesLock, std::defer_lock);
+        if (IsInRegionUpdate())
+            guard.lock();
+
+        _creatureRespawnTimes.erase(spawnId);
+    }
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CREATURE_RESPAWN);
     stmt->SetData(0, spawnId);
@@ -2449,7 +2807,13 @@ void Map::SaveGORespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTime)
     if (GetInstanceResetPeriod() > 0 && respawnTime - now + 5 >= GetInstanceResetPeriod())
         respawnTime = now + YEAR;
 
-    _goRespawnTimes[spawnId] = respawnTime;
+    {
+        std::unique_lock<std::mutex> guard(_respawnTimesLock, std::defer_lock);
+        if (IsInRegionUpdate())
+            guard.lock();
+
+        _goRespawnTimes[spawnId] = respawnTime;
+    }
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_GO_RESPAWN);
     stmt->SetData(0, spawnId);
@@ -2461,7 +2825,13 @@ void Map::SaveGORespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTime)
 
 void Map::RemoveGORespawnTime(ObjectGuid::LowType spawnId)
 {
-    _goRespawnTimes.erase(spawnId);
+    {
+        std::unique_lock<std::mutex> guard(_respawnTimesLock, std::defer_lock);
+        if (IsInRegionUpdate())
+            guard.lock();
+
+        _goRespawnTimes.erase(spawnId);
+    }
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GO_RESPAWN);
     stmt->SetData(0, spawnId);
@@ -3162,7 +3532,9 @@ std::string Map::GetDebugInfo() const
     std::stringstream sstr;
     sstr << std::boolalpha
         << "Id: " << GetId() << " InstanceId: " << GetInstanceId() << " Difficulty: " << std::to_string(GetDifficulty())
-        << " HasPlayers: " << HavePlayers();
+        << " HasPlayers: " << HavePlayers()
+        << " UpdateCost (us) Last: " << _updateCostHistory.GetLast() << " Avg: " << _updateCostHistory.GetAverage()
+        << " Max: " << _updateCostHistory.GetMax();
     return sstr.str();
 }
 
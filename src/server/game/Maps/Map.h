@@ -28,9 +28,11 @@
 #include "GridRefMgr.h"
 #include "MapGridManager.h"
 #include "MapRefMgr.h"
+#include "MapUpdater.h"
 #include "ObjectDefines.h"
 #include "ObjectGuid.h"
 #include "PathGenerator.h"
+#include "PathRequestQueue.h"
 #include "Position.h"
 #include "SharedDefines.h"
 #include "TaskScheduler.h"
@@ -39,6 +41,7 @@
 #include <bitset>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
 
 class Unit;
@@ -64,6 +67,7 @@ class StaticTransport;
 class MotionTransport;
 class PathGenerator;
 class WorldSession;
+class MetricHistogram;
 
 enum WeatherState : uint32;
 
@@ -153,6 +157,34 @@ typedef std::unordered_set<Transport*> TransportsContainer;
 typedef std::unordered_set<WorldObject*> ZoneWideVisibleWorldObjectsSet;
 typedef std::unordered_map<uint32 /*ZoneId*/, ZoneWideVisibleWorldObjectsSet> ZoneWideVisibleWorldObjectsMap;
 
+// An object a region worker added to or removed from the world, see Map::AddToObjectsStore
+struct MapObjectsStoreChange
+{
+    WorldObject* Object;
+    ObjectGuid Guid;
+    ObjectGuid::LowType SpawnId;
+    bool Added;
+};
+
+// Per-region state of a partitioned map update, see Map::UpdateNonPlayerObjectsPartitioned
+struct MapRegionUpdateContext
+{
+    std::vector<WorldObject*> Objects;
+    std::vector<Creature*> CreaturesToMove;
+    std::vector<GameObject*> GameObjectsToMove;
+    std::vector<DynamicObject*> DynamicObjectsToMove;
+    std::vector<MapObjectsStoreChange> StoreChanges;
+
+    void Clear()
+    {
+        Objects.clear();
+        CreaturesToMove.clear();
+        GameObjectsToMove.clear();
+        DynamicObjectsToMove.clear();
+        StoreChanges.clear();
+    }
+};
+
 enum EncounterCreditType : uint8
 {
     ENCOUNTER_CREDIT_KILL_CREATURE  = 0,
@@ -219,6 +251,8 @@ public:
     void LoadGrid(float x, float y);
     void LoadAllGrids();
     void LoadGridsInRange(Position const& center, float radius);
+    // Lets the GridPreloader read the terrain of the grid at x, y before it is needed, a no-op for instances
+    void PreloadGrid(float x, float y);
     bool UnloadGrid(MapGridType& grid);
     virtual void UnloadAll();
 
@@ -234,6 +268,7 @@ public:
     [[nodiscard]] std::shared_mutex& GetMMapLock() const { return *(const_cast<std::shared_mutex*>(&MMapLock)); }
     // pussywizard:
     std::unordered_set<Unit*> i_objectsForDelayedVisibility;
+    void AddObjectForDelayedVisibility(Unit* unit);
     void HandleDelayedVisibility();
 
     // some calls like isInWater should not use vmaps due to processor power
@@ -347,6 +382,12 @@ public:
 
     MapStoredObjectTypesContainer& GetObjectsStore() { return _objectsStore; }
 
+    // Registers creatures, gameobjects and dynamic objects for guid and spawn id lookups. Other regions
+    // read the stores without a lock, so the changes of a region worker are applied in the serial merge.
+    // Until then only Get*() of the same region sees them, lookups by spawn id do not
+    void AddToObjectsStore(WorldObject* obj);
+    void RemoveFromObjectsStore(WorldObject* obj);
+
     typedef std::unordered_multimap<ObjectGuid::LowType, Creature*> CreatureBySpawnIdContainer;
     CreatureBySpawnIdContainer& GetCreatureBySpawnIdStore() { return _creatureBySpawnIdStore; }
 
@@ -387,14 +428,35 @@ public:
     bool CanReachPositionAndGetValidCoords(WorldObject const* source, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
     bool CanReachPositionAndGetValidCoords(WorldObject const* source, float startX, float startY, float startZ, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
     bool CheckCollisionAndGetValidCoords(WorldObject const* source, float startX, float startY, float startZ, float &destX, float &destY, float &destZ, bool failOnCollision = true) const;
-    void Balance() { _dynamicTree.balance(); }
-    void RemoveGameObjectModel(const GameObjectModel& model) { _dynamicTree.remove(model); }
-    void InsertGameObjectModel(const GameObjectModel& model) { _dynamicTree.insert(model); }
-    [[nodiscard]] bool ContainsGameObjectModel(const GameObjectModel& model) const { return _dynamicTree.contains(model);}
+    void Balance()
+    {
+        std::unique_lock<std::mutex> guard = LockDynamicTree();
+        _dynamicTree.balance();
+    }
+
+    void RemoveGameObjectModel(const GameObjectModel& model)
+    {
+        std::unique_lock<std::mutex> guard = LockDynamicTree();
+        _dynamicTree.remove(model);
+    }
+
+    void InsertGameObjectModel(const GameObjectModel& model)
+    {
+        std::unique_lock<std::mutex> guard = LockDynamicTree();
+        _dynamicTree.insert(model);
+    }
+
+    [[nodiscard]] bool ContainsGameObjectModel(const GameObjectModel& model) const
+    {
+        std::unique_lock<std::mutex> guard = LockDynamicTree();
+        return _dynamicTree.contains(model);
+    }
+
     [[nodiscard]] DynamicMapTree const& GetDynamicMapTree() const { return _dynamicTree; }
     bool GetObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist);
     [[nodiscard]] float GetGameObjectFloor(uint32 phasemask, float x, float y, float z, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const
     {
+        std::unique_lock<std::mutex> guard = LockDynamicTree();
         return _dynamicTree.getHeight(x, y, z, maxSearchDist, phasemask);
     }
     /*
@@ -403,6 +465,10 @@ public:
     [[nodiscard]] time_t GetLinkedRespawnTime(ObjectGuid guid) const;
     [[nodiscard]] time_t GetCreatureRespawnTime(ObjectGuid::LowType dbGuid) const
     {
+        std::unique_lock<std::mutex> guard(_respawnTimesLock, std::defer_lock);
+        if (IsInRegionUpdate())
+            guard.lock();
+
         std::unordered_map<ObjectGuid::LowType /*dbGUID*/, time_t>::const_iterator itr = _creatureRespawnTimes.find(dbGuid);
         if (itr != _creatureRespawnTimes.end())
             return itr->second;
@@ -412,6 +478,10 @@ public:
 
     [[nodiscard]] time_t GetGORespawnTime(ObjectGuid::LowType dbGuid) const
     {
+        std::unique_lock<std::mutex> guard(_respawnTimesLock, std::defer_lock);
+        if (IsInRegionUpdate())
+            guard.lock();
+
         std::unordered_map<ObjectGuid::LowType /*dbGUID*/, time_t>::const_iterator itr = _goRespawnTimes.find(dbGuid);
         if (itr != _goRespawnTimes.end())
             return itr->second;
@@ -480,21 +550,50 @@ public:
     inline ObjectGuid::LowType GenerateLowGuid()
     {
         static_assert(ObjectGuidTraits<high>::MapSpecific, "Only map specific guid can be generated in Map context");
+
+        // Summons of several regions must not get the same guid
+        std::unique_lock<std::mutex> guard(_regionMergeLock, std::defer_lock);
+        if (IsInRegionUpdate())
+            guard.lock();
+
         return GetGuidSequenceGenerator<high>().Generate();
     }
 
     void AddUpdateObject(Object* obj)
     {
+        std::unique_lock<std::mutex> guard(_regionMergeLock, std::defer_lock);
+        if (IsInRegionUpdate())
+            guard.lock();
+
         _updateObjects.insert(obj);
     }
 
     void RemoveUpdateObject(Object* obj)
     {
+        std::unique_lock<std::mutex> guard(_regionMergeLock, std::defer_lock);
+        if (IsInRegionUpdate())
+            guard.lock();
+
         _updateObjects.erase(obj);
     }
 
+    // True while the calling thread updates a region of this map in a partitioned update
+    [[nodiscard]] bool IsInRegionUpdate() const;
+    [[nodiscard]] bool CanUsePartitionedUpdate() const;
+
     size_t GetUpdatableObjectsCount() const { return _updatableObjectList.size(); }
 
+    // Path searches that are run together after the objects were updated, see MapUpdate.Pathfinding.Async
+    PathRequestQueue& GetPathRequests() { return _pathRequests; }
+
+    // Measured by MapUpdater, used to schedule the most expensive maps first
+    MapUpdateCostHistory& GetUpdateCostHistory() { return _updateCostHistory; }
+    MapUpdateCostHistory const& GetUpdateCostHistory() const { return _updateCostHistory; }
+    MapUpdateCostHistory& GetSessionUpdateCostHistory() { return _sessionUpdateCostHistory; }
+    MapUpdateCostHistory const& GetSessionUpdateCostHistory() const { return _sessionUpdateCostHistory; }
+    // Shared by all instances of the map id
+    MetricHistogram& GetUpdateTimeHistogram() { return *_updateTimeHistogram; }
+
     virtual std::string GetDebugInfo() const;
 
     uint32 GetCreatedGridsCount();
@@ -537,6 +636,7 @@ private:
     std::vector<DynamicObject*> _dynamicObjectsToMove;
 
     bool EnsureGridLoaded(Cell const& cell);
+    void PreloadGridsAhead(Player* player, float x, float y);
     MapGridType* GetMapGrid(uint16 const x, uint16 const y);
 
     void ScriptsProcess();
@@ -592,6 +692,13 @@ private:
     void DeleteFromWorld(T*);
 
     void UpdateNonPlayerObjects(uint32 const diff);
+    void UpdateNonPlayerObjectsPartitioned(uint32 const diff);
+    void UpdateRegion(MapRegionUpdateContext& context, uint32 const diff);
+    template<class T> void RelocateWithinRegion(std::vector<T*>& moveList);
+    void ApplyObjectsStoreChange(MapObjectsStoreChange const& change);
+    template<class T> T* FindInObjectsStore(ObjectGuid const& guid);
+    // Locked only in a region update, reads of the tree may rebalance it
+    [[nodiscard]] std::unique_lock<std::mutex> LockDynamicTree() const;
 
     void _AddObjectToUpdateList(WorldObject* obj);
     void _RemoveObjectFromUpdateList(WorldObject* obj);
@@ -631,6 +738,20 @@ private:
     PendingAddUpdatableObjectList _pendingAddUpdatableObjectList;
     IntervalTimer _updatableObjectListRecheckTimer;
     ZoneWideVisibleWorldObjectsMap _zoneWideVisibleWorldObjectsMap;
+
+    // Partitioned update, indexed by region, see MapUpdate.Partition.Enable
+    std::vector<MapRegionUpdateContext> _regionUpdateContexts;
+    std::mutex _regionMergeLock;
+    mutable std::mutex _respawnTimesLock;
+    mutable std::mutex _dynamicTreeLock;
+    // Adding objects and loading grids from a region are done one region at a time
+    std::recursive_mutex _regionSerialLock;
+
+    PathRequestQueue _pathRequests;
+
+    MapUpdateCostHistory _updateCostHistory;
+    MapUpdateCostHistory _sessionUpdateCostHistory;
+    MetricHistogram* _updateTimeHistogram;
 };
 
 enum InstanceResetMethod
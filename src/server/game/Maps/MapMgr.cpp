@@ -17,6 +17,7 @@
 
 #include "MapMgr.h"
 #include "Chat.h"
+#include "Config.h"
 #include "DatabaseEnv.h"
 #include "GridDefines.h"
 #include "GridTerrainLoader.h"
@@ -59,6 +60,9 @@ void MapMgr::Initialize()
     // Start mtmaps if needed
     if (num_threads > 0)
         m_updater.activate(num_threads);
+
+    if (uint32 preloadThreads = sWorld->getIntConfig(CONFIG_GRID_PRELOAD_THREADS))
+        m_gridPreloader.activate(preloadThreads, sWorld->GetDataPath(), sConfigMgr->GetOption<std::string>("DataDir", "."));
 }
 
 void MapMgr::InitializeVisibilityDistanceInfo()
@@ -335,6 +339,8 @@ void MapMgr::UnloadAll()
 
     if (m_updater.activated())
         m_updater.deactivate();
+
+    m_gridPreloader.deactivate();
 }
 
 void MapMgr::GetNumInstances(uint32& dungeons, uint32& battlegrounds, uint32& arenas)
@@ -20,6 +20,7 @@
 
 #include "Common.h"
 #include "Define.h"
+#include "GridPreloader.h"
 #include "Map.h"
 #include "MapInstanced.h"
 #include "MapUpdater.h"
@@ -151,6 +152,7 @@ public:
     uint32 GenerateInstanceId();
 
     MapUpdater* GetMapUpdater() { return &m_updater; }
+    GridPreloader* GetGridPreloader() { return &m_gridPreloader; }
 
     template<typename Worker>
     void DoForAllMaps(Worker&& worker);
@@ -176,6 +178,7 @@ private:
     InstanceIds _instanceIds;
     uint32 _nextInstanceId;
     MapUpdater m_updater;
+    GridPreloader m_gridPreloader;
 };
 
 template<typename Worker>
@@ -22,6 +22,8 @@
 #include "Map.h"
 #include "MapMgr.h"
 #include "Metric.h"
+#include <algorithm>
+#include <limits>
 
 class UpdateRequest
 {
@@ -30,26 +32,41 @@ public:
     virtual ~UpdateRequest() = default;
 
     virtual void call() = 0;
+
+    // Expected run time in microseconds, used to start the most expensive requests first
+    [[nodiscard]] virtual uint64 GetExpectedCost() const { return 0; }
 };
 
 class MapUpdateRequest : public UpdateRequest
 {
 public:
-    MapUpdateRequest(Map& m, MapUpdater& u, uint32 d, uint32 sd)
-        : m_map(m), m_updater(u), m_diff(d), s_diff(sd)
+    MapUpdateRequest(Map& m, uint32 d, uint32 sd)
+        : m_map(m), m_diff(d), s_diff(sd)
     {
     }
 
     void call() override
     {
         METRIC_TIMER("map_update_time_diff", METRIC_TAG("map_id", std::to_string(m_map.GetId())));
+
+        auto start = std::chrono::steady_clock::now();
         m_map.Update(m_diff, s_diff);
-        m_updater.update_finished();
+        uint32 duration = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+
+        // Session-only updates (m_diff == 0) are far cheaper than full ones, keep separate histories
+        (m_diff ? m_map.GetUpdateCostHistory() : m_map.GetSessionUpdateCostHistory()).Record(duration);
+
+        if (m_diff)
+            METRIC_HISTOGRAM_OBSERVE(m_map.GetUpdateTimeHistogram(), std::chrono::microseconds(duration));
+    }
+
+    uint64 GetExpectedCost() const override
+    {
+        return (m_diff ? m_map.GetUpdateCostHistory() : m_map.GetSessionUpdateCostHistory()).GetAverage();
     }
 
 private:
     Map& m_map;
-    MapUpdater& m_updater;
     uint32 m_diff;
     uint32 s_diff;
 };
@@ -57,8 +74,8 @@ private:
 class MapPreloadRequest : public UpdateRequest
 {
 public:
-    MapPreloadRequest(uint32 mapId, MapUpdater& updater)
-        : _mapId(mapId), _updater(updater)
+    explicit MapPreloadRequest(uint32 mapId)
+        : _mapId(mapId)
     {
     }
 
@@ -67,39 +84,132 @@ public:
         Map* map = sMapMgr->CreateBaseMap(_mapId);
         LOG_INFO("server.loading", ">> Loading All Grids For Map {} ({})", map->GetId(), map->GetMapName());
         map->LoadAllGrids();
-        _updater.update_finished();
     }
 
 private:
     uint32 _mapId;
-    MapUpdater& _updater;
 };
 
 class LFGUpdateRequest : public UpdateRequest
 {
 public:
-    LFGUpdateRequest(MapUpdater& u, uint32 d) : m_updater(u), m_diff(d) {}
+    explicit LFGUpdateRequest(uint32 d) : m_diff(d) {}
 
     void call() override
     {
         sLFGMgr->Update(m_diff, 1);
-        m_updater.update_finished();
     }
 private:
-    MapUpdater& m_updater;
     uint32 m_diff;
 };
 
-MapUpdater::MapUpdater() : pending_requests(0), _cancelationToken(false)
+class ParallelBatch
+{
+public:
+    ParallelBatch(std::size_t count, std::function<void(std::size_t)> const& work)
+        : _count(count), _work(work), _next(0), _done(0)
+    {
+    }
+
+    // Claims and runs indices until the batch is exhausted
+    void Process()
+    {
+        std::size_t index;
+        while ((index = _next.fetch_add(1, std::memory_order_relaxed)) < _count)
+        {
+            _work(index);
+
+            if (_done.fetch_add(1, std::memory_order_acq_rel) + 1 == _count)
+            {
+                std::lock_guard<std::mutex> guard(_lock);
+                _condition.notify_all();
+            }
+        }
+    }
+
+    void Wait()
+    {
+        std::unique_lock<std::mutex> guard(_lock);
+        _condition.wait(guard, [this] { return _done.load(std::memory_order_acquire) == _count; });
+    }
+
+private:
+    std::size_t const _count;
+    std::function<void(std::size_t)> const& _work;
+    std::atomic<std::size_t> _next;
+    std::atomic<std::size_t> _done;
+    std::mutex _lock;
+    std::condition_variable _condition;
+};
+
+class ParallelBatchRequest : public UpdateRequest
+{
+public:
+    explicit ParallelBatchRequest(std::shared_ptr<ParallelBatch> batch)
+        : _batch(std::move(batch))
+    {
+    }
+
+    void call() override
+    {
+        _batch->Process();
+    }
+
+    // A map update is blocked on this batch, start it before anything else
+    uint64 GetExpectedCost() const override { return std::numeric_limits<uint64>::max(); }
+
+private:
+    std::shared_ptr<ParallelBatch> _batch;
+};
+
+void MapUpdateCostHistory::Record(uint32 durationUs)
+{
+    if (_count == HISTORY_SIZE)
+        _sum -= _samples[_next];
+    else
+        ++_count;
+
+    _samples[_next] = durationUs;
+    _sum += durationUs;
+    _next = (_next + 1) % HISTORY_SIZE;
+    _last = durationUs;
+}
+
+uint32 MapUpdateCostHistory::GetMax() const
+{
+    uint32 max = 0;
+    for (std::size_t i = 0; i < _count; ++i)
+        max = std::max(max, _samples[i]);
+    return max;
+}
+
+std::vector<uint32> MapUpdateCostHistory::GetHistory() const
+{
+    std::vector<uint32> history;
+    history.reserve(_count);
+
+    std::size_t first = _count == HISTORY_SIZE ? _next : 0;
+    for (std::size_t i = 0; i < _count; ++i)
+        history.push_back(_samples[(first + i) % HISTORY_SIZE]);
+
+    return history;
+}
+
+MapUpdater::MapUpdater() : _queuedRequests(0), pending_requests(0), _cancelationToken(false), _batchBusyTime(0),
+    _lastStragglerTime(0), _lastBatchTime(0)
 {
 }
 
 void MapUpdater::activate(std::size_t num_threads)
 {
+    _workerQueues.reserve(num_threads);
+    for (std::size_t i = 0; i < num_threads; ++i)
+        _workerQueues.push_back(std::make_unique<WorkerQueue>());
+
     _workerThreads.reserve(num_threads);
     for (std::size_t i = 0; i < num_threads; ++i)
     {
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
     }
 }
 
@@ -109,7 +219,11 @@ void MapUpdater::deactivate()
 
     wait();  // This is where we wait for tasks to complete
 
-    _queue.Cancel();  // Cancel the queue to prevent further task processing
+    {
+        // Wake up sleeping workers so they can see the cancellation
+        std::lock_guard<std::mutex> guard(_sleepLock);
+        _workAvailable.notify_all();
+    }
 
     // Join all worker threads
     for (auto& thread : _workerThreads)
@@ -119,6 +233,13 @@ void MapUpdater::deactivate()
             thread.join();
         }
     }
+
+    for (std::unique_ptr<WorkerQueue>& queue : _workerQueues)
+    {
+        for (UpdateRequest* request : queue->Requests)
+            delete request;
+        queue->Requests.clear();
+    }
 }
 
 void MapUpdater::wait()
@@ -129,28 +250,76 @@ void MapUpdater::wait()
     _condition.wait(guard, [this] {
         return pending_requests.load(std::memory_order_acquire) == 0;
     });
+
+    if (_workerThreads.empty())
+        return;
+
+    // Every worker could have been busy for the whole batch, whatever is missing was spent waiting for stragglers
+    uint64 batchTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _batchStart).count();
+    uint64 busyTime = _batchBusyTime.exchange(0, std::memory_order_relaxed);
+    uint64 capacity = batchTime * _workerThreads.size();
+    _lastBatchTime.store(uint32(std::min<uint64>(batchTime, std::numeric_limits<uint32>::max())), std::memory_order_relaxed);
+    _lastStragglerTime.store(capacity > busyTime ? uint32((capacity - busyTime) / _workerThreads.size()) : 0, std::memory_order_relaxed);
 }
 
 void MapUpdater::schedule_task(UpdateRequest* request)
 {
     // Atomic increment for pending_requests
-    pending_requests.fetch_add(1, std::memory_order_release);
-    _queue.Push(request);
-}
+    if (pending_requests.fetch_add(1, std::memory_order_release) == 0)
+        _batchStart = std::chrono::steady_clock::now();
+
+    // Longest processing time first: hand the request to the worker with the least queued work,
+    // keeping each queue sorted so the most expensive requests are started first
+    WorkerQueue* target = _workerQueues.front().get();
+    for (std::unique_ptr<WorkerQueue>& queue : _workerQueues)
+        if (queue->PendingCost.load(std::memory_order_relaxed) < target->PendingCost.load(std::memory_order_relaxed))
+            target = queue.get();
+
+    uint64 cost = request->GetExpectedCost();
+    {
+        std::lock_guard<std::mutex> guard(target->Lock);
+        auto itr = std::find_if(target->Requests.begin(), target->Requests.end(), [cost](UpdateRequest const* queued)
+        {
+            return queued->GetExpectedCost() < cost;
+        });
+        target->Requests.insert(itr, request);
+        target->PendingCost.fetch_add(std::min<uint64>(cost, std::numeric_limits<uint32>::max()), std::memory_order_relaxed);
+    }
 
+    _queuedRequests.fetch_add(1, std::memory_order_release);
+
+    std::lock_guard<std::mutex> guard(_sleepLock);
+    _workAvailable.notify_one();
+}
 void MapUpdater::schedule_update(Map& map, uint32 diff, uint32 s_diff)
 {
-    schedule_task(new MapUpdateRequest(map, *this, diff, s_diff));
+    schedule_task(new MapUpdateRequest(map, diff, s_diff));
 }
 
 void MapUpdater::schedule_map_preload(uint32 mapid)
 {
-    schedule_task(new MapPreloadRequest(mapid, *this));
+    schedule_task(new MapPreloadRequest(mapid));
 }
 
 void MapUpdater::schedule_lfg_update(uint32 diff)
 {
-    schedule_task(new LFGUpdateRequest(*this, diff));
+    schedule_task(new LFGUpdateRequest(diff));
+}
+
+void MapUpdater::run_parallel(std::size_t count, std::function<void(std::size_t)> const& work)
+{
+    if (!count)
+        return;
+
+    std::shared_ptr<ParallelBatch> batch = std::make_shared<ParallelBatch>(count, work);
+
+    // Helpers that start after the batch is exhausted return immediately, the caller never waits on them
+    std::size_t helpers = _workerThreads.empty() ? 0 : std::min(count, _workerThreads.size()) - 1;
+    for (std::size_t i = 0; i < helpers; ++i)
+        schedule_task(new ParallelBatchRequest(batch));
+
+    batch->Process();
+    batch->Wait();
 }
 
 bool MapUpdater::activated()
@@ -169,7 +338,49 @@ void MapUpdater::update_finished()
     }
 }
 
-void MapUpdater::WorkerThread()
+UpdateRequest* MapUpdater::PopFrom(WorkerQueue& queue)
+{
+    std::lock_guard<std::mutex> guard(queue.Lock);
+    if (queue.Requests.empty())
+        return nullptr;
+
+    UpdateRequest* request = queue.Requests.front();
+    queue.Requests.pop_front();
+    queue.PendingCost.fetch_sub(std::min<uint64>(request->GetExpectedCost(), std::numeric_limits<uint32>::max()), std::memory_order_relaxed);
+    return request;
+}
+
+UpdateRequest* MapUpdater::PopRequest(std::size_t index)
+{
+    UpdateRequest* request = PopFrom(*_workerQueues[index]);
+
+    // Own queue is empty, steal the most expensive pending request of the most loaded worker
+    while (!request && _queuedRequests.load(std::memory_order_acquire) > 0)
+    {
+        WorkerQueue* victim = nullptr;
+        for (std::unique_ptr<WorkerQueue>& queue : _workerQueues)
+            if (!victim || queue->PendingCost.load(std::memory_order_relaxed) > victim->PendingCost.load(std::memory_order_relaxed))
+                victim = queue.get();
+
+        request = PopFrom(*victim);
+        if (request)
+            break;
+
+        // Costs are only a hint, fall back to scanning every queue
+        for (std::size_t i = 1; i <= _workerQueues.size() && !request; ++i)
+            request = PopFrom(*_workerQueues[(index + i) % _workerQueues.size()]);
+
+        if (!request)
+            std::this_thread::yield();
+    }
+
+    if (request)
+        _queuedRequests.fetch_sub(1, std::memory_order_acq_rel);
+
+    return request;
+}
+
+void MapUpdater::WorkerThread(std::size_t index)
 {
     LoginDatabase.WarnAboutSyncQueries(true);
     CharacterDatabase.WarnAboutSyncQueries(true);
@@ -177,14 +388,21 @@ void MapUpdater::WorkerThread()
 
     while (!_cancelationToken)
     {
-        UpdateRequest* request = nullptr;
-
-        _queue.WaitAndPop(request);  // Wait for and pop a request from the queue
-
-        if (!_cancelationToken && request)
+        UpdateRequest* request = PopRequest(index);
+        if (!request)
         {
-            request->call();  // Execute the request
-            delete request;  // Clean up after processing
+            std::unique_lock<std::mutex> guard(_sleepLock);
+            _workAvailable.wait(guard, [this] {
+                return _cancelationToken || _queuedRequests.load(std::memory_order_acquire) > 0;
+            });
+            continue;
         }
+
+        auto start = std::chrono::steady_clock::now();
+        request->call();  // Execute the request
+        delete request;  // Clean up after processing
+        _batchBusyTime.fetch_add(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count(), std::memory_order_relaxed);
+
+        update_finished();
     }
 }
@@ -19,14 +19,44 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Define.h"
-#include "PCQueue.h"
+#include <array>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <atomic>
+#include <vector>
 
 class Map;
 class UpdateRequest;
 
+// Rolling window of the measured update durations (microseconds) of one map
+class MapUpdateCostHistory
+{
+public:
+    static constexpr std::size_t HISTORY_SIZE = 16;
+
+    void Record(uint32 durationUs);
+
+    [[nodiscard]] uint32 GetLast() const { return _last; }
+    [[nodiscard]] uint32 GetAverage() const { return _count ? uint32(_sum / _count) : 0; }
+    [[nodiscard]] uint32 GetMax() const;
+    [[nodiscard]] std::size_t GetCount() const { return _count; }
+
+    // Oldest sample first
+    [[nodiscard]] std::vector<uint32> GetHistory() const;
+
+private:
+    std::array<uint32, HISTORY_SIZE> _samples{};
+    std::size_t _next{0};
+    std::size_t _count{0};
+    uint64 _sum{0};
+    uint32 _last{0};
+};
+
 class MapUpdater
 {
 public:
@@ -37,20 +67,51 @@ public:
     void schedule_update(Map& map, uint32 diff, uint32 s_diff);
     void schedule_map_preload(uint32 mapid);
     void schedule_lfg_update(uint32 diff);
+
+    // Runs work(0) .. work(count - 1) on the worker threads and returns once all of them are done.
+    // The calling thread takes part in the batch, so it is safe to call from inside a map update.
+    void run_parallel(std::size_t count, std::function<void(std::size_t)> const& work);
+
     void wait();
     void activate(std::size_t num_threads);
     void deactivate();
     bool activated();
     void update_finished();
 
+    // Average time (microseconds) a worker sat idle during the last batch while others were still busy
+    [[nodiscard]] uint32 GetLastStragglerTime() const { return _lastStragglerTime.load(std::memory_order_relaxed); }
+    // Wall clock time (microseconds) of the last batch, from the first scheduled request to wait() returning
+    [[nodiscard]] uint32 GetLastBatchTime() const { return _lastBatchTime.load(std::memory_order_relaxed); }
+
 private:
-    void WorkerThread();
-    ProducerConsumerQueue<UpdateRequest*> _queue;
+    // Requests queued for one worker, ordered by expected cost (most expensive first)
+    struct WorkerQueue
+    {
+        std::mutex Lock;
+        std::deque<UpdateRequest*> Requests;
+        std::atomic<uint64> PendingCost{0};
+    };
+
+    void WorkerThread(std::size_t index);
+    UpdateRequest* PopRequest(std::size_t index);
+    UpdateRequest* PopFrom(WorkerQueue& queue);
+
+    std::vector<std::unique_ptr<WorkerQueue>> _workerQueues;
+    std::atomic<uint32> _queuedRequests;
+    std::mutex _sleepLock;
+    std::condition_variable _workAvailable;
+
     std::atomic<int> pending_requests;  // Use std::atomic for pending_requests to avoid lock contention
     std::atomic<bool> _cancelationToken;  // Atomic flag for cancellation to avoid race conditions
     std::vector<std::thread> _workerThreads;
     std::mutex _lock; // Mutex and condition variable for synchronization
     std::condition_variable _condition;
+
+    // Straggler accounting for the batch in progress
+    std::chrono::steady_clock::time_point _batchStart;
+    std::atomic<uint64> _batchBusyTime;
+    std::atomic<uint32> _lastStragglerTime;
+    std::atomic<uint32> _lastBatchTime;
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
@@ -25,23 +25,39 @@
 #include "Map.h"
 #include "Metric.h"
 
+namespace
+{
+    // Map lookups can create grids, which add navmesh tiles under the exclusive lock
+    class NavMeshUnlockGuard
+    {
+    public:
+        explicit NavMeshUnlockGuard(std::shared_lock<std::shared_mutex>& lock) : _lock(lock), _owned(lock.owns_lock())
+        {
+            if (_owned)
+                _lock.unlock();
+        }
+
+        ~NavMeshUnlockGuard()
+        {
+            if (_owned)
+                _lock.lock();
+        }
+
+    private:
+        std::shared_lock<std::shared_mutex>& _lock;
+        bool _owned;
+    };
+}
+
  ////////////////// PathGenerator //////////////////
 PathGenerator::PathGenerator(WorldObject const* owner) :
     _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false), _forceDestination(false),
     _slopeCheck(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _useRaycast(false),
     _endPosition(G3D::Vector3::zero()), _source(owner), _navMesh(nullptr),
-    _navMeshQuery(nullptr)
+    _navMeshQuery(nullptr), _pathCache(nullptr)
 {
     memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
 
-    uint32 mapId = _source->GetMapId();
-    //if (sDisableMgr->IsPathfindingEnabled(_sourceUnit->FindMap()))
-    {
-        MMAP::MMapMgr* mmap = MMAP::MMapFactory::createOrGetMMapMgr();
-        _navMesh = mmap->GetNavMesh(mapId);
-        _navMeshQuery = mmap->GetNavMeshQuery(mapId, _source->GetInstanceId());
-    }
-
     CreateFilter();
 }
 
@@ -72,11 +88,16 @@ bool PathGenerator::CalculatePath(float x, float y, float z, float destX, float
 
     _forceDestination = forceDest;
 
+    // the query belongs to the calling thread, so it is looked up on every call instead of once per owner
+    uint32 mapId = _source->GetMapId();
+    MMAP::MMapMgr* mmap = MMAP::MMapFactory::createOrGetMMapMgr();
+    _navMesh = mmap->GetNavMesh(mapId);
+    _navMeshQuery = mmap->GetNavMeshQuery(mapId);
+    _pathCache = mmap->GetPathCache(mapId);
+
     // make sure navMesh works - we can run on map w/o mmap
-    // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
     Unit const* _sourceUnit = _source->ToUnit();
-    if (!_navMesh || !_navMeshQuery || (_sourceUnit && _sourceUnit->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING)) ||
-        !HaveTile(start) || !HaveTile(dest))
+    if (!_navMesh || !_navMeshQuery || (_sourceUnit && _sourceUnit->HasUnitState(UNIT_STATE_IGNORE_PATHFINDING)))
     {
         BuildShortcut();
         _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
@@ -85,7 +106,20 @@ bool PathGenerator::CalculatePath(float x, float y, float z, float destX, float
 
     UpdateFilter();
 
+    // other threads may add or remove tiles of the same navmesh meanwhile
+    _navMeshLock = mmap->LockNavMesh(mapId);
+
+    // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
+    if (!HaveTile(start) || !HaveTile(dest))
+    {
+        _navMeshLock.unlock();
+        BuildShortcut();
+        _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
+        return true;
+    }
+
     BuildPolyPath(start, dest);
+    _navMeshLock.unlock();
     return true;
 }
 
@@ -183,7 +217,11 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
 
         bool canSwim = creature ? creature->CanSwim() : true;
         bool path = creature ? creature->CanFly() : true;
-        bool waterPath = IsWaterPath(_pathPoints);
+        bool waterPath;
+        {
+            NavMeshUnlockGuard unlocked(_navMeshLock);
+            waterPath = IsWaterPath(_pathPoints);
+        }
         if (path || (waterPath && canSwim))
         {
             _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
@@ -211,8 +249,12 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
     {
         bool buildShortcut = false;
 
-        auto liquidDataStart = _source->GetMap()->GetLiquidData(_source->GetPhaseMask(), startPos.x, startPos.y, startPos.z, _source->GetCollisionHeight(), MAP_ALL_LIQUIDS);
-        auto liquidDataEnd = _source->GetMap()->GetLiquidData(_source->GetPhaseMask(), endPos.x, endPos.y, endPos.z, _source->GetCollisionHeight(), MAP_ALL_LIQUIDS);
+        LiquidData liquidDataStart, liquidDataEnd;
+        {
+            NavMeshUnlockGuard unlocked(_navMeshLock);
+            liquidDataStart = _source->GetMap()->GetLiquidData(_source->GetPhaseMask(), startPos.x, startPos.y, startPos.z, _source->GetCollisionHeight(), MAP_ALL_LIQUIDS);
+            liquidDataEnd = _source->GetMap()->GetLiquidData(_source->GetPhaseMask(), endPos.x, endPos.y, endPos.z, _source->GetCollisionHeight(), MAP_ALL_LIQUIDS);
+        }
 
         bool startUnderWaterEndInWater = liquidDataStart.Status == LIQUID_MAP_UNDER_WATER &&
                                          (liquidDataEnd.Status & MAP_LIQUID_STATUS_IN_CONTACT) != 0;
@@ -472,15 +514,29 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         }
         else
         {
-            dtResult = _navMeshQuery->findPath(
-                startPoly,          // start polygon
-                endPoly,            // end polygon
-                startPoint,         // start position
-                endPoint,           // end position
-                &_filter,           // polygon search filter
-                _pathPolyRefs,     // [out] path
-                (int*)&_polyLength,
-                MAX_PATH_LENGTH);   // max number of polygons in output path
+            MMAP::PathCache::Key const cacheKey = { startPoly, endPoly, _filter.getIncludeFlags(), _filter.getExcludeFlags() };
+            _polyLength = _pathCache ? _pathCache->Find(cacheKey, _pathPolyRefs, MAX_PATH_LENGTH) : 0;
+            if (_polyLength)
+            {
+                dtResult = DT_SUCCESS;
+            }
+            else
+            {
+                dtResult = _navMeshQuery->findPath(
+                    startPoly,          // start polygon
+                    endPoly,            // end polygon
+                    startPoint,         // start position
+                    endPoint,           // end position
+                    &_filter,           // polygon search filter
+                    _pathPolyRefs,     // [out] path
+                    (int*)&_polyLength,
+                    MAX_PATH_LENGTH);   // max number of polygons in output path
+
+                // a partial corridor depends on the exact end position, only complete ones are shared
+                if (_pathCache && dtStatusSucceed(dtResult) && !dtStatusDetail(dtResult, DT_PARTIAL_RESULT) &&
+                    _polyLength && _pathPolyRefs[_polyLength - 1] == endPoly)
+                    _pathCache->Store(cacheKey, _pathPolyRefs, _polyLength);
+            }
         }
 
         if (!_polyLength || dtStatusFailed(dtResult))
@@ -625,6 +681,8 @@ void PathGenerator::BuildPointPath(const float* startPoint, const float* endPoin
 
 void PathGenerator::NormalizePath()
 {
+    // height lookups may create the grid of a point
+    NavMeshUnlockGuard unlocked(_navMeshLock);
     for (uint32 i = 0; i < _pathPoints.size(); ++i)
     {
         _source->UpdateAllowedPositionZ(_pathPoints[i].x, _pathPoints[i].y, _pathPoints[i].z);
@@ -898,7 +956,14 @@ dtStatus PathGenerator::FindSmoothPath(float const* startPos, float const* endPo
 
         bool canCheckSlope = _slopeCheck && (GetPathType() & ~(PATHFIND_NOT_USING_PATH));
 
-        if (canCheckSlope && !IsSwimmableSegment(iterPos, steerPos) && !IsWalkableClimb(iterPos, steerPos))
+        bool tooSteep = false;
+        if (canCheckSlope)
+        {
+            NavMeshUnlockGuard unlocked(_navMeshLock);
+            tooSteep = !IsSwimmableSegment(iterPos, steerPos) && !IsWalkableClimb(iterPos, steerPos);
+        }
+
+        if (tooSteep)
         {
             nsmoothPath--;
             *smoothPathSize = nsmoothPath;
@@ -1098,6 +1163,18 @@ void PathGenerator::ShortenPathUntilDist(G3D::Vector3 const& target, float dist)
     _pathPoints.resize(i + 1);
 }
 
+void PathGenerator::CopyPathFrom(PathGenerator const& other)
+{
+    memcpy(_pathPolyRefs, other._pathPolyRefs, sizeof(dtPolyRef) * other._polyLength);
+    _polyLength = other._polyLength;
+    _pathPoints = other._pathPoints;
+    _type = other._type;
+    _forceDestination = other._forceDestination;
+    _startPosition = other._startPosition;
+    _endPosition = other._endPosition;
+    _actualEndPosition = other._actualEndPosition;
+}
+
 bool PathGenerator::IsInvalidDestinationZ(Unit const* target) const
 {
     return (target->GetPositionZ() - GetActualEndPosition().z) > 5.0f;
@@ -25,6 +25,7 @@
 #include "MoveSplineInitArgs.h"
 #include "SharedDefines.h"
 #include <G3D/Vector3.h>
+#include <shared_mutex>
 
 class Unit;
 class WorldObject;
@@ -94,6 +95,9 @@ class PathGenerator
         // shortens the path until the destination is the specified distance from the target point
         void ShortenPathUntilDist(G3D::Vector3 const& point, float dist);
 
+        // takes over the result of another generator that searched from about the same place with the same options
+        void CopyPathFrom(PathGenerator const& other);
+
         [[nodiscard]] float getPathLength() const
         {
             float len = 0.0f;
@@ -146,7 +150,9 @@ class PathGenerator
 
         WorldObject const* const _source;       // the object that is moving
         dtNavMesh const* _navMesh;              // the nav mesh
-        dtNavMeshQuery const* _navMeshQuery;    // the nav mesh query used to find the path
+        dtNavMeshQuery const* _navMeshQuery;    // the nav mesh query of the calculating thread, only valid during CalculatePath
+        MMAP::PathCache* _pathCache;            // corridors found before on the same nav mesh, may be nullptr
+        std::shared_lock<std::shared_mutex> _navMeshLock;   // held while the nav mesh is read
 
         dtQueryFilterExt _filter;  // use single filter for all movements, update it when needed
 
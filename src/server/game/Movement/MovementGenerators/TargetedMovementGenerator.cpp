@@ -23,6 +23,7 @@
 #include "Player.h"
 #include "Spell.h"
 #include "Transport.h"
+#include "World.h"
 
 static bool IsMutualChase(Unit* owner, Unit* target)
 {
@@ -80,6 +81,9 @@ void ChaseMovementGenerator<T>::SetNewTarget(Unit* target)
 template<class T>
 void ChaseMovementGenerator<T>::DistanceYourself(T* owner, float distance)
 {
+    // a queued chase path would override the distancing spline
+    _pathRequest = nullptr;
+
     // make a new path if we have to...
     if (!i_path)
         i_path = std::make_unique<PathGenerator>(owner);
@@ -99,12 +103,51 @@ void ChaseMovementGenerator<T>::DistanceYourself(T* owner, float distance)
 template<class T>
 bool ChaseMovementGenerator<T>::DispatchSplineToPosition(T* owner, float x, float y, float z, bool walk, bool cutPath, float maxTarget, bool forceDest, bool target)
 {
-    Creature* cOwner = owner->ToCreature();
-
     if (owner->IsHovering())
         owner->UpdateAllowedPositionZ(x, y, z);
 
     bool success = i_path->CalculatePath(x, y, z, forceDest);
+    return LaunchPath(owner, x, y, z, walk, cutPath, maxTarget, success, target);
+}
+
+template<class T>
+void ChaseMovementGenerator<T>::RequestSplineToPosition(T* owner, float x, float y, float z, bool walk, bool cutPath, float maxTarget, bool forceDest)
+{
+    if (owner->IsHovering())
+        owner->UpdateAllowedPositionZ(x, y, z);
+
+    PathRequestCallback callback = [this, owner, x, y, z, walk, cutPath, maxTarget](std::unique_ptr<PathGenerator> path, bool success)
+    {
+        _pathRequest = nullptr;
+        i_path = std::move(path);
+
+        // Another generator took over or the chase was paused meanwhile, DoUpdate handles the pause
+        if (owner->GetMotionMaster()->top() != this || !i_target.isValid() || !owner->IsAlive())
+            return;
+
+        if (owner->HasUnitState(UNIT_STATE_NOT_MOVE | UNIT_STATE_NO_COMBAT_MOVEMENT) || HasLostTarget(owner))
+            return;
+
+        if (Creature* cOwner = owner->ToCreature())
+            if (cOwner->IsMovementPreventedByCasting())
+                return;
+
+        LaunchPath(owner, x, y, z, walk, cutPath, maxTarget, success, true);
+    };
+
+    // A chaser of a moving target asks again every update, a pending search keeps its place in the queue
+    PathRequestQueue& requests = owner->GetMap()->GetPathRequests();
+    if (_pathRequest && requests.UpdateRequest(_pathRequest, G3D::Vector3(x, y, z), forceDest, std::move(callback)))
+        return;
+
+    _pathRequest = requests.Request(owner, std::move(i_path), G3D::Vector3(x, y, z), forceDest, std::move(callback));
+}
+
+template<class T>
+bool ChaseMovementGenerator<T>::LaunchPath(T* owner, float x, float y, float z, bool walk, bool cutPath, float maxTarget, bool success, bool target)
+{
+    Creature* cOwner = owner->ToCreature();
+
     if (!success || i_path->GetPathType() & PATHFIND_NOPATH)
     {
         if (cOwner)
@@ -226,7 +269,7 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
                 if ((owner->HasUnitState(UNIT_STATE_CHASE_MOVE) && !target->isMoving() && !mutualChase) || _range)
                 {
                     i_recalculateTravel = false;
-                    i_path = nullptr;
+                    ResetPath();
                     if (cOwner)
                         cOwner->SetCannotReachTarget();
                     owner->StopMoving();
@@ -242,7 +285,7 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
     if (owner->HasUnitState(UNIT_STATE_CHASE_MOVE) && owner->movespline->Finalized())
     {
         i_recalculateTravel = false;
-        i_path = nullptr;
+        ResetPath();
         if (cOwner)
             cOwner->SetCannotReachTarget();
         owner->ClearUnitState(UNIT_STATE_CHASE_MOVE);
@@ -280,7 +323,7 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
             {
                 cOwner->SetCannotReachTarget(target->GetGUID());
                 cOwner->StopMoving();
-                i_path = nullptr;
+                ResetPath();
                 return true;
             }
 
@@ -347,7 +390,10 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
                 }
             }
 
-            DispatchSplineToPosition(owner, x, y, z, walk, shortenPath, maxTarget, forceDest, true);
+            if (sWorld->getBoolConfig(CONFIG_MAP_ASYNC_PATHFINDING))
+                RequestSplineToPosition(owner, x, y, z, walk, shortenPath, maxTarget, forceDest);
+            else
+                DispatchSplineToPosition(owner, x, y, z, walk, shortenPath, maxTarget, forceDest, true);
         }
     }
 
@@ -358,7 +404,7 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
 template<>
 void ChaseMovementGenerator<Player>::DoInitialize(Player* owner)
 {
-    i_path = nullptr;
+    ResetPath();
     _lastTargetPosition.reset();
     owner->StopMoving();
     owner->AddUnitState(UNIT_STATE_CHASE);
@@ -367,7 +413,7 @@ void ChaseMovementGenerator<Player>::DoInitialize(Player* owner)
 template<>
 void ChaseMovementGenerator<Creature>::DoInitialize(Creature* owner)
 {
-    i_path = nullptr;
+    ResetPath();
     _lastTargetPosition.reset();
     i_recheckDistance.Reset(0);
     i_leashExtensionTimer.Reset(owner->GetAttackTime(BASE_ATTACK));
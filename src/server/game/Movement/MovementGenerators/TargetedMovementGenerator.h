@@ -22,6 +22,7 @@
 #include "MovementGenerator.h"
 #include "Optional.h"
 #include "PathGenerator.h"
+#include "PathRequestQueue.h"
 #include "Timer.h"
 #include "Unit.h"
 
@@ -71,9 +72,15 @@ public:
 
     void DistanceYourself(T* owner, float distance);
     bool DispatchSplineToPosition(T* owner, float x, float y, float z, bool walk, bool cutPath, float maxTarget, bool forceDest, bool target = false);
+    // queues the path search on the map and keeps the current spline until the path arrives
+    void RequestSplineToPosition(T* owner, float x, float y, float z, bool walk, bool cutPath, float maxTarget, bool forceDest);
 private:
+    bool LaunchPath(T* owner, float x, float y, float z, bool walk, bool cutPath, float maxTarget, bool success, bool target);
+    void ResetPath() { i_path = nullptr; _pathRequest = nullptr; }
+
     TimeTrackerSmall i_leashExtensionTimer;
     std::unique_ptr<PathGenerator> i_path;
+    PathRequestHandle _pathRequest;
     TimeTrackerSmall i_recheckDistance;
     bool i_recalculateTravel;
 
@@ -463,6 +463,8 @@ void FlightPathMovementGenerator::DoReset(Player* player)
     init.SetFly();
     init.SetVelocity(PLAYER_FLIGHT_SPEED);
     init.Launch();
+
+    PreloadPathGrids(player);
 }
 
 bool FlightPathMovementGenerator::DoUpdate(Player* player, uint32 /*diff*/)
@@ -471,6 +473,7 @@ bool FlightPathMovementGenerator::DoUpdate(Player* player, uint32 /*diff*/)
     uint32 pointId = player->movespline->currentPathIdx() <= 0 ? 0 : player->movespline->currentPathIdx() - 1;
     if (pointId > i_currentNode && i_currentNode < i_path.size() - 1)
     {
+        uint32 previousNode = i_currentNode;
         bool departureEvent = true;
         do
         {
@@ -501,11 +504,30 @@ bool FlightPathMovementGenerator::DoUpdate(Player* player, uint32 /*diff*/)
             i_currentNode += departureEvent ? 1 : 0;
             departureEvent = !departureEvent;
         } while (i_currentNode < i_path.size() - 1);
+
+        if (i_currentNode != previousNode)
+            PreloadPathGrids(player);
     }
 
     return i_currentNode < (i_path.size() - 1);
 }
 
+void FlightPathMovementGenerator::PreloadPathGrids(Player* player)
+{
+    // Follows the path on the current map for as far as the player flies within the preload lookahead
+    Map* map = player->GetMap();
+    float distance = map->GetVisibilityRange() + PLAYER_FLIGHT_SPEED * sWorld->getIntConfig(CONFIG_GRID_PRELOAD_LOOKAHEAD);
+    for (uint32 i = i_currentNode; i + 1 < i_path.size() && distance > 0.0f; ++i)
+    {
+        TaxiPathNodeEntry const* node = i_path[i + 1];
+        if (node->mapid != map->GetId())
+            break;
+
+        distance -= std::hypot(node->x - i_path[i]->x, node->y - i_path[i]->y);
+        map->PreloadGrid(node->x, node->y);
+    }
+}
+
 void FlightPathMovementGenerator::SetCurrentNodeAfterTeleport()
 {
     if (i_path.empty() || i_currentNode >= i_path.size())
@@ -132,6 +132,7 @@ class FlightPathMovementGenerator : public MovementGeneratorMedium< Player, Flig
 
         void InitEndGridInfo();
         void PreloadEndGrid();
+        void PreloadPathGrids(Player* player);
 
     private:
 
@@ -0,0 +1,225 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PathRequestQueue.h"
+#include "Creature.h"
+#include "Map.h"
+#include "Metric.h"
+#include "Optional.h"
+#include "PathGenerator.h"
+#include "World.h"
+#include <chrono>
+#include <cmath>
+#include <map>
+
+struct PathRequest
+{
+    Unit* Owner;
+    std::unique_ptr<PathGenerator> Path;
+    G3D::Vector3 Start;
+    G3D::Vector3 Dest;
+    bool ForceDest;
+    PathRequestCallback Callback;
+    bool Success = false;
+    PathRequest const* Leader = nullptr;   // set if the result is copied from another request
+    bool Dropped = false;                   // its owner left the map before it was processed
+};
+
+namespace
+{
+    // Start and destination are compared on a grid of this size in yards when coalescing
+    constexpr float COALESCE_CELL_SIZE = 2.0f;
+
+    struct CoalesceKey
+    {
+        uint32 Entry;
+        int32 Start[3];
+        int32 Dest[3];
+        bool ForceDest;
+
+        auto operator<=>(CoalesceKey const&) const = default;
+    };
+
+    CoalesceKey MakeCoalesceKey(PathRequest const& request)
+    {
+        auto cell = [](float value) { return int32(std::floor(value / COALESCE_CELL_SIZE)); };
+
+        return { request.Owner->GetEntry(),
+            { cell(request.Start.x), cell(request.Start.y), cell(request.Start.z) },
+            { cell(request.Dest.x), cell(request.Dest.y), cell(request.Dest.z) },
+            request.ForceDest };
+    }
+
+    struct PathRequestMetrics
+    {
+        MetricCounter& Computed = sMetric->GetRegistry().GetCounter("path_requests_total", "Queued path searches by outcome", { METRIC_TAG("result", "computed") });
+        MetricCounter& Coalesced = sMetric->GetRegistry().GetCounter("path_requests_total", "Queued path searches by outcome", { METRIC_TAG("result", "coalesced") });
+        MetricCounter& Cancelled = sMetric->GetRegistry().GetCounter("path_requests_total", "Queued path searches by outcome", { METRIC_TAG("result", "cancelled") });
+        MetricCounter& Deferred = sMetric->GetRegistry().GetCounter("path_requests_deferred_total", "Path searches moved to the next map update by MapUpdate.Pathfinding.TickBudget");
+        MetricHistogram& BatchTime = sMetric->GetRegistry().GetHistogram("path_batch_seconds", "Time a map update spent running its queued path searches");
+        MetricHistogram& BatchSize = sMetric->GetRegistry().GetHistogram("path_batch_size", "Path searches run by one map update", {},
+            { 1, 2, 4, 8, 16, 32, 64, 128, 256 });
+    };
+
+    PathRequestMetrics& GetPathRequestMetrics()
+    {
+        static PathRequestMetrics metrics;
+        return metrics;
+    }
+}
+
+PathRequestHandle PathRequestQueue::Request(Unit* owner, std::unique_ptr<PathGenerator> path, G3D::Vector3 const& dest, bool forceDest, PathRequestCallback callback)
+{
+    if (!path)
+        path = std::make_unique<PathGenerator>(owner);
+
+    PathRequestHandle request = std::make_shared<PathRequest>();
+    request->Owner = owner;
+    request->Path = std::move(path);
+    request->Dest = dest;
+    request->ForceDest = forceDest;
+    request->Callback = std::move(callback);
+
+    std::lock_guard<std::mutex> guard(_lock);
+    _queue.push_back(request);
+    return request;
+}
+
+bool PathRequestQueue::UpdateRequest(PathRequestHandle const& request, G3D::Vector3 const& dest, bool forceDest, PathRequestCallback&& callback)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (request->Dropped)
+        return false;
+
+    request->Dest = dest;
+    request->ForceDest = forceDest;
+    request->Callback = std::move(callback);
+    return true;
+}
+
+void PathRequestQueue::Process()
+{
+    std::vector<std::weak_ptr<PathRequest>> queued;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        queued.swap(_queue);
+    }
+
+    if (queued.empty())
+        return;
+
+    PathRequestMetrics& metrics = GetPathRequestMetrics();
+    uint32 const budget = sWorld->getIntConfig(CONFIG_MAP_PATHFINDING_TICK_BUDGET);
+
+    // Strong references keep the requests alive until their results are copied
+    std::vector<PathRequestHandle> batch;
+    std::vector<PathRequest*> searches;
+    std::vector<std::weak_ptr<PathRequest>> deferred;
+    std::map<CoalesceKey, PathRequest const*> leaders;
+
+    for (std::weak_ptr<PathRequest> const& queuedRequest : queued)
+    {
+        // The requester dropped or replaced it, or its owner left the map since
+        PathRequestHandle request = queuedRequest.lock();
+        if (!request || !request->Owner->IsInWorld() || request->Owner->FindMap() != _map)
+        {
+            if (request)
+            {
+                std::lock_guard<std::mutex> guard(_lock);
+                request->Dropped = true;
+            }
+
+            metrics.Cancelled.Increment();
+            continue;
+        }
+
+        request->Owner->GetPosition(request->Start.x, request->Start.y, request->Start.z);
+
+        Optional<CoalesceKey> key;
+        if (request->Owner->IsCreature())
+        {
+            key = MakeCoalesceKey(*request);
+            auto leader = leaders.find(*key);
+            if (leader != leaders.end())
+            {
+                request->Leader = leader->second;
+                batch.push_back(std::move(request));
+                metrics.Coalesced.Increment();
+                continue;
+            }
+        }
+
+        if (budget && searches.size() >= budget)
+        {
+            deferred.push_back(queuedRequest);
+            metrics.Deferred.Increment();
+            continue;
+        }
+
+        if (key)
+            leaders.emplace(*key, request.get());
+
+        searches.push_back(request.get());
+        batch.push_back(std::move(request));
+    }
+
+    if (!deferred.empty())
+    {
+        // Requests queued meanwhile come after the ones that already waited
+        std::lock_guard<std::mutex> guard(_lock);
+        deferred.insert(deferred.end(), _queue.begin(), _queue.end());
+        _queue.swap(deferred);
+    }
+
+    auto const startTime = std::chrono::steady_clock::now();
+
+    for (PathRequest* request : searches)
+    {
+        request->Success = request->Path->CalculatePath(request->Start.x, request->Start.y, request->Start.z,
+            request->Dest.x, request->Dest.y, request->Dest.z, request->ForceDest);
+    }
+
+    metrics.BatchTime.Observe(std::chrono::steady_clock::now() - startTime);
+    metrics.BatchSize.Observe(double(searches.size()));
+    metrics.Computed.Increment(searches.size());
+
+    for (PathRequestHandle const& request : batch)
+    {
+        if (!request->Leader)
+            continue;
+
+        request->Path->CopyPathFrom(*request->Leader->Path);
+        request->Success = request->Leader->Success;
+    }
+
+    // A callback may drop the handle of a later request, which cancels that one as well
+    std::vector<std::weak_ptr<PathRequest>> finished(batch.begin(), batch.end());
+    batch.clear();
+
+    for (std::weak_ptr<PathRequest> const& finishedRequest : finished)
+    {
+        PathRequestHandle request = finishedRequest.lock();
+        if (!request)
+        {
+            metrics.Cancelled.Increment();
+            continue;
+        }
+
+        PathRequestCallback callback = std::move(request->Callback);
+        callback(std::move(request->Path), request->Success);
+    }
+}
@@ -0,0 +1,73 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_PATH_REQUEST_QUEUE_H
+#define ACORE_PATH_REQUEST_QUEUE_H
+
+#include "Define.h"
+#include <G3D/Vector3.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class Map;
+class PathGenerator;
+class Unit;
+
+struct PathRequest;
+
+// Receives the generator that was passed to Request() with the new path, success is the result of CalculatePath()
+typedef std::function<void(std::unique_ptr<PathGenerator> path, bool success)> PathRequestCallback;
+// Keeps a queued request alive, dropping or replacing it cancels the request
+typedef std::shared_ptr<PathRequest> PathRequestHandle;
+
+/**
+ * Path searches of one map that are run together once per map update instead of one by one.
+ *
+ * Movement generators queue a search and keep following their current spline. After the objects
+ * of the map were updated, Process() runs all queued searches on the map thread: a search reads
+ * terrain, vmaps and the dynamic tree of the map, which must not be used by several threads at once.
+ * The callbacks are then invoked in the order the requests were queued.
+ *
+ * Creatures of the same entry that search from about the same place to about the same destination,
+ * like a pack chasing one player, share a single search. With MapUpdate.Pathfinding.TickBudget set,
+ * searches beyond the budget wait for the next update.
+ */
+class PathRequestQueue
+{
+public:
+    explicit PathRequestQueue(Map* map) : _map(map) { }
+
+    // May be called from region update workers. path is reused if given, the search starts at the
+    // position owner has when the queue is processed
+    [[nodiscard]] PathRequestHandle Request(Unit* owner, std::unique_ptr<PathGenerator> path, G3D::Vector3 const& dest, bool forceDest, PathRequestCallback callback);
+
+    // Changes the destination and callback of a request that was not processed yet, so it keeps its
+    // place in the queue. Returns false if the request was dropped and has to be made again
+    bool UpdateRequest(PathRequestHandle const& request, G3D::Vector3 const& dest, bool forceDest, PathRequestCallback&& callback);
+
+    // Called by the map thread after all objects were updated
+    void Process();
+
+private:
+    Map* _map;
+    std::mutex _lock;
+    std::vector<std::weak_ptr<PathRequest>> _queue;
+};
+
+#endif
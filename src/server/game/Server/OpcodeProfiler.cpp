@@ -0,0 +1,203 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OpcodeProfiler.h"
+#include "Errors.h"
+#include "MetricRegistry.h"
+#include <algorithm>
+
+OpcodeProfiler::Scope::~Scope()
+{
+    sOpcodeProfiler->Record(_opcode, std::chrono::steady_clock::now() - _start, _bytes);
+}
+
+OpcodeProfiler* OpcodeProfiler::instance()
+{
+    static OpcodeProfiler instance;
+    return &instance;
+}
+
+OpcodeProfiler::ThreadDataHolder::~ThreadDataHolder()
+{
+    if (Data)
+        sOpcodeProfiler->RetireThread(*Data);
+}
+
+OpcodeProfiler::ThreadData& OpcodeProfiler::GetThreadData()
+{
+    // Allocated on the first packet, threads that never handle one do not pay for the slots
+    thread_local ThreadDataHolder holder;
+    if (!holder.Data)
+    {
+        holder.Data = std::make_unique<ThreadData>();
+        holder.Data->ResetCount = _resetCount.load();
+
+        std::lock_guard<std::mutex> lock(_lock);
+        _threads.push_back(holder.Data.get());
+    }
+
+    return *holder.Data;
+}
+
+void OpcodeProfiler::RetireThread(ThreadData const& data)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    std::erase(_threads, &data);
+
+    if (_retired.empty())
+    {
+        _retired.resize(NUM_OPCODE_HANDLERS);
+        _retiredMaxTimes.resize(NUM_OPCODE_HANDLERS);
+    }
+
+    bool const maxTimesValid = data.ResetCount.load(std::memory_order_acquire) == _resetCount.load();
+    for (std::size_t opcode = 0; opcode < NUM_OPCODE_HANDLERS; ++opcode)
+    {
+        Slot const& slot = data.Slots[opcode];
+        Totals& retired = _retired[opcode];
+        retired.Count += slot.Count.load(std::memory_order_relaxed);
+        retired.TotalTime += slot.TotalTime.load(std::memory_order_relaxed);
+        retired.Bytes += slot.Bytes.load(std::memory_order_relaxed);
+        for (std::size_t bucket = 0; bucket < LATENCY_BUCKETS; ++bucket)
+            retired.Latency[bucket] += slot.Latency[bucket].load(std::memory_order_relaxed);
+
+        if (maxTimesValid)
+            _retiredMaxTimes[opcode] = std::max(_retiredMaxTimes[opcode], slot.MaxTime.load(std::memory_order_relaxed));
+    }
+}
+
+void OpcodeProfiler::Record(OpcodeClient opcode, std::chrono::nanoseconds time, std::size_t bytes)
+{
+    if (opcode >= NUM_OPCODE_HANDLERS)
+        return;
+
+    ThreadData& data = GetThreadData();
+
+    // First packet of this thread after a reset, the maxima are the only values that are cleared
+    uint32 const resetCount = _resetCount.load(std::memory_order_relaxed);
+    if (data.ResetCount.load(std::memory_order_relaxed) != resetCount)
+    {
+        for (Slot& slot : data.Slots)
+            slot.MaxTime.store(0, std::memory_order_relaxed);
+
+        data.ResetCount.store(resetCount, std::memory_order_release);
+    }
+
+    // This thread is the only writer of its slots, the readers hold _lock and only load them
+    Slot& slot = data.Slots[opcode];
+    uint64 const nanoseconds = uint64(std::max<int64>(time.count(), 0));
+    slot.Count.store(slot.Count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    slot.TotalTime.store(slot.TotalTime.load(std::memory_order_relaxed) + nanoseconds, std::memory_order_relaxed);
+    slot.Bytes.store(slot.Bytes.load(std::memory_order_relaxed) + bytes, std::memory_order_relaxed);
+    if (nanoseconds > slot.MaxTime.load(std::memory_order_relaxed))
+        slot.MaxTime.store(nanoseconds, std::memory_order_relaxed);
+
+    std::vector<double> const& bounds = MetricHistogram::LatencyBounds();
+    std::size_t const bucket = std::lower_bound(bounds.begin(), bounds.end(), std::chrono::duration<double>(time).count()) - bounds.begin();
+    slot.Latency[bucket].store(slot.Latency[bucket].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+std::vector<OpcodeProfiler::Totals> OpcodeProfiler::GetLifetimeTotals() const
+{
+    std::vector<Totals> totals = _retired;
+    totals.resize(NUM_OPCODE_HANDLERS);
+    for (ThreadData const* data : _threads)
+    {
+        for (std::size_t opcode = 0; opcode < NUM_OPCODE_HANDLERS; ++opcode)
+        {
+            Slot const& slot = data->Slots[opcode];
+            totals[opcode].Count += slot.Count.load(std::memory_order_relaxed);
+            totals[opcode].TotalTime += slot.TotalTime.load(std::memory_order_relaxed);
+            totals[opcode].Bytes += slot.Bytes.load(std::memory_order_relaxed);
+            for (std::size_t bucket = 0; bucket < LATENCY_BUCKETS; ++bucket)
+                totals[opcode].Latency[bucket] += slot.Latency[bucket].load(std::memory_order_relaxed);
+        }
+    }
+
+    return totals;
+}
+
+std::vector<OpcodeProfiler::OpcodeStats> OpcodeProfiler::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    std::vector<Totals> totals = GetLifetimeTotals();
+
+    std::vector<uint64> maxTimes = _retiredMaxTimes;
+    maxTimes.resize(NUM_OPCODE_HANDLERS);
+    uint32 const resetCount = _resetCount.load();
+    for (ThreadData const* data : _threads)
+    {
+        // Threads that did not handle a packet since the reset still hold old maxima
+        if (data->ResetCount.load(std::memory_order_acquire) != resetCount)
+            continue;
+
+        for (std::size_t opcode = 0; opcode < NUM_OPCODE_HANDLERS; ++opcode)
+            maxTimes[opcode] = std::max(maxTimes[opcode], data->Slots[opcode].MaxTime.load(std::memory_order_relaxed));
+    }
+
+    std::vector<OpcodeStats> stats;
+    for (std::size_t opcode = 0; opcode < NUM_OPCODE_HANDLERS; ++opcode)
+    {
+        Totals const baseline = _baseline.empty() ? Totals() : _baseline[opcode];
+        if (totals[opcode].Count == baseline.Count)
+            continue;
+
+        OpcodeStats& entry = stats.emplace_back();
+        entry.Opcode = OpcodeClient(opcode);
+        entry.Count = totals[opcode].Count - baseline.Count;
+        entry.TotalTime = totals[opcode].TotalTime - baseline.TotalTime;
+        entry.MaxTime = maxTimes[opcode];
+        entry.Bytes = totals[opcode].Bytes - baseline.Bytes;
+    }
+
+    return stats;
+}
+
+void OpcodeProfiler::Reset()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _baseline = GetLifetimeTotals();
+    std::fill(_retiredMaxTimes.begin(), _retiredMaxTimes.end(), 0);
+    ++_resetCount;
+}
+
+void OpcodeProfiler::RegisterMetrics(MetricRegistry& registry)
+{
+    ASSERT(MetricHistogram::LatencyBounds().size() + 1 == LATENCY_BUCKETS);
+
+    registry.AddCollector([this](MetricRegistry& registry)
+    {
+        std::vector<Totals> totals;
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            totals = GetLifetimeTotals();
+        }
+
+        for (std::size_t opcode = 0; opcode < NUM_OPCODE_HANDLERS; ++opcode)
+        {
+            if (!totals[opcode].Count)
+                continue;
+
+            std::vector<MetricTag> labels = { { "opcode", opcodeTable[Opcodes(opcode)]->Name } };
+            registry.GetCounter("opcode_packets_total", "Client packets handled by opcode", labels).Set(totals[opcode].Count);
+            registry.GetCounter("opcode_handle_microseconds_total", "Time spent in client opcode handlers", labels).Set(totals[opcode].TotalTime / 1000);
+            registry.GetCounter("opcode_bytes_total", "Payload bytes of handled client packets", labels).Set(totals[opcode].Bytes);
+            registry.GetHistogram("opcode_handle_seconds", "Time spent handling one client packet", labels).Set(
+                std::vector<uint64>(totals[opcode].Latency.begin(), totals[opcode].Latency.end()), double(totals[opcode].TotalTime) / 1e9);
+        }
+    });
+}
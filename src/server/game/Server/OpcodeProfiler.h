@@ -0,0 +1,130 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _OPCODE_PROFILER_H
+#define _OPCODE_PROFILER_H
+
+#include "Define.h"
+#include "Duration.h"
+#include "Opcodes.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class MetricRegistry;
+
+/**
+    Always on accounting of the time and bytes spent in client opcode handlers.
+
+    Every thread that handles packets gets one slot per opcode on its first packet and is the only one
+    writing it. GetStats() and the metric collector sum the slots of all threads under _lock. When a
+    thread exits its slots are freed and their counts move to _retired. Counts, times and bytes only ever grow, Reset() records a baseline that
+    is subtracted from what GetStats() reports, so the exported metrics stay monotonic. Each slot also
+    counts its handling times in the buckets of MetricHistogram::LatencyBounds() for the exported
+    latency histogram.
+*/
+class AC_GAME_API OpcodeProfiler
+{
+public:
+    struct OpcodeStats
+    {
+        OpcodeClient Opcode;
+        uint64 Count = 0;
+        uint64 TotalTime = 0;   // nanoseconds
+        uint64 MaxTime = 0;     // nanoseconds, since the last reset
+        uint64 Bytes = 0;
+    };
+
+    /// Times the handling of one packet, records when it goes out of scope
+    class Scope
+    {
+    public:
+        Scope(OpcodeClient opcode, std::size_t bytes) : _opcode(opcode), _bytes(bytes), _start(std::chrono::steady_clock::now()) { }
+        ~Scope();
+
+        Scope(Scope const&) = delete;
+        Scope& operator=(Scope const&) = delete;
+
+    private:
+        OpcodeClient _opcode;
+        std::size_t _bytes;
+        TimePoint _start;
+    };
+
+    static OpcodeProfiler* instance();
+
+    void Record(OpcodeClient opcode, std::chrono::nanoseconds time, std::size_t bytes);
+
+    /// Opcodes handled since the last reset
+    [[nodiscard]] std::vector<OpcodeStats> GetStats() const;
+    void Reset();
+
+    /// Mirrors the lifetime totals into registry counters whenever the registry is rendered
+    void RegisterMetrics(MetricRegistry& registry);
+
+private:
+    // MetricHistogram::LatencyBounds() and +Inf
+    static constexpr std::size_t LATENCY_BUCKETS = 17;
+
+    struct Slot
+    {
+        std::atomic<uint64> Count{0};
+        std::atomic<uint64> TotalTime{0};
+        std::atomic<uint64> MaxTime{0};
+        std::atomic<uint64> Bytes{0};
+        std::array<std::atomic<uint64>, LATENCY_BUCKETS> Latency{};
+    };
+
+    struct ThreadData
+    {
+        std::array<Slot, NUM_OPCODE_HANDLERS> Slots;
+        std::atomic<uint32> ResetCount{0};      // MaxTime of the slots is only valid if it matches _resetCount
+    };
+
+    // Owned by a thread_local, unregisters the slots of the thread when it exits
+    struct ThreadDataHolder
+    {
+        ~ThreadDataHolder();
+
+        std::unique_ptr<ThreadData> Data;
+    };
+
+    struct Totals
+    {
+        uint64 Count = 0;
+        uint64 TotalTime = 0;
+        uint64 Bytes = 0;
+        std::array<uint64, LATENCY_BUCKETS> Latency{};
+    };
+
+    ThreadData& GetThreadData();
+    void RetireThread(ThreadData const& data);
+    std::vector<Totals> GetLifetimeTotals() const;
+
+    mutable std::mutex _lock;           // guards everything below, never taken by Record() once a thread is registered
+    std::vector<ThreadData const*> _threads;
+    std::vector<Totals> _retired;       // counts of threads that exited, empty until the first one does
+    std::vector<uint64> _retiredMaxTimes;   // maxima since the last reset of threads that exited
+    std::vector<Totals> _baseline;
+    std::atomic<uint32> _resetCount{0};
+};
+
+#define sOpcodeProfiler OpcodeProfiler::instance()
+
+#endif
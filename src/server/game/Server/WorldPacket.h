@@ -21,6 +21,7 @@
 #include "ByteBuffer.h"
 #include "Duration.h"
 #include "Opcodes.h"
+#include <memory>
 
 class WorldPacket : public ByteBuffer
 {
@@ -82,4 +83,12 @@ protected:
     TimePoint m_receivedTime; // only set for a specific set of opcodes, for performance reasons.
 };
 
+// Immutable packet broadcast to many sessions, every socket queues a reference to the same payload
+typedef std::shared_ptr<WorldPacket const> SharedWorldPacket;
+
+inline SharedWorldPacket MakeSharedWorldPacket(WorldPacket const& packet)
+{
+    return std::make_shared<WorldPacket const>(packet);
+}
+
 #endif
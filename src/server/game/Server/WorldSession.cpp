@@ -36,6 +36,7 @@
 #include "Metric.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
+#include "OpcodeProfiler.h"
 #include "Opcodes.h"
 #include "OutdoorPvPMgr.h"
 #include "PacketUtilities.h"
@@ -311,6 +312,26 @@ void WorldSession::SendPacket(WorldPacket const* packet)
     m_Socket->SendPacket(*packet);
 }
 
+/// Send a packet whose payload is shared with other sessions (broadcasts)
+void WorldSession::SendPacket(SharedWorldPacket const& packet)
+{
+    if (packet->GetOpcode() == NULL_OPCODE)
+    {
+        LOG_ERROR("network.opcode", "{} send NULL_OPCODE", GetPlayerInfo());
+        return;
+    }
+
+    sScriptMgr->OnPlayerbotPacketSent(GetPlayer(), packet.get());
+
+    if (!m_Socket)
+        return;
+
+    if (!sScriptMgr->CanPacketSend(this, *packet))
+        return;
+
+    m_Socket->SendPacket(packet);
+}
+
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
@@ -389,6 +410,8 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
         if (evaluationPolicy == WorldSession::DosProtection::Policy::Process
             || evaluationPolicy == WorldSession::DosProtection::Policy::Log)
         {
+            OpcodeProfiler::Scope profileScope(opcode, packet->size());
+
             try
             {
                 switch (opHandle->Status)
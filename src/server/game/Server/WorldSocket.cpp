@@ -117,7 +117,8 @@ void EncryptableAndCompressiblePacket::CompressIfNeeded()
 }
 
 WorldSocket::WorldSocket(tcp::socket&& socket)
-    : Socket(std::move(socket)), _OverSpeedPings(0), _worldSession(nullptr), _authed(false), _sendBufferSize(4096), _loggingPackets(false)
+    : Socket(std::move(socket)), _OverSpeedPings(0), _worldSession(nullptr), _authed(false), _sendBufferSize(4096),
+    _scatterGatherSend(false), _gatherQueueOffset(0), _loggingPackets(false)
 {
     Acore::Crypto::GetRandomBytes(_authSeed);
     _headerBuffer.Resize(sizeof(ClientPktHeader));
@@ -164,7 +165,25 @@ void WorldSocket::CheckIpCallback(PreparedQueryResult result)
 bool WorldSocket::Update()
 {
     EncryptableAndCompressiblePacket* queued;
-    if (_bufferQueue.Dequeue(queued))
+    if (_scatterGatherSend)
+    {
+        bool queuedAny = false;
+        while (_bufferQueue.Dequeue(queued))
+        {
+            queued->CompressIfNeeded();
+            ServerPktHeader header(queued->GetPayload().size() + 2, queued->GetOpcode());
+            if (queued->NeedsEncryption())
+                _authCrypt.EncryptSend(header.header, header.getHeaderLength());
+
+            queued->SetHeader(header.header, header.getHeaderLength());
+            _gatherQueue.emplace_back(queued);
+            queuedAny = true;
+        }
+
+        if (queuedAny)
+            GatherDataQueued();
+    }
+    else if (_bufferQueue.Dequeue(queued))
     {
         // Allocate buffer only when it's needed but not on every Update() call.
         MessageBuffer buffer(_sendBufferSize);
@@ -172,11 +191,12 @@ bool WorldSocket::Update()
         do
         {
             queued->CompressIfNeeded();
-            ServerPktHeader header(queued->size() + 2, queued->GetOpcode());
+            ByteBuffer const& payload = queued->GetPayload();
+            ServerPktHeader header(payload.size() + 2, queued->GetOpcode());
             if (queued->NeedsEncryption())
                 _authCrypt.EncryptSend(header.header, header.getHeaderLength());
 
-            currentPacketSize = queued->size() + header.getHeaderLength();
+            currentPacketSize = payload.size() + header.getHeaderLength();
 
             if (buffer.GetRemainingSpace() < currentPacketSize)
             {
@@ -187,8 +207,8 @@ bool WorldSocket::Update()
             if (buffer.GetRemainingSpace() >= currentPacketSize)
             {
                 buffer.Write(header.header, header.getHeaderLength());
-                if (!queued->empty())
-                    buffer.Write(queued->contents(), queued->size());
+                if (!payload.empty())
+                    buffer.Write(payload.contents(), payload.size());
             }
             else    // Single packet larger than current buffer size
             {
@@ -200,8 +220,8 @@ bool WorldSocket::Update()
                     _sendBufferSize = currentPacketSize;
 
                 buffer.Write(header.header, header.getHeaderLength());
-                if (!queued->empty())
-                    buffer.Write(queued->contents(), queued->size());
+                if (!payload.empty())
+                    buffer.Write(payload.contents(), payload.size());
             }
 
             delete queued;
@@ -219,6 +239,45 @@ bool WorldSocket::Update()
     return true;
 }
 
+void WorldSocket::FillGatherBuffers(std::vector<boost::asio::const_buffer>& buffers)
+{
+    std::size_t skip = _gatherQueueOffset;
+    for (std::unique_ptr<EncryptableAndCompressiblePacket> const& packet : _gatherQueue)
+    {
+        if (buffers.size() + 2 > GATHER_WRITE_MAX_BUFFERS)
+            break;
+
+        if (skip < packet->GetHeaderLength())
+        {
+            buffers.emplace_back(packet->GetHeader() + skip, packet->GetHeaderLength() - skip);
+            skip = 0;
+        }
+        else
+            skip -= packet->GetHeaderLength();
+
+        ByteBuffer const& payload = packet->GetPayload();
+        if (!payload.empty())
+            buffers.emplace_back(payload.contents() + skip, payload.size() - skip);
+
+        skip = 0;
+    }
+}
+
+void WorldSocket::GatherWriteCompleted(std::size_t transferredBytes)
+{
+    _gatherQueueOffset += transferredBytes;
+    while (!_gatherQueue.empty())
+    {
+        EncryptableAndCompressiblePacket const* packet = _gatherQueue.front().get();
+        std::size_t packetSize = packet->GetHeaderLength() + packet->GetPayload().size();
+        if (_gatherQueueOffset < packetSize)
+            break;
+
+        _gatherQueueOffset -= packetSize;
+        _gatherQueue.pop_front();
+    }
+}
+
 void WorldSocket::HandleSendAuthSession()
 {
     WorldPacket packet(SMSG_AUTH_CHALLENGE, 40);
@@ -526,6 +585,24 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
     _bufferQueue.Enqueue(new EncryptableAndCompressiblePacket(packet, _authCrypt.IsInitialized()));
 }
 
+void WorldSocket::SendPacket(SharedWorldPacket const& packet)
+{
+    if (!IsOpen())
+        return;
+
+    if (sPacketLog->CanLogPacket() && IsLoggingPackets())
+        sPacketLog->LogPacket(*packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
+
+    // Update objects are compressed in place per session, they cannot share the payload
+    if (packet->GetOpcode() == SMSG_UPDATE_OBJECT)
+    {
+        _bufferQueue.Enqueue(new EncryptableAndCompressiblePacket(*packet, _authCrypt.IsInitialized()));
+        return;
+    }
+
+    _bufferQueue.Enqueue(new EncryptableAndCompressiblePacket(packet, _authCrypt.IsInitialized()));
+}
+
 void WorldSocket::HandleAuthSession(WorldPacket & recvPacket)
 {
     std::shared_ptr<AuthSession> authSession = std::make_shared<AuthSession>();
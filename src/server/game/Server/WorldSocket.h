@@ -26,6 +26,7 @@
 #include "WorldPacket.h"
 #include "WorldSession.h"
 #include <boost/asio/ip/tcp.hpp>
+#include <deque>
 
 using boost::asio::ip::tcp;
 
@@ -37,15 +38,32 @@ public:
         SocketQueueLink.store(nullptr, std::memory_order_relaxed);
     }
 
+    // Only references the payload, just the header is built and encrypted per session
+    EncryptableAndCompressiblePacket(SharedWorldPacket packet, bool encrypt) : WorldPacket(packet->GetOpcode(), 0),
+        _shared(std::move(packet)), _encrypt(encrypt)
+    {
+        SocketQueueLink.store(nullptr, std::memory_order_relaxed);
+    }
+
     bool NeedsEncryption() const { return _encrypt; }
 
-    bool NeedsCompression() const { return GetOpcode() == SMSG_UPDATE_OBJECT && size() > 100; }
+    bool NeedsCompression() const { return !_shared && GetOpcode() == SMSG_UPDATE_OBJECT && size() > 100; }
 
     void CompressIfNeeded();
 
+    ByteBuffer const& GetPayload() const { return _shared ? static_cast<ByteBuffer const&>(*_shared) : *this; }
+
+    // Encrypted header, kept with the packet while it waits in the scatter-gather send queue
+    void SetHeader(uint8 const* header, uint8 length) { std::copy_n(header, length, _header.begin()); _headerLength = length; }
+    uint8 const* GetHeader() const { return _header.data(); }
+    uint8 GetHeaderLength() const { return _headerLength; }
+
     std::atomic<EncryptableAndCompressiblePacket*> SocketQueueLink;
 
 private:
+    SharedWorldPacket _shared;
+    std::array<uint8, 5> _header{};
+    uint8 _headerLength{0};
     bool _encrypt;
 };
 
@@ -82,8 +100,10 @@ public:
     bool Update() override;
 
     void SendPacket(WorldPacket const& packet);
+    void SendPacket(SharedWorldPacket const& packet);
 
     void SetSendBufferSize(std::size_t sendBufferSize) { _sendBufferSize = sendBufferSize; }
+    void SetScatterGatherSend(bool enable) { _scatterGatherSend = enable; }
 
     bool IsLoggingPackets() const { return _loggingPackets; }
     void SetPacketLogging(bool state) { _loggingPackets = state; }
@@ -93,6 +113,10 @@ protected:
     void ReadHandler() override;
     bool ReadHeaderHandler();
 
+    bool HasGatherData() const override { return !_gatherQueue.empty(); }
+    void FillGatherBuffers(std::vector<boost::asio::const_buffer>& buffers) override;
+    void GatherWriteCompleted(std::size_t transferredBytes) override;
+
     enum class ReadDataHandlerResult
     {
         Ok = 0,
@@ -134,6 +158,11 @@ private:
     MPSCQueue<EncryptableAndCompressiblePacket, &EncryptableAndCompressiblePacket::SocketQueueLink> _bufferQueue;
     std::size_t _sendBufferSize;
 
+    // Packets handed to the kernel in place instead of being copied into _sendBufferSize chunks
+    bool _scatterGatherSend;
+    std::deque<std::unique_ptr<EncryptableAndCompressiblePacket>> _gatherQueue;
+    std::size_t _gatherQueueOffset; // bytes of the front packet already sent
+
     QueryCallbackProcessor _queryProcessor;
     std::string _ipCountry;
 
@@ -28,6 +28,7 @@ public:
     void SocketAdded(std::shared_ptr<WorldSocket> sock) override
     {
         sock->SetSendBufferSize(sWorldSocketMgr.GetApplicationSendBufferSize());
+        sock->SetScatterGatherSend(sWorldSocketMgr.IsScatterGatherSendEnabled());
         sScriptMgr->OnSocketOpen(sock);
     }
 
@@ -38,7 +39,8 @@ public:
 };
 
 WorldSocketMgr::WorldSocketMgr() :
-    BaseSocketMgr(), _socketSystemSendBufferSize(-1), _socketApplicationSendBufferSize(4096), _tcpNoDelay(true)
+    BaseSocketMgr(), _socketSystemSendBufferSize(-1), _socketApplicationSendBufferSize(4096), _tcpNoDelay(true),
+    _scatterGatherSend(false)
 {
 }
 
@@ -58,6 +60,7 @@ bool WorldSocketMgr::StartWorldNetwork(Acore::Asio::IoContext& ioContext, std::s
     // -1 means use default
     _socketSystemSendBufferSize = sConfigMgr->GetOption<int32>("Network.OutKBuff", -1);
     _socketApplicationSendBufferSize = sConfigMgr->GetOption<int32>("Network.OutUBuff", 4096);
+    _scatterGatherSend = sConfigMgr->GetOption<bool>("Network.ScatterGatherSend", false);
 
     if (_socketApplicationSendBufferSize <= 0)
     {
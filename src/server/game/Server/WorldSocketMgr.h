@@ -44,6 +44,7 @@ public:
     void OnSocketOpen(tcp::socket&& sock, uint32 threadIndex) override;
 
     std::size_t GetApplicationSendBufferSize() const { return _socketApplicationSendBufferSize; }
+    bool IsScatterGatherSendEnabled() const { return _scatterGatherSend; }
 
 protected:
     WorldSocketMgr();
@@ -59,6 +60,7 @@ private:
     int32 _socketSystemSendBufferSize;
     int32 _socketApplicationSendBufferSize;
     bool _tcpNoDelay;
+    bool _scatterGatherSend;
 };
 
 #define sWorldSocketMgr WorldSocketMgr::Instance()
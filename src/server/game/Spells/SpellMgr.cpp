@@ -2158,11 +2158,8 @@ void SpellMgr::LoadSpellBonuses()
     }
 
     uint32 count = 0;
-    do
+    for (auto [entry, directBonus, dotBonus, apBonus, apDotBonus] : result->Rows<uint32, float, float, float, float>())
     {
-        Field* fields = result->Fetch();
-        uint32 entry = fields[0].Get<uint32>();
-
         SpellInfo const* spell = GetSpellInfo(entry);
         if (!spell)
         {
@@ -2171,13 +2168,13 @@ void SpellMgr::LoadSpellBonuses()
         }
 
         SpellBonusEntry& sbe = mSpellBonusMap[entry];
-        sbe.direct_damage = fields[1].Get<float>();
-        sbe.dot_damage    = fields[2].Get<float>();
-        sbe.ap_bonus      = fields[3].Get<float>();
-        sbe.ap_dot_bonus   = fields[4].Get<float>();
+        sbe.direct_damage = directBonus;
+        sbe.dot_damage    = dotBonus;
+        sbe.ap_bonus      = apBonus;
+        sbe.ap_dot_bonus  = apDotBonus;
 
         ++count;
-    } while (result->NextRow());
+    }
 
     LOG_INFO("server.loading", ">> Loaded {} Extra Spell Bonus Data in {} ms", count, GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server.loading", " ");
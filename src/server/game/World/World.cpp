@@ -79,6 +79,7 @@
 #include "SkillExtraItems.h"
 #include "SmartAI.h"
 #include "SpellMgr.h"
+#include "TaskGraph.h"
 #include "TaskScheduler.h"
 #include "TicketMgr.h"
 #include "Transport.h"
@@ -452,76 +453,68 @@ void World::SetInitialWorldSettings()
     LOG_INFO("server.loading", "Loading Instances...");
     sInstanceSaveMgr->LoadInstances();
 
-    LOG_INFO("server.loading", "Loading Broadcast Texts...");
-    sObjectMgr->LoadBroadcastTexts();
-    sObjectMgr->LoadBroadcastTextLocales();
-
-    LOG_INFO("server.loading", "Loading Localization Strings...");
-    uint32 oldMSTime = getMSTime();
-    sObjectMgr->LoadCreatureLocales();
-    sObjectMgr->LoadGameObjectLocales();
-    sObjectMgr->LoadItemLocales();
-    sObjectMgr->LoadItemSetNameLocales();
-    sObjectMgr->LoadQuestLocales();
-    sObjectMgr->LoadQuestOfferRewardLocale();
-    sObjectMgr->LoadQuestRequestItemsLocale();
-    sObjectMgr->LoadNpcTextLocales();
-    sObjectMgr->LoadPageTextLocales();
-    sObjectMgr->LoadGossipMenuItemsLocales();
-    sObjectMgr->LoadPointOfInterestLocales();
-    sObjectMgr->LoadPetNamesLocales();
-
-    sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
-    LOG_INFO("server.loading", ">> Localization Strings loaded in {} ms", GetMSTimeDiffToNow(oldMSTime));
-    LOG_INFO("server.loading", " ");
-
-    LOG_INFO("server.loading", "Loading Page Texts...");
-    sObjectMgr->LoadPageTexts();
-
-    LOG_INFO("server.loading", "Loading Game Object Templates...");         // must be after LoadPageTexts
-    sObjectMgr->LoadGameObjectTemplate();
-
-    LOG_INFO("server.loading", "Loading Game Object Template Addons...");
-    sObjectMgr->LoadGameObjectTemplateAddons();
-
-    LOG_INFO("server.loading", "Loading Transport Templates...");
-    sTransportMgr->LoadTransportTemplates();
-
-    LOG_INFO("server.loading", "Loading Spell Required Data...");
-    sSpellMgr->LoadSpellRequired();
-
-    LOG_INFO("server.loading", "Loading Spell Group Types...");
-    sSpellMgr->LoadSpellGroups();
-
-    LOG_INFO("server.loading", "Loading Spell Learn Skills...");
-    sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
-
-    LOG_INFO("server.loading", "Loading Spell Proc Event Conditions...");
-    sSpellMgr->LoadSpellProcEvents();
-
-    LOG_INFO("server.loading", "Loading Spell Proc Conditions and Data...");
-    sSpellMgr->LoadSpellProcs();
-
-    LOG_INFO("server.loading", "Loading Spell Bonus Data...");
-    sSpellMgr->LoadSpellBonuses();
-
-    LOG_INFO("server.loading", "Loading Aggro Spells Definitions...");
-    sSpellMgr->LoadSpellThreats();
-
-    LOG_INFO("server.loading", "Loading Mixology Bonuses...");
-    sSpellMgr->LoadSpellMixology();
-
-    LOG_INFO("server.loading", "Loading Spell Group Stack Rules...");
-    sSpellMgr->LoadSpellGroupStackRules();
+    ///- Independent tables are loaded through a dependency graph, concurrently with StartupLoad.Threads > 1
+    Acore::TaskGraph loaders;
+    auto addLoader = [&loaders](std::string name, std::function<void()> loader, std::initializer_list<Acore::TaskGraph::TaskId> dependencies = {})
+    {
+        return loaders.Add(name, [name, loader = std::move(loader)]()
+        {
+            LOG_INFO("server.loading", "Loading {}...", name);
+            loader();
+        }, dependencies);
+    };
 
-    LOG_INFO("server.loading", "Loading NPC Texts...");
-    sObjectMgr->LoadGossipText();
+    auto broadcastTexts = addLoader("Broadcast Texts", [] { sObjectMgr->LoadBroadcastTexts(); });
+    addLoader("Broadcast Text Locales", [] { sObjectMgr->LoadBroadcastTextLocales(); }, { broadcastTexts });
+
+    addLoader("Creature Locales", [] { sObjectMgr->LoadCreatureLocales(); });
+    addLoader("GameObject Locales", [] { sObjectMgr->LoadGameObjectLocales(); });
+    addLoader("Item Locales", [] { sObjectMgr->LoadItemLocales(); });
+    addLoader("Item Set Name Locales", [] { sObjectMgr->LoadItemSetNameLocales(); });
+    addLoader("Quest Locales", [] { sObjectMgr->LoadQuestLocales(); });
+    addLoader("Quest Offer Reward Locales", [] { sObjectMgr->LoadQuestOfferRewardLocale(); });
+    addLoader("Quest Request Items Locales", [] { sObjectMgr->LoadQuestRequestItemsLocale(); });
+    addLoader("NPC Text Locales", [] { sObjectMgr->LoadNpcTextLocales(); });
+    addLoader("Page Text Locales", [] { sObjectMgr->LoadPageTextLocales(); });
+    addLoader("Gossip Menu Items Locales", [] { sObjectMgr->LoadGossipMenuItemsLocales(); });
+    addLoader("Points Of Interest Locales", [] { sObjectMgr->LoadPointOfInterestLocales(); });
+    addLoader("Pet Name Locales", [] { sObjectMgr->LoadPetNamesLocales(); });
+
+    auto pageTexts = addLoader("Page Texts", [] { sObjectMgr->LoadPageTexts(); });
+    auto gameObjectTemplates = addLoader("Game Object Templates", [] { sObjectMgr->LoadGameObjectTemplate(); }, { pageTexts });
+    addLoader("Game Object Template Addons", [] { sObjectMgr->LoadGameObjectTemplateAddons(); }, { gameObjectTemplates });
+    addLoader("Transport Templates", [] { sTransportMgr->LoadTransportTemplates(); }, { gameObjectTemplates });
+
+    // Spell tables only read the SpellInfo store (and spell ranks) loaded above
+    addLoader("Spell Required Data", [] { sSpellMgr->LoadSpellRequired(); });
+    auto spellGroups = addLoader("Spell Group Types", [] { sSpellMgr->LoadSpellGroups(); });
+    addLoader("Spell Learn Skills", [] { sSpellMgr->LoadSpellLearnSkills(); });
+    addLoader("Spell Proc Event Conditions", [] { sSpellMgr->LoadSpellProcEvents(); });
+    addLoader("Spell Proc Conditions and Data", [] { sSpellMgr->LoadSpellProcs(); });
+    addLoader("Spell Bonus Data", [] { sSpellMgr->LoadSpellBonuses(); });
+    addLoader("Aggro Spells Definitions", [] { sSpellMgr->LoadSpellThreats(); });
+    addLoader("Mixology Bonuses", [] { sSpellMgr->LoadSpellMixology(); });
+    addLoader("Spell Group Stack Rules", [] { sSpellMgr->LoadSpellGroupStackRules(); }, { spellGroups });
+
+    addLoader("NPC Texts", [] { sObjectMgr->LoadGossipText(); }, { broadcastTexts });
+    addLoader("Enchant Spells Proc Datas", [] { sSpellMgr->LoadSpellEnchantProcData(); });
+    addLoader("Item Random Enchantments Table", [] { LoadRandomEnchantmentsTable(); });
+
+    loaders.Run(getIntConfig(CONFIG_STARTUP_LOAD_THREADS));
+
+    for (Acore::TaskGraph::TaskTiming const& timing : loaders.GetTimings())
+    {
+        if (timing.CriticalPath)
+            LOG_INFO("server.loading", ">> {} loaded in {} ms (critical path, started after {} ms)", timing.Name, timing.Duration.count() / 1000, timing.Start.count() / 1000);
+        else
+            LOG_DEBUG("server.loading", ">> {} loaded in {} ms (started after {} ms)", timing.Name, timing.Duration.count() / 1000, timing.Start.count() / 1000);
+    }
 
-    LOG_INFO("server.loading", "Loading Enchant Spells Proc Datas...");
-    sSpellMgr->LoadSpellEnchantProcData();
+    LOG_INFO("server.loading", ">> Loaded {} independent tables in {} ms, critical path {} ms", loaders.GetTimings().size(),
+        loaders.GetTotalTime().count() / 1000, loaders.GetCriticalPathTime().count() / 1000);
+    LOG_INFO("server.loading", " ");
 
-    LOG_INFO("server.loading", "Loading Item Random Enchantments Table...");
-    LoadRandomEnchantmentsTable();
+    sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
 
     LOG_INFO("server.loading", "Loading Disables");
     sDisableMgr->LoadDisables();                                  // must be before loading quests and items
@@ -1090,6 +1083,8 @@ void World::DetectDBCLang()
 void World::Update(uint32 diff)
 {
     METRIC_TIMER("world_update_time_total");
+    [[maybe_unused]] static MetricHistogram& updateTimeHistogram = sMetric->GetRegistry().GetHistogram("world_update_seconds", "Time spent in one world update");
+    METRIC_HISTOGRAM_TIMER(updateTimeHistogram);
 
     ///- Update the game time and check for shutdown time
     _UpdateGameTime();
@@ -1215,6 +1210,13 @@ void World::Update(uint32 diff)
         sMapMgr->Update(diff);
     }
 
+    if (MapUpdater* mapUpdater = sMapMgr->GetMapUpdater(); mapUpdater->activated())
+    {
+        // Time the map update workers spent idle waiting for the slowest map of this tick
+        METRIC_VALUE("map_update_straggler_time", std::chrono::nanoseconds(std::chrono::microseconds(mapUpdater->GetLastStragglerTime())));
+        METRIC_VALUE("map_update_batch_time", std::chrono::nanoseconds(std::chrono::microseconds(mapUpdater->GetLastBatchTime())));
+    }
+
     if (getBoolConfig(CONFIG_AUTOBROADCAST))
     {
         if (_timers[WUPDATE_AUTOBROADCAST].Passed())
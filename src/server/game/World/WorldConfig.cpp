@@ -541,6 +541,13 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<bool>(CONFIG_SHOW_MUTE_IN_WORLD, "ShowMuteInWorld", false);
     SetConfigValue<bool>(CONFIG_SHOW_BAN_IN_WORLD, "ShowBanInWorld", false);
     SetConfigValue<uint32>(CONFIG_NUMTHREADS, "MapUpdate.Threads", 1);
+    SetConfigValue<bool>(CONFIG_MAP_PARTITION_ENABLE, "MapUpdate.Partition.Enable", false);
+    SetConfigValue<uint32>(CONFIG_MAP_PARTITION_REGION_GRIDS, "MapUpdate.Partition.RegionGrids", 4, ConfigValueCache::Reloadable::No, [](uint32 const& value) { return value >= 1 && value <= MAX_NUMBER_OF_GRIDS / 2; }, ">= 1 and <= 32");
+    SetConfigValue<uint32>(CONFIG_GRID_PRELOAD_THREADS, "MapUpdate.GridPreload.Threads", 0, ConfigValueCache::Reloadable::No);
+    SetConfigValue<uint32>(CONFIG_GRID_PRELOAD_LOOKAHEAD, "MapUpdate.GridPreload.Lookahead", 10);
+    SetConfigValue<bool>(CONFIG_MAP_ASYNC_PATHFINDING, "MapUpdate.Pathfinding.Async", false);
+    SetConfigValue<uint32>(CONFIG_MAP_PATHFINDING_TICK_BUDGET, "MapUpdate.Pathfinding.TickBudget", 0);
+    SetConfigValue<uint32>(CONFIG_STARTUP_LOAD_THREADS, "StartupLoad.Threads", 1, ConfigValueCache::Reloadable::No, [](uint32 const& value) { return value >= 1; }, ">= 1");
     SetConfigValue<uint32>(CONFIG_MAX_RESULTS_LOOKUP_COMMANDS, "Command.LookupMaxResults", 0);
 
     // Warden
@@ -115,6 +115,8 @@ enum ServerConfigs
     CONFIG_CLOSE_IDLE_CONNECTIONS,
     CONFIG_LFG_LOCATION_ALL,
     CONFIG_PRELOAD_ALL_NON_INSTANCED_MAP_GRIDS,
+    CONFIG_MAP_PARTITION_ENABLE,
+    CONFIG_MAP_ASYNC_PATHFINDING,
     CONFIG_ALLOW_TWO_SIDE_INTERACTION_EMOTE,
     CONFIG_ITEMDELETE_METHOD,
     CONFIG_ITEMDELETE_VENDOR,
@@ -296,6 +298,11 @@ enum ServerConfigs
     CONFIG_PVP_TOKEN_COUNT,
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_NUMTHREADS,
+    CONFIG_MAP_PARTITION_REGION_GRIDS,
+    CONFIG_GRID_PRELOAD_THREADS,
+    CONFIG_GRID_PRELOAD_LOOKAHEAD,
+    CONFIG_MAP_PATHFINDING_TICK_BUDGET,
+    CONFIG_STARTUP_LOAD_THREADS,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_TELEPORT_TIMEOUT_NEAR,
@@ -28,6 +28,7 @@
 #include "M2Stores.h"
 #include "MapMgr.h"
 #include "ObjectMgr.h"
+#include "OpcodeProfiler.h"
 #include "PoolMgr.h"
 #include "ScriptMgr.h"
 #include "Transport.h"
@@ -66,6 +67,11 @@ public:
             { "setphaseshift",  HandleDebugSendSetPhaseShiftCommand,   SEC_ADMINISTRATOR, Console::No },
             { "spellfail",      HandleDebugSendSpellFailCommand,       SEC_ADMINISTRATOR, Console::No }
         };
+        static ChatCommandTable debugOpcodesCommandTable =
+        {
+            { "reset",          HandleDebugOpcodesResetCommand,        SEC_ADMINISTRATOR, Console::Yes},
+            { "",               HandleDebugOpcodesCommand,             SEC_ADMINISTRATOR, Console::Yes}
+        };
         static ChatCommandTable debugCommandTable =
         {
             { "setbit",         HandleDebugSet32BitCommand,            SEC_ADMINISTRATOR, Console::No },
@@ -97,6 +103,7 @@ public:
             { "moveflags",      HandleDebugMoveflagsCommand,           SEC_ADMINISTRATOR, Console::No },
             { "unitstate",      HandleDebugUnitStateCommand,           SEC_ADMINISTRATOR, Console::No },
             { "objectcount",    HandleDebugObjectCountCommand,         SEC_ADMINISTRATOR, Console::Yes},
+            { "opcodes",        debugOpcodesCommandTable },
             { "dummy",          HandleDebugDummyCommand,               SEC_ADMINISTRATOR, Console::No },
             { "mapdata",        HandleDebugMapDataCommand,             SEC_ADMINISTRATOR, Console::No },
             { "boundary",       HandleDebugBoundaryCommand,            SEC_ADMINISTRATOR, Console::No },
@@ -1460,6 +1467,54 @@ public:
         handler->PSendSysMessage("Player count in zone {} ({}): {}.", zoneId, (zoneEntry ? zoneEntry->area_name[LOCALE_enUS] : "<unknown>"), player->GetMap()->GetPlayerCountInZone(zoneId));
         return true;
     }
+
+    static bool HandleDebugOpcodesCommand(ChatHandler* handler, Optional<uint32> count, Optional<std::string_view> sortBy)
+    {
+        std::vector<OpcodeProfiler::OpcodeStats> stats = sOpcodeProfiler->GetStats();
+        std::string_view order = sortBy.value_or("total");
+
+        std::function<uint64(OpcodeProfiler::OpcodeStats const&)> key;
+        if (order == "total")
+            key = [](OpcodeProfiler::OpcodeStats const& entry) { return entry.TotalTime; };
+        else if (order == "max")
+            key = [](OpcodeProfiler::OpcodeStats const& entry) { return entry.MaxTime; };
+        else if (order == "avg")
+            key = [](OpcodeProfiler::OpcodeStats const& entry) { return entry.TotalTime / entry.Count; };
+        else if (order == "count")
+            key = [](OpcodeProfiler::OpcodeStats const& entry) { return entry.Count; };
+        else if (order == "bytes")
+            key = [](OpcodeProfiler::OpcodeStats const& entry) { return entry.Bytes; };
+        else
+        {
+            handler->SendErrorMessage("Unknown order '{}', use total, max, avg, count or bytes.", order);
+            return false;
+        }
+
+        std::sort(stats.begin(), stats.end(), [&](OpcodeProfiler::OpcodeStats const& left, OpcodeProfiler::OpcodeStats const& right)
+        {
+            return key(left) > key(right);
+        });
+
+        if (stats.size() > count.value_or(10))
+            stats.resize(count.value_or(10));
+
+        handler->PSendSysMessage("Client opcode handlers since the last reset, by {}:", order);
+        for (OpcodeProfiler::OpcodeStats const& entry : stats)
+        {
+            handler->PSendSysMessage("{}: {} packets, total {:.3f} ms, avg {} us, max {} us, {} bytes",
+                opcodeTable[Opcodes(entry.Opcode)]->Name, entry.Count, entry.TotalTime / 1000000.0,
+                entry.TotalTime / entry.Count / 1000, entry.MaxTime / 1000, entry.Bytes);
+        }
+
+        return true;
+    }
+
+    static bool HandleDebugOpcodesResetCommand(ChatHandler* handler)
+    {
+        sOpcodeProfiler->Reset();
+        handler->SendSysMessage("Opcode handler statistics reset.");
+        return true;
+    }
 };
 
 void AddSC_debug_commandscript()
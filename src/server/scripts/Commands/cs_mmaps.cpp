@@ -175,13 +175,15 @@ public:
 
         // calculate navmesh tile location
         dtNavMesh const* navmesh = MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMesh(handler->GetSession()->GetPlayer()->GetMapId());
-        dtNavMeshQuery const* navmeshquery = MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMeshQuery(handler->GetSession()->GetPlayer()->GetMapId(), player->GetInstanceId());
+        dtNavMeshQuery const* navmeshquery = MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMeshQuery(handler->GetSession()->GetPlayer()->GetMapId());
         if (!navmesh || !navmeshquery)
         {
             handler->PSendSysMessage("NavMesh not loaded for current map.");
             return true;
         }
 
+        auto navMeshLock = MMAP::MMapFactory::createOrGetMMapMgr()->LockNavMesh(handler->GetSession()->GetPlayer()->GetMapId());
+
         float const* min = navmesh->getParams()->orig;
         float x, y, z;
         player->GetPosition(x, y, z);
@@ -227,13 +229,15 @@ public:
     {
         uint32 mapid = handler->GetSession()->GetPlayer()->GetMapId();
         dtNavMesh const* navmesh = MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMesh(mapid);
-        dtNavMeshQuery const* navmeshquery = MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMeshQuery(mapid, handler->GetSession()->GetPlayer()->GetInstanceId());
+        dtNavMeshQuery const* navmeshquery = MMAP::MMapFactory::createOrGetMMapMgr()->GetNavMeshQuery(mapid);
         if (!navmesh || !navmeshquery)
         {
             handler->PSendSysMessage("NavMesh not loaded for current map.");
             return true;
         }
 
+        auto navMeshLock = MMAP::MMapFactory::createOrGetMMapMgr()->LockNavMesh(mapid);
+
         handler->PSendSysMessage("mmap loadedtiles:");
 
         for (int32 i = 0; i < navmesh->getMaxTiles(); ++i)
@@ -262,6 +266,8 @@ public:
             return true;
         }
 
+        auto navMeshLock = manager->LockNavMesh(handler->GetSession()->GetPlayer()->GetMapId());
+
         uint32 tileCount = 0;
         uint32 nodeCount = 0;
         uint32 polyCount = 0;
@@ -27,10 +27,13 @@
 #include <memory>
 #include <queue>
 #include <type_traits>
+#include <vector>
 
 using boost::asio::ip::tcp;
 
 #define READ_BLOCK_SIZE 4096
+// Asio writes at most 64 buffers of a sequence in one call
+#define GATHER_WRITE_MAX_BUFFERS 64
 #ifdef BOOST_ASIO_HAS_IOCP
 #define AC_SOCKET_USE_IOCP
 #endif
@@ -75,7 +78,7 @@ public:
         }
 
 #ifndef AC_SOCKET_USE_IOCP
-        if (_isWritingAsync || (_writeQueue.empty() && !_closing))
+        if (_isWritingAsync || (_writeQueue.empty() && !HasGatherData() && !_closing))
         {
             return true;
         }
@@ -176,6 +179,20 @@ protected:
     virtual void OnClose() { }
     virtual void ReadHandler() = 0;
 
+    // Scatter-gather sending. A socket that keeps its own send queue instead of coalescing it into
+    // MessageBuffers exposes the pending data here, it is handed to the kernel in one vectored write.
+    // The memory referenced by the buffers must stay valid until GatherWriteCompleted releases it.
+    virtual bool HasGatherData() const { return false; }
+    virtual void FillGatherBuffers(std::vector<boost::asio::const_buffer>& /*buffers*/) { }
+    virtual void GatherWriteCompleted(std::size_t /*transferredBytes*/) { }
+
+    void GatherDataQueued()
+    {
+#ifdef AC_SOCKET_USE_IOCP
+        AsyncProcessQueue();
+#endif
+    }
+
     bool AsyncProcessQueue()
     {
         if (_isWritingAsync)
@@ -184,6 +201,21 @@ protected:
         _isWritingAsync = true;
 
 #ifdef AC_SOCKET_USE_IOCP
+        if (_writeQueue.empty())
+        {
+            if (!HasGatherData())
+            {
+                _isWritingAsync = false;
+                return false;
+            }
+
+            _gatherBuffers.clear();
+            FillGatherBuffers(_gatherBuffers);
+            _socket.async_write_some(_gatherBuffers, std::bind(&Socket<T>::GatherWriteHandler,
+                this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
+            return false;
+        }
+
         MessageBuffer& buffer = _writeQueue.front();
         _socket.async_write_some(boost::asio::buffer(buffer.GetReadPointer(), buffer.GetActiveSize()), std::bind(&Socket<T>::WriteHandler,
             this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
@@ -349,6 +381,22 @@ private:
             CloseSocket();
     }
 
+    void GatherWriteHandler(boost::system::error_code error, std::size_t transferedBytes)
+    {
+        if (!error)
+        {
+            _isWritingAsync = false;
+            GatherWriteCompleted(transferedBytes);
+
+            if (HasGatherData())
+                AsyncProcessQueue();
+            else if (_closing)
+                CloseSocket();
+        }
+        else
+            CloseSocket();
+    }
+
 #else
 
     void WriteHandlerWrapper(boost::system::error_code /*error*/, std::size_t /*transferedBytes*/)
@@ -360,7 +408,7 @@ private:
     bool HandleQueue()
     {
         if (_writeQueue.empty())
-            return false;
+            return HandleGatherQueue();
 
         MessageBuffer& queuedMessage = _writeQueue.front();
 
@@ -409,7 +457,45 @@ private:
             CloseSocket();
         }
 
-        return !_writeQueue.empty();
+        return !_writeQueue.empty() || HasGatherData();
+    }
+
+    bool HandleGatherQueue()
+    {
+        if (!HasGatherData())
+            return false;
+
+        _gatherBuffers.clear();
+        FillGatherBuffers(_gatherBuffers);
+
+        boost::system::error_code error;
+        std::size_t bytesSent = _socket.write_some(_gatherBuffers, error);
+
+        if (error)
+        {
+            if (error == boost::asio::error::would_block || error == boost::asio::error::try_again)
+                return AsyncProcessQueue();
+
+            // Unlike a coalesced buffer a partially written gather queue cannot be dropped without corrupting the stream
+            CloseSocket();
+            return false;
+        }
+
+        GatherWriteCompleted(bytesSent);
+
+        if (!HasGatherData())
+        {
+            if (_closing)
+                CloseSocket();
+
+            return false;
+        }
+
+        // Kernel send buffer is full, wait until the socket becomes writable again
+        if (bytesSent < boost::asio::buffer_size(_gatherBuffers))
+            return AsyncProcessQueue();
+
+        return true;
     }
 #endif
 
@@ -420,6 +506,7 @@ private:
 
     MessageBuffer _readBuffer;
     std::queue<MessageBuffer> _writeQueue;
+    std::vector<boost::asio::const_buffer> _gatherBuffers;
 
     std::atomic<bool> _closed;
     std::atomic<bool> _closing;
@@ -115,14 +115,14 @@ void ByteBuffer::append(uint8 const* src, std::size_t cnt)
 
     std::size_t const newSize = _wpos + cnt;
 
-    if (_storage.capacity() < newSize) // custom memory allocation rules
+    if (_storage.capacity() < newSize) // custom memory allocation rules, sized to fill whole BufferPool blocks
     {
         if (newSize < 100)
-            _storage.reserve(300);
+            _storage.reserve(0x200);
         else if (newSize < 750)
-            _storage.reserve(2500);
+            _storage.reserve(0x1000);
         else if (newSize < 6000)
-            _storage.reserve(10000);
+            _storage.reserve(0x4000);
         else
             _storage.reserve(400000);
     }
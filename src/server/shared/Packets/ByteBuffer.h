@@ -18,6 +18,7 @@
 #ifndef _BYTEBUFFER_H
 #define _BYTEBUFFER_H
 
+#include "BufferPool.h"
 #include "ByteConverter.h"
 #include "Define.h"
 #include <array>
@@ -529,7 +530,7 @@ public:
 
 protected:
     std::size_t _rpos{0}, _wpos{0};
-    std::vector<uint8> _storage;
+    Acore::PooledByteStorage _storage;
 };
 
 /// @todo Make a ByteBuffer.cpp and move all this inlining to it.
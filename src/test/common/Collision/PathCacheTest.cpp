@@ -0,0 +1,85 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PathCache.h"
+#include "gtest/gtest.h"
+
+using MMAP::PathCache;
+
+TEST(PathCacheTest, ReturnsStoredCorridor)
+{
+    dtNavMesh navMesh;
+    PathCache cache(navMesh, 4);
+    dtPolyRef const corridor[] = { 1, 2, 3 };
+    cache.Store({ 1, 3, 1, 0 }, corridor, 3);
+
+    dtPolyRef path[8] = { };
+    ASSERT_EQ(cache.Find({ 1, 3, 1, 0 }, path, 8), 3u);
+    EXPECT_EQ(path[0], 1u);
+    EXPECT_EQ(path[2], 3u);
+
+    // other filter flags search different polygons
+    EXPECT_EQ(cache.Find({ 1, 3, 3, 0 }, path, 8), 0u);
+    // does not fit into the output
+    EXPECT_EQ(cache.Find({ 1, 3, 1, 0 }, path, 2), 0u);
+}
+
+TEST(PathCacheTest, EvictsLeastRecentlyUsed)
+{
+    dtNavMesh navMesh;
+    PathCache cache(navMesh, 2);
+    dtPolyRef const corridor[] = { 7 };
+    dtPolyRef path[1];
+
+    cache.Store({ 1, 1, 1, 0 }, corridor, 1);
+    cache.Store({ 2, 2, 1, 0 }, corridor, 1);
+    ASSERT_EQ(cache.Find({ 1, 1, 1, 0 }, path, 1), 1u);
+
+    cache.Store({ 3, 3, 1, 0 }, corridor, 1);
+    EXPECT_EQ(cache.GetSize(), 2u);
+    EXPECT_EQ(cache.Find({ 1, 1, 1, 0 }, path, 1), 1u);
+    EXPECT_EQ(cache.Find({ 2, 2, 1, 0 }, path, 1), 0u);
+    EXPECT_EQ(cache.Find({ 3, 3, 1, 0 }, path, 1), 1u);
+
+    cache.Clear();
+    EXPECT_EQ(cache.GetSize(), 0u);
+    EXPECT_EQ(cache.Find({ 3, 3, 1, 0 }, path, 1), 0u);
+}
+
+TEST(PathCacheTest, InvalidatesCorridorsThroughTile)
+{
+    dtNavMesh navMesh;
+    PathCache cache(navMesh, 4);
+    dtPolyRef const inFirstTile[] = { navMesh.encodePolyId(1, 1, 0), navMesh.encodePolyId(1, 1, 5) };
+    dtPolyRef const acrossTiles[] = { navMesh.encodePolyId(1, 1, 5), navMesh.encodePolyId(1, 2, 0), navMesh.encodePolyId(1, 3, 2) };
+    dtPolyRef const inLastTile[] = { navMesh.encodePolyId(1, 3, 2) };
+    dtPolyRef path[4];
+
+    cache.Store({ inFirstTile[0], inFirstTile[1], 1, 0 }, inFirstTile, 2);
+    cache.Store({ acrossTiles[0], acrossTiles[2], 1, 0 }, acrossTiles, 3);
+    cache.Store({ inLastTile[0], inLastTile[0], 1, 0 }, inLastTile, 1);
+
+    cache.Invalidate({ 2 });
+    EXPECT_EQ(cache.GetSize(), 2u);
+    EXPECT_EQ(cache.Find({ acrossTiles[0], acrossTiles[2], 1, 0 }, path, 4), 0u);
+    EXPECT_EQ(cache.Find({ inFirstTile[0], inFirstTile[1], 1, 0 }, path, 4), 2u);
+
+    cache.Invalidate({ 4, 3 });
+    EXPECT_EQ(cache.GetSize(), 1u);
+    EXPECT_EQ(cache.Find({ inLastTile[0], inLastTile[0], 1, 0 }, path, 4), 0u);
+    EXPECT_EQ(cache.Find({ inFirstTile[0], inFirstTile[1], 1, 0 }, path, 4), 2u);
+}
@@ -0,0 +1,189 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LogMessage.h"
+#include "LogRing.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(LogRingTest, KeepsMessagesAcrossWrapAround)
+{
+    LogRing ring(2048);
+    std::vector<std::string> read;
+    auto consume = [&](LogRing::Record const& record)
+    {
+        EXPECT_EQ(record.Level, LOG_LEVEL_INFO);
+        EXPECT_EQ(record.Type, "server");
+        read.emplace_back(record.Text);
+    };
+
+    // Odd sizes move the wrap point through the middle of records
+    for (int i = 0; i < 200; ++i)
+    {
+        std::string text(std::size_t(i % 37 + 1), char('a' + i % 26));
+        ASSERT_TRUE(ring.Push(LOG_LEVEL_INFO, "server", text, {}, Seconds(i)));
+        ring.Consume(consume);
+        ASSERT_EQ(read.size(), std::size_t(i + 1));
+        EXPECT_EQ(read.back(), text);
+    }
+
+    EXPECT_TRUE(ring.IsEmpty());
+    EXPECT_EQ(ring.GetDropped(), 0u);
+}
+
+TEST(LogRingTest, DropsWhenFull)
+{
+    LogRing ring(2048);
+    std::string text(100, 'x');
+
+    int pushed = 0;
+    while (ring.Push(LOG_LEVEL_ERROR, "server", text, "param", Seconds(0)))
+        ++pushed;
+
+    EXPECT_GT(pushed, 0);
+    EXPECT_EQ(ring.GetDropped(), 1u);
+
+    std::size_t read = ring.Consume([&](LogRing::Record const& record)
+    {
+        EXPECT_EQ(record.Text, text);
+        EXPECT_EQ(record.Param1, "param");
+    });
+
+    EXPECT_EQ(read, std::size_t(pushed));
+    EXPECT_TRUE(ring.Push(LOG_LEVEL_ERROR, "server", text, "param", Seconds(0)));
+}
+
+TEST(LogRingTest, TruncatesLongMessages)
+{
+    LogRing ring(2048);
+    std::string text(ring.GetCapacity(), 'x');
+
+    ASSERT_TRUE(ring.Push(LOG_LEVEL_INFO, "server", text, {}, Seconds(0)));
+    ring.Consume([&](LogRing::Record const& record)
+    {
+        EXPECT_LT(record.Text.size(), ring.GetCapacity() / 4);
+    });
+}
+
+TEST(LogRingTest, WriterKeepsOrderPerThread)
+{
+    std::mutex lock;
+    std::map<std::string, std::vector<std::string>> received;
+
+    {
+        LogRingWriter writer(1 << 20, [&](std::unique_ptr<LogMessage>&& message)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            received[message->type].push_back(message->text);
+        });
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&writer, t]()
+            {
+                std::string type = "thread." + std::to_string(t);
+                for (int i = 0; i < 1000; ++i)
+                    writer.Write(LOG_LEVEL_DEBUG, type, std::to_string(i));
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        writer.Flush();
+        EXPECT_EQ(writer.GetDroppedMessages(), 0u);
+    }
+
+    ASSERT_EQ(received.size(), 4u);
+    for (auto const& [type, texts] : received)
+    {
+        ASSERT_EQ(texts.size(), 1000u) << type;
+        for (int i = 0; i < 1000; ++i)
+            EXPECT_EQ(texts[i], std::to_string(i));
+    }
+}
+
+TEST(LogRingTest, WriterDrainsOnDestruction)
+{
+    std::vector<std::string> received;
+    {
+        LogRingWriter writer(2048, [&](std::unique_ptr<LogMessage>&& message) { received.push_back(message->text); });
+        for (int i = 0; i < 10; ++i)
+            writer.Write(LOG_LEVEL_INFO, "server", std::to_string(i));
+    }
+
+    ASSERT_EQ(received.size(), 10u);
+    EXPECT_EQ(received.back(), "9");
+}
+
+TEST(LogRingTest, WriterKeepsErrorsWhenFull)
+{
+    std::vector<std::string> received;
+    {
+        LogRingWriter writer(2048, [&](std::unique_ptr<LogMessage>&& message) { received.push_back(message->text); });
+
+        std::atomic<bool> filled = false;
+        std::thread thread;
+        {
+            // Keeps the writer thread from draining the ring
+            LogRingWriter::SinkLock guard(writer);
+            thread = std::thread([&]()
+            {
+                for (int i = 0; !writer.GetDroppedMessages(); ++i)
+                    writer.Write(LOG_LEVEL_INFO, "server", std::to_string(i));
+
+                filled = true;
+                writer.Write(LOG_LEVEL_ERROR, "server", "error");
+            });
+
+            while (!filled)
+                std::this_thread::yield();
+        }
+
+        thread.join();
+    }
+
+    ASSERT_FALSE(received.empty());
+    EXPECT_EQ(received.back(), "error");
+}
+
+TEST(LogRingTest, WriterDropsErrorsUnderItsSinkLock)
+{
+    std::vector<std::string> received;
+    {
+        LogRingWriter writer(2048, [&](std::unique_ptr<LogMessage>&& message) { received.push_back(message->text); });
+
+        // Like an appender that logs an error, the writer thread cannot drain the ring meanwhile
+        LogRingWriter::SinkLock guard(writer);
+        for (int i = 0; !writer.GetDroppedMessages(); ++i)
+            writer.Write(LOG_LEVEL_INFO, "server", std::to_string(i));
+
+        uint64 const dropped = writer.GetDroppedMessages();
+        writer.Write(LOG_LEVEL_ERROR, "server", "error");
+        EXPECT_EQ(writer.GetDroppedMessages(), dropped + 1);
+    }
+
+    EXPECT_EQ(std::find(received.begin(), received.end(), "error"), received.end());
+}
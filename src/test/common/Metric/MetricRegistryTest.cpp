@@ -0,0 +1,119 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MetricRegistry.h"
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+TEST(MetricRegistryTest, ReturnsSameMetricForSameLabels)
+{
+    MetricRegistry registry;
+
+    MetricCounter& first = registry.GetCounter("packets_total", "Packets", { { "type", "a" } });
+    MetricCounter& second = registry.GetCounter("packets_total", "Packets", { { "type", "a" } });
+    MetricCounter& other = registry.GetCounter("packets_total", "Packets", { { "type", "b" } });
+
+    EXPECT_EQ(&first, &second);
+    EXPECT_NE(&first, &other);
+}
+
+TEST(MetricRegistryTest, HistogramBuckets)
+{
+    MetricHistogram histogram({ 1.0, 2.0, 5.0 });
+
+    histogram.Observe(0.5);
+    histogram.Observe(1.0);     // bounds are inclusive
+    histogram.Observe(3.0);
+    histogram.Observe(100.0);
+
+    EXPECT_EQ(histogram.GetBucketCount(0), 2u);
+    EXPECT_EQ(histogram.GetBucketCount(1), 0u);
+    EXPECT_EQ(histogram.GetBucketCount(2), 1u);
+    EXPECT_EQ(histogram.GetBucketCount(3), 1u);
+    EXPECT_EQ(histogram.GetCount(), 4u);
+    EXPECT_DOUBLE_EQ(histogram.GetSum(), 104.5);
+
+    histogram.Observe(std::chrono::milliseconds(1500));
+    EXPECT_EQ(histogram.GetBucketCount(1), 1u);
+}
+
+TEST(MetricRegistryTest, MirroredHistogram)
+{
+    MetricHistogram histogram({ 1.0, 2.0 });
+    histogram.Set({ 3, 0, 2 }, 12.5);
+
+    EXPECT_EQ(histogram.GetBucketCount(0), 3u);
+    EXPECT_EQ(histogram.GetBucketCount(2), 2u);
+    EXPECT_EQ(histogram.GetCount(), 5u);
+    EXPECT_DOUBLE_EQ(histogram.GetSum(), 12.5);
+}
+
+TEST(MetricRegistryTest, RendersPrometheusText)
+{
+    MetricRegistry registry;
+    registry.GetCounter("requests_total", "Handled requests").Increment(3);
+    registry.GetGauge("players", "Online players", { { "realm", "A \"quoted\" name" } }).Set(42);
+    MetricHistogram& histogram = registry.GetHistogram("update_seconds", "Update time", { { "map_id", "571" } }, { 0.01, 0.1 });
+    histogram.Observe(0.005);
+    histogram.Observe(0.05);
+    histogram.Observe(1.0);
+
+    std::string expected =
+        "# HELP players Online players\n"
+        "# TYPE players gauge\n"
+        "players{realm=\"A \\\"quoted\\\" name\"} 42\n"
+        "# HELP requests_total Handled requests\n"
+        "# TYPE requests_total counter\n"
+        "requests_total 3\n"
+        "# HELP update_seconds Update time\n"
+        "# TYPE update_seconds histogram\n"
+        "update_seconds_bucket{map_id=\"571\",le=\"0.01\"} 1\n"
+        "update_seconds_bucket{map_id=\"571\",le=\"0.1\"} 2\n"
+        "update_seconds_bucket{map_id=\"571\",le=\"+Inf\"} 3\n"
+        "update_seconds_sum{map_id=\"571\"} 1.055\n"
+        "update_seconds_count{map_id=\"571\"} 3\n";
+
+    EXPECT_EQ(registry.Render(), expected);
+}
+
+TEST(MetricRegistryTest, ConcurrentUpdates)
+{
+    MetricRegistry registry;
+    MetricCounter& counter = registry.GetCounter("events_total", "Events");
+    MetricHistogram& histogram = registry.GetHistogram("event_seconds", "Event time");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&]()
+        {
+            for (int i = 0; i < 10000; ++i)
+            {
+                counter.Increment();
+                histogram.Observe(0.001);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(counter.GetValue(), 40000u);
+    EXPECT_EQ(histogram.GetCount(), 40000u);
+}
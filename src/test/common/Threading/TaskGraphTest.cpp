@@ -0,0 +1,110 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TaskGraph.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+TEST(TaskGraphTest, SingleThreadKeepsInsertionOrder)
+{
+    Acore::TaskGraph graph;
+    std::vector<int> order;
+
+    auto first = graph.Add("first", [&] { order.push_back(0); });
+    graph.Add("second", [&] { order.push_back(1); });
+    graph.Add("third", [&] { order.push_back(2); }, { first });
+    graph.Add("fourth", [&] { order.push_back(3); });
+
+    graph.Run(1);
+
+    EXPECT_EQ(order, std::vector<int>({ 0, 1, 2, 3 }));
+    EXPECT_EQ(graph.GetTimings().size(), 4u);
+}
+
+TEST(TaskGraphTest, DependenciesFinishFirst)
+{
+    Acore::TaskGraph graph;
+    std::mutex lock;
+    std::vector<int> order;
+    auto record = [&](int id)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        order.push_back(id);
+    };
+
+    auto root = graph.Add("root", [&] { std::this_thread::sleep_for(std::chrono::milliseconds(5)); record(0); });
+    auto left = graph.Add("left", [&] { record(1); }, { root });
+    auto right = graph.Add("right", [&] { std::this_thread::sleep_for(std::chrono::milliseconds(5)); record(2); }, { root });
+    graph.Add("join", [&] { record(3); }, { left, right });
+    graph.Add("independent", [&] { record(4); });
+
+    graph.Run(4);
+
+    ASSERT_EQ(order.size(), 5u);
+    auto position = [&](int id) { return std::find(order.begin(), order.end(), id) - order.begin(); };
+    EXPECT_LT(position(0), position(1));
+    EXPECT_LT(position(0), position(2));
+    EXPECT_LT(position(1), position(3));
+    EXPECT_LT(position(2), position(3));
+}
+
+TEST(TaskGraphTest, CriticalPathFollowsLongestChain)
+{
+    Acore::TaskGraph graph;
+
+    auto slow = graph.Add("slow", [] { std::this_thread::sleep_for(std::chrono::milliseconds(20)); });
+    auto fast = graph.Add("fast", [] { });
+    graph.Add("after slow", [] { std::this_thread::sleep_for(std::chrono::milliseconds(5)); }, { slow, fast });
+    graph.Add("alone", [] { });
+
+    graph.Run(2);
+
+    auto const& timings = graph.GetTimings();
+    EXPECT_TRUE(timings[0].CriticalPath);
+    EXPECT_FALSE(timings[1].CriticalPath);
+    EXPECT_TRUE(timings[2].CriticalPath);
+    EXPECT_FALSE(timings[3].CriticalPath);
+    EXPECT_GE(graph.GetCriticalPathTime(), std::chrono::milliseconds(25));
+}
+
+TEST(TaskGraphTest, RunsIndependentTasksConcurrently)
+{
+    Acore::TaskGraph graph;
+    std::atomic<int> running{0};
+    std::atomic<int> maxRunning{0};
+
+    for (int i = 0; i < 4; ++i)
+    {
+        graph.Add("task", [&]
+        {
+            int now = ++running;
+            int seen = maxRunning.load();
+            while (now > seen && !maxRunning.compare_exchange_weak(seen, now));
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            --running;
+        });
+    }
+
+    graph.Run(4);
+
+    EXPECT_GT(maxRunning.load(), 1);
+}
@@ -0,0 +1,277 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EventProcessor.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+    class RecordingEvent : public BasicEvent
+    {
+    public:
+        RecordingEvent(std::vector<std::pair<int, uint64>>& log, int id) : _log(log), _id(id) { }
+
+        bool Execute(uint64 e_time, uint32 /*p_time*/) override
+        {
+            _log.emplace_back(_id, e_time);
+            return true;
+        }
+
+        void Abort(uint64 /*e_time*/) override { _log.emplace_back(-_id, 0); }
+
+    private:
+        std::vector<std::pair<int, uint64>>& _log;
+        int _id;
+    };
+
+    std::vector<int> Ids(std::vector<std::pair<int, uint64>> const& log)
+    {
+        std::vector<int> ids;
+        for (auto const& [id, time] : log)
+            ids.push_back(id);
+
+        return ids;
+    }
+}
+
+TEST(EventProcessorTest, RunsInTimeThenInsertionOrder)
+{
+    EventProcessor events;
+    std::vector<std::pair<int, uint64>> log;
+
+    events.AddEventAtOffset(new RecordingEvent(log, 1), 300ms);
+    events.AddEventAtOffset(new RecordingEvent(log, 2), 10ms);
+    events.AddEventAtOffset(new RecordingEvent(log, 3), 300ms);
+    events.AddEventAtOffset(new RecordingEvent(log, 4), 0ms);
+    events.AddEventAtOffset(new RecordingEvent(log, 5), 10ms);
+
+    events.Update(5);
+    EXPECT_EQ(Ids(log), std::vector<int>({ 4 }));
+
+    events.Update(1000);
+    EXPECT_EQ(Ids(log), std::vector<int>({ 4, 2, 5, 1, 3 }));
+    EXPECT_FALSE(events.HaveEventList());
+}
+
+TEST(EventProcessorTest, LongDelaysCrossEveryLevel)
+{
+    EventProcessor events;
+    std::vector<std::pair<int, uint64>> log;
+
+    std::vector<uint64> const delays = { 1, 63, 64, 65, 4095, 4096, 4097, 262143, 262144, 262145, 20000000, 20000000 };
+    for (std::size_t i = 0; i < delays.size(); ++i)
+        events.AddEventAtOffset(new RecordingEvent(log, int(i + 1)), Milliseconds(delays[i]));
+
+    // uneven steps so updates end both on and between slot boundaries
+    for (uint64 now = 0; now < 20001000; now += 997)
+        events.Update(997);
+
+    ASSERT_EQ(log.size(), delays.size());
+    for (std::size_t i = 0; i < delays.size(); ++i)
+    {
+        EXPECT_EQ(log[i].first, int(i + 1));
+        // executed on the first update that reached its time
+        EXPECT_GE(log[i].second, delays[i]);
+        EXPECT_LT(log[i].second, delays[i] + 997);
+    }
+}
+
+TEST(EventProcessorTest, OrderSurvivesMovingBetweenListAndWheel)
+{
+    EventProcessor events;
+    std::vector<std::pair<int, uint64>> log;
+    std::vector<int> expected;
+
+    // starts in the sorted list, moves to the wheel with the ninth event
+    for (int id = 1; id <= 20; ++id)
+        events.AddEventAtOffset(new RecordingEvent(log, id), id % 2 ? 100ms : 5000ms);
+
+    for (int id = 1; id <= 20; id += 2)
+        expected.push_back(id);
+
+    events.Update(200);
+    EXPECT_EQ(Ids(log), expected);
+
+    // the ten left at 5000 ms still use the wheel, a few more join them
+    events.AddEventAtOffset(new RecordingEvent(log, 21), 4800ms);
+    events.AddEventAtOffset(new RecordingEvent(log, 22), 10ms);
+
+    events.Update(100);
+    expected.push_back(22);
+    EXPECT_EQ(Ids(log), expected);
+
+    for (int id = 2; id <= 20; id += 2)
+        expected.push_back(id);
+    expected.push_back(21);
+
+    events.Update(5000);
+    EXPECT_EQ(Ids(log), expected);
+    EXPECT_FALSE(events.HaveEventList());
+}
+
+TEST(EventProcessorTest, EventsAddedWhileUpdatingRunInSameUpdate)
+{
+    EventProcessor events;
+    std::vector<int> order;
+
+    events.AddEventAtOffset([&]()
+    {
+        order.push_back(1);
+        events.AddEventAtOffset([&]() { order.push_back(3); }, 40ms);
+        events.AddEventAtOffset([&]() { order.push_back(2); }, 0ms);
+    }, 10ms);
+
+    events.Update(100);
+    EXPECT_EQ(order, std::vector<int>({ 1, 2 }));
+
+    events.Update(40);
+    EXPECT_EQ(order, std::vector<int>({ 1, 2, 3 }));
+}
+
+TEST(EventProcessorTest, CancelAndModify)
+{
+    EventProcessor events;
+    std::vector<std::pair<int, uint64>> log;
+
+    events.AddEventAtOffset(new RecordingEvent(log, 1), 100ms, 1);
+    events.AddEventAtOffset(new RecordingEvent(log, 2), 5000ms, 1);
+    BasicEvent* moved = new RecordingEvent(log, 3);
+    events.AddEventAtOffset(moved, 10000ms);
+    events.AddEventAtOffset(new RecordingEvent(log, 4), 50ms, 2);
+
+    events.CancelEventGroup(1);
+    EXPECT_EQ(Ids(log), std::vector<int>({ -1, -2 }));
+
+    events.ModifyEventTime(moved, 20ms);
+    events.Update(60);
+    EXPECT_EQ(Ids(log), std::vector<int>({ -1, -2, 3, 4 }));
+
+    events.AddEventAtOffset(new RecordingEvent(log, 5), 70ms);
+    events.KillAllEvents(true);
+    EXPECT_EQ(Ids(log), std::vector<int>({ -1, -2, 3, 4, -5 }));
+    EXPECT_FALSE(events.HaveEventList());
+}
+
+namespace
+{
+    // Owners with short repeating timers, updated like map objects, against the multimap queue used before
+    void CompareWithMultimap(std::size_t owners, std::size_t timers)
+    {
+        constexpr uint32 DIFF = 50;
+        constexpr uint32 UPDATES = 200;
+
+        struct RepeatingEvent : public BasicEvent
+        {
+            RepeatingEvent(EventProcessor& owner, uint64 period, uint64& runs) : Owner(owner), Period(period), Runs(runs) { }
+
+            bool Execute(uint64 /*e_time*/, uint32 /*p_time*/) override
+            {
+                ++Runs;
+                Owner.AddEventAtOffset(new RepeatingEvent(Owner, Period, Runs), Milliseconds(Period));
+                return true;
+            }
+
+            EventProcessor& Owner;
+            uint64 Period;
+            uint64& Runs;
+        };
+
+        // Queue and loop of the previous implementation, with events on the general heap
+        struct HeapEvent
+        {
+            HeapEvent(uint64 period, uint64& runs) : Period(period), Runs(runs) { }
+            virtual ~HeapEvent() = default;
+
+            uint64 Period;
+            uint64& Runs;
+        };
+
+        struct MultimapProcessor
+        {
+            uint64 Time = 0;
+            std::multimap<uint64, HeapEvent*> Events;
+
+            ~MultimapProcessor()
+            {
+                for (auto const& [time, event] : Events)
+                    delete event;
+            }
+
+            void Update(uint32 diff)
+            {
+                Time += diff;
+                for (auto itr = Events.begin(); itr != Events.end() && itr->first <= Time; itr = Events.begin())
+                {
+                    HeapEvent* event = itr->second;
+                    Events.erase(itr);
+                    ++event->Runs;
+                    Events.emplace(Time + event->Period, new HeapEvent(event->Period, event->Runs));
+                    delete event;
+                }
+            }
+        };
+
+        auto period = [](std::size_t owner, std::size_t timer) { return uint64(100 + (owner * 7 + timer * 131) % 1900); };
+
+        uint64 processorRuns = 0;
+        std::vector<EventProcessor> processors(owners);
+        for (std::size_t owner = 0; owner < owners; ++owner)
+            for (std::size_t timer = 0; timer < timers; ++timer)
+                processors[owner].AddEventAtOffset(new RepeatingEvent(processors[owner], period(owner, timer), processorRuns), Milliseconds(period(owner, timer)));
+
+        uint64 multimapRuns = 0;
+        std::vector<MultimapProcessor> multimap(owners);
+        for (std::size_t owner = 0; owner < owners; ++owner)
+            for (std::size_t timer = 0; timer < timers; ++timer)
+                multimap[owner].Events.emplace(period(owner, timer), new HeapEvent(period(owner, timer), multimapRuns));
+
+        auto measure = [](auto& processors)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (uint32 update = 0; update < UPDATES; ++update)
+                for (auto& processor : processors)
+                    processor.Update(DIFF);
+
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        };
+
+        auto processorTime = measure(processors);
+        auto multimapTime = measure(multimap);
+
+        EXPECT_EQ(processorRuns, multimapRuns);
+        ::testing::Test::RecordProperty("EventProcessorMicroseconds", std::to_string(processorTime.count()));
+        ::testing::Test::RecordProperty("MultimapMicroseconds", std::to_string(multimapTime.count()));
+        ::testing::Test::RecordProperty("Executions", std::to_string(processorRuns));
+    }
+}
+
+// Not run by default: --gtest_also_run_disabled_tests --gtest_filter=EventProcessorTest.DISABLED_* --gtest_output=xml
+// the timings are recorded as properties of the test in the xml report
+TEST(EventProcessorTest, DISABLED_BenchmarkFewTimersPerOwner)
+{
+    CompareWithMultimap(20000, 4);
+}
+
+TEST(EventProcessorTest, DISABLED_BenchmarkManyTimersPerOwner)
+{
+    CompareWithMultimap(400, 200);
+}
@@ -0,0 +1,136 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "QueryResult.h"
+#include "ResultSnapshot.h"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+
+namespace
+{
+    class ResultSnapshotTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            _directory = std::filesystem::temp_directory_path() / "acore_result_snapshot_test";
+            std::filesystem::remove_all(_directory);
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(_directory);
+        }
+
+        static std::vector<QueryResultFieldMetadata> GetMetadata()
+        {
+            std::vector<QueryResultFieldMetadata> metadata(3);
+            metadata[0].Name = metadata[0].Alias = "entry";
+            metadata[0].Type = DatabaseFieldTypes::Int32;
+            metadata[1].Name = metadata[1].Alias = "name";
+            metadata[1].Type = DatabaseFieldTypes::Binary;
+            metadata[2].Name = metadata[2].Alias = "scale";
+            metadata[2].Type = DatabaseFieldTypes::Float;
+            for (uint32 i = 0; i < metadata.size(); ++i)
+                metadata[i].Index = i;
+
+            return metadata;
+        }
+
+        static void WriteRows(ResultSnapshotStore const& store, std::string_view sql)
+        {
+            auto writer = store.CreateWriter("test", "1234", sql, GetMetadata());
+
+            char const* first[] = { "1", "Hogger", "1.5" };
+            unsigned long firstLengths[] = { 1, 6, 3 };
+            writer->AddRow(first, firstLengths);
+
+            char const* second[] = { "42", nullptr, "-2" };
+            unsigned long secondLengths[] = { 2, 0, 2 };
+            writer->AddRow(second, secondLengths);
+
+            writer->Commit(2);
+        }
+
+        std::filesystem::path _directory;
+    };
+}
+
+TEST_F(ResultSnapshotTest, RowsRoundTrip)
+{
+    ResultSnapshotStore store(_directory.string(), "key");
+    WriteRows(store, "SELECT entry, name, scale FROM test");
+
+    auto snapshot = store.Find("test", "1234", "SELECT entry, name, scale FROM test");
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_EQ(snapshot->GetRowCount(), 2u);
+    EXPECT_EQ(snapshot->GetFieldCount(), 3u);
+
+    ResultSet result(snapshot);
+    ASSERT_TRUE(result.NextRow());
+    EXPECT_EQ(result.GetFieldName(1), "name");
+
+    Field* fields = result.Fetch();
+    EXPECT_EQ(fields[0].Get<uint32>(), 1u);
+    EXPECT_EQ(fields[1].Get<std::string>(), "Hogger");
+    EXPECT_FLOAT_EQ(fields[2].Get<float>(), 1.5f);
+
+    ASSERT_TRUE(result.NextRow());
+    EXPECT_EQ(fields[0].Get<uint32>(), 42u);
+    EXPECT_TRUE(fields[1].IsNull());
+    EXPECT_FLOAT_EQ(fields[2].Get<float>(), -2.0f);
+
+    EXPECT_FALSE(result.NextRow());
+}
+
+TEST_F(ResultSnapshotTest, TypedRows)
+{
+    ResultSnapshotStore store(_directory.string(), "key");
+    WriteRows(store, "SELECT entry, name, scale FROM test");
+
+    ResultSet result(store.Find("test", "1234", "SELECT entry, name, scale FROM test"));
+    ASSERT_TRUE(result.NextRow());
+
+    std::vector<std::tuple<uint32, std::string, float>> rows;
+    for (auto [entry, name, scale] : result.Rows<uint32, std::string_view, float>())
+        rows.emplace_back(entry, std::string(name), scale);
+
+    ASSERT_EQ(rows.size(), 2u);
+    EXPECT_EQ(rows[0], std::make_tuple(1u, std::string("Hogger"), 1.5f));
+    EXPECT_EQ(rows[1], std::make_tuple(42u, std::string(), -2.0f));
+}
+
+TEST_F(ResultSnapshotTest, RejectsOtherKeyTableKeyOrQuery)
+{
+    WriteRows(ResultSnapshotStore(_directory.string(), "key"), "SELECT entry, name, scale FROM test");
+
+    EXPECT_NE(ResultSnapshotStore(_directory.string(), "key").Find("test", "1234", "SELECT entry, name, scale FROM test"), nullptr);
+    EXPECT_EQ(ResultSnapshotStore(_directory.string(), "other").Find("test", "1234", "SELECT entry, name, scale FROM test"), nullptr);
+    EXPECT_EQ(ResultSnapshotStore(_directory.string(), "key").Find("test", "1234", "SELECT entry FROM test"), nullptr);
+    EXPECT_EQ(ResultSnapshotStore(_directory.string(), "key").Find("test", "5678", "SELECT entry, name, scale FROM test"), nullptr);
+    EXPECT_EQ(ResultSnapshotStore(_directory.string(), "key").Find("missing", "1234", "SELECT entry, name, scale FROM test"), nullptr);
+}
+
+TEST_F(ResultSnapshotTest, IncompleteResultIsNotWritten)
+{
+    ResultSnapshotStore store(_directory.string(), "key");
+    auto writer = store.CreateWriter("test", "1234", "SELECT entry FROM test", GetMetadata());
+    writer->Commit(5);
+
+    EXPECT_EQ(store.Find("test", "1234", "SELECT entry FROM test"), nullptr);
+}
@@ -0,0 +1,129 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TerrainTileCache.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+namespace
+{
+    template<typename T>
+    void Write(std::vector<char>& buffer, T const& value)
+    {
+        buffer.insert(buffer.end(), reinterpret_cast<char const*>(&value), reinterpret_cast<char const*>(&value) + sizeof(T));
+    }
+
+    // Grid with uint8 heights followed by an unaligned liquid height map
+    std::vector<char> BuildMapFile()
+    {
+        std::vector<char> buffer;
+        map_fileheader header{};
+        header.mapMagic = MapMagic.asUInt;
+        header.versionMagic = MapVersionMagic;
+        Write(buffer, header);
+
+        header.areaMapOffset = uint32(buffer.size());
+        Write(buffer, map_areaHeader{ MapAreaMagic.asUInt, 0, 12 });
+        for (uint16 i = 0; i < 16 * 16; ++i)
+            Write(buffer, i);
+
+        header.heightMapOffset = uint32(buffer.size());
+        Write(buffer, map_heightHeader{ MapHeightMagic.asUInt, MAP_HEIGHT_AS_INT8, 10.0f, 265.0f });
+        buffer.insert(buffer.end(), 129 * 129 + 128 * 128, char(255));
+        buffer.push_back(0);
+
+        header.liquidMapOffset = uint32(buffer.size());
+        Write(buffer, map_liquidHeader{ MapLiquidMagic.asUInt, MAP_LIQUID_NO_TYPE, 0, 0, 0, 0, 128, 128, 5.0f });
+        for (uint32 i = 0; i < 128 * 128; ++i)
+            Write(buffer, 42.0f);
+
+        std::memcpy(buffer.data(), &header, sizeof(header));
+        return buffer;
+    }
+
+    class TerrainTileCacheTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            _dataPath = (std::filesystem::temp_directory_path() / "ac_terrain_tile_cache_test").string() + "/";
+            std::filesystem::create_directories(_dataPath + "maps");
+
+            _file = BuildMapFile();
+            std::FILE* file = std::fopen((_dataPath + "maps/9990102.map").c_str(), "wb");
+            ASSERT_NE(file, nullptr);
+            std::fwrite(_file.data(), 1, _file.size(), file);
+            std::fclose(file);
+        }
+
+        void TearDown() override
+        {
+            std::error_code error;
+            std::filesystem::remove_all(_dataPath, error);
+        }
+
+        std::string _dataPath;
+        std::vector<char> _file;
+    };
+}
+
+TEST_F(TerrainTileCacheTest, ReadsMappedFile)
+{
+    GridTerrainData data;
+    ASSERT_EQ(data.Load(_dataPath + "maps/9990102.map"), TerrainMapDataReadResult::Success);
+
+    EXPECT_NEAR(data.getHeight(-10.0f, -10.0f), 265.0f, 0.01f);
+    EXPECT_FLOAT_EQ(data.getLiquidLevel(-10.0f, -10.0f), 42.0f);
+    EXPECT_EQ(data.GetMappedSize(), _file.size());
+    // the unaligned liquid heights had to be copied
+    EXPECT_GT(data.GetHeapSize(), 128u * 128u * sizeof(float));
+}
+
+TEST_F(TerrainTileCacheTest, RejectsTruncatedFile)
+{
+    std::FILE* file = std::fopen((_dataPath + "maps/9990103.map").c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fwrite(_file.data(), 1, _file.size() - 100, file);
+    std::fclose(file);
+
+    GridTerrainData data;
+    EXPECT_EQ(data.Load(_dataPath + "maps/9990103.map"), TerrainMapDataReadResult::InvalidLiquidData);
+}
+
+TEST_F(TerrainTileCacheTest, SharesLoadedTiles)
+{
+    TerrainMapDataReadResult result;
+    std::shared_ptr<GridTerrainData> first = sTerrainTileCache->Acquire(_dataPath, 999, 1, 2, result);
+    ASSERT_EQ(result, TerrainMapDataReadResult::Success);
+
+    std::shared_ptr<GridTerrainData> second = sTerrainTileCache->Acquire(_dataPath, 999, 1, 2, result);
+    EXPECT_EQ(first, second);
+
+    first.reset();
+    second.reset();
+
+    // nothing holds the tile anymore, it is loaded again
+    std::shared_ptr<GridTerrainData> third = sTerrainTileCache->Acquire(_dataPath, 999, 1, 2, result);
+    EXPECT_EQ(result, TerrainMapDataReadResult::Success);
+    EXPECT_NE(third, nullptr);
+
+    EXPECT_EQ(sTerrainTileCache->Acquire(_dataPath, 999, 5, 5, result), nullptr);
+    EXPECT_EQ(result, TerrainMapDataReadResult::NotFound);
+}
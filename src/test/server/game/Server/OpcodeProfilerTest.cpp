@@ -0,0 +1,77 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OpcodeProfiler.h"
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+    OpcodeProfiler::OpcodeStats const* FindStats(std::vector<OpcodeProfiler::OpcodeStats> const& stats, OpcodeClient opcode)
+    {
+        for (OpcodeProfiler::OpcodeStats const& entry : stats)
+            if (entry.Opcode == opcode)
+                return &entry;
+
+        return nullptr;
+    }
+}
+
+TEST(OpcodeProfilerTest, MergesThreads)
+{
+    sOpcodeProfiler->Reset();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([t]()
+        {
+            for (int i = 0; i < 100; ++i)
+                sOpcodeProfiler->Record(CMSG_WHO, std::chrono::microseconds(10 + t), 8);
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    std::vector<OpcodeProfiler::OpcodeStats> stats = sOpcodeProfiler->GetStats();
+    OpcodeProfiler::OpcodeStats const* who = FindStats(stats, CMSG_WHO);
+    ASSERT_NE(who, nullptr);
+    EXPECT_EQ(who->Count, 400u);
+    EXPECT_EQ(who->TotalTime, 100u * (10000 + 11000 + 12000 + 13000));
+    EXPECT_EQ(who->MaxTime, 13000u);
+    EXPECT_EQ(who->Bytes, 3200u);
+    EXPECT_EQ(FindStats(stats, CMSG_ITEM_QUERY_SINGLE), nullptr);
+}
+
+TEST(OpcodeProfilerTest, ResetStartsFromZero)
+{
+    sOpcodeProfiler->Record(CMSG_ITEM_QUERY_SINGLE, std::chrono::milliseconds(5), 12);
+    sOpcodeProfiler->Reset();
+    EXPECT_EQ(FindStats(sOpcodeProfiler->GetStats(), CMSG_ITEM_QUERY_SINGLE), nullptr);
+
+    sOpcodeProfiler->Record(CMSG_ITEM_QUERY_SINGLE, std::chrono::microseconds(7), 12);
+
+    std::vector<OpcodeProfiler::OpcodeStats> stats = sOpcodeProfiler->GetStats();
+    OpcodeProfiler::OpcodeStats const* query = FindStats(stats, CMSG_ITEM_QUERY_SINGLE);
+    ASSERT_NE(query, nullptr);
+    EXPECT_EQ(query->Count, 1u);
+    EXPECT_EQ(query->TotalTime, 7000u);
+    EXPECT_EQ(query->MaxTime, 7000u);    // the 5 ms before the reset is forgotten
+}